@@ -0,0 +1,942 @@
+#ifndef V93XX_H__
+#define V93XX_H__
+
+#include "V93XX_ConfigImage.h"
+#include "V93XX_Ram.h"
+#include "V93XX_RegisterMap.h"
+#include "V93XX_Registers.h"
+#include "V93XX_Stats.h"
+#include "V93XX_Status.h"
+#include "V93XX_Waveform.h"
+#include <Arduino.h>
+
+struct __attribute__((packed)) V93XX_ControlRegisters {
+    union {
+        uint32_t _array[8];
+        struct {
+            uint32_t DSP_ANA0;
+            uint32_t DSP_ANA1;
+            uint32_t DSP_CTRL0;
+            uint32_t DSP_CTRL1;
+            uint32_t DSP_CTRL2;
+            uint32_t DSP_CTRL3;
+            uint32_t DSP_CTRL4;
+            uint32_t DSP_CTRL5;
+        };
+    };
+};
+
+struct __attribute__((packed)) V93XX_CalibrationRegisters {
+    union {
+        uint32_t _array[22];
+        struct {
+            uint32_t DSP_CFG_CALI_PA;
+            uint32_t DSP_CFG_DC_PA;
+            uint32_t DSP_CFG_CALI_QA;
+            uint32_t DSP_CFG_DC_QA;
+            uint32_t DSP_CFG_CALI_PB;
+            uint32_t DSP_CFG_DC_PB;
+            uint32_t DSP_CFG_CALI_QB;
+            uint32_t DSP_CFG_DC_QB;
+            uint32_t DSP_CFG_CALI_RMSUA;
+            uint32_t DSP_CFG_RMS_DCUA;
+            uint32_t DSP_CFG_CALI_RMSIA;
+            uint32_t DSP_CFG_RMS_DCIA;
+            uint32_t DSP_CFG_CALI_RMSIB;
+            uint32_t DSP_CFG_RMS_DCIB;
+            uint32_t DSP_CFG_PHC;
+            uint32_t DSP_CFG_DCUA;
+            uint32_t DSP_CFG_DCIA;
+            uint32_t DSP_CFG_DCIB;
+            uint32_t DSP_CFG_BPF;
+            uint32_t DSP_CFG_CKSUM;
+            uint32_t EGY_PROCTH;
+            uint32_t EGY_PWRTH;
+        };
+    };
+};
+
+struct __attribute__((packed)) V93XX_ThresholdRegisters {
+    union {
+        uint32_t _array[12];
+        struct {
+            uint32_t DSP_OV_THL;
+            uint32_t DSP_OV_THH;
+            uint32_t DSP_SWELL_THL;
+            uint32_t DSP_SWELL_THH;
+            uint32_t DSP_DIP_THL;
+            uint32_t DSP_DIP_THH;
+            uint32_t FD_OVTH;
+            uint32_t FD_LVTH;
+            uint32_t FD_IA_OCTH;
+            uint32_t FD_IA_LCTH;
+            uint32_t FD_IB_OCTH;
+            uint32_t FD_IB_LCTH;
+        };
+    };
+};
+
+/**
+ * @brief Reads SYS_INTSTS on the driver's behalf (e.g. V93XX_Events::StatusSource).
+ * @return Status of the read; @p sys_intsts holds the status word when it is Ok
+ */
+typedef V93XX_Status (*V93XX_InterruptStatusSource)(void *context, uint32_t &sys_intsts);
+
+/**
+ * @brief Bus-independent V93XX driver, statically bound to a transport policy.
+ *
+ * The high-level features (block-read mapping, waveform capture, configuration load/verify)
+ * are written once here and inlined onto the transport; there is no virtual dispatch.
+ * V93XX_UART and V93XX_SPI are instantiations of this template.
+ *
+ * A transport provides:
+ *   - RegisterWrite(), RegisterRead(), RegisterReadChecked(), RegisterBlockRead()
+ *   - RegisterReadStrict(address, value): true only for a received frame with a valid checksum
+ *   - RegisterReadStatus(), RegisterWriteStatus(), RegisterBlockReadStatus(): one attempt, V93XX_Status
+ *     result, no data returned for a failed frame in ChecksumMode::Clean
+ *   - ByteTimeUs(): duration of one byte on the bus, the unit of V93XX_RetryPolicy backoff
+ *   - static constexpr bool kNativeBlockRead: RegisterBlockRead() uses the chip's mapped block read
+ *   - static constexpr uint32_t kInterBlockDelayMs: pause between consecutive block reads
+ *   - protected LinkReady(), Recover() (re-establish the link before a reload) and
+ *     SetBlockReadView(addresses, count) (called after the mapping registers are set)
+ *   - protected block_addr_shadow[4] / block_addr_valid, reset whenever the chip's mapping resets
+ *   - protected link_stats (V93XX_StatsRecorder), fed by every frame the transport sends
+ */
+template <typename Transport> class V93XX : public Transport {
+  public:
+    typedef V93XX_ControlRegisters ControlRegisters;
+    typedef V93XX_CalibrationRegisters CalibrationRegisters;
+    typedef V93XX_ThresholdRegisters ThresholdRegisters;
+
+    static constexpr uint8_t kControlWords = sizeof(ControlRegisters) / sizeof(uint32_t);
+    static constexpr uint8_t kCalibrationWords = sizeof(CalibrationRegisters) / sizeof(uint32_t);
+    static constexpr uint8_t kThresholdWords = sizeof(ThresholdRegisters) / sizeof(uint32_t);
+
+    // First address of each struct; together they are exactly the checksum set.
+    static constexpr uint8_t kControlBase = DSP_ANA0;
+    static constexpr uint8_t kCalibrationBase = DSP_CFG_CALI_PA;
+    static constexpr uint8_t kThresholdBase = DSP_OV_THL;
+    static_assert(V93XX_RegisterMap::IsConfigurationBlock(kControlBase, kControlWords),
+                  "ControlRegisters must map onto writable checksum-set registers");
+    static_assert(V93XX_RegisterMap::IsConfigurationBlock(kCalibrationBase, kCalibrationWords),
+                  "CalibrationRegisters must map onto writable checksum-set registers");
+    static_assert(V93XX_RegisterMap::IsConfigurationBlock(kThresholdBase, kThresholdWords) &&
+                      V93XX_RegisterMap::ChecksumSetSize() == kControlWords + kCalibrationWords + kThresholdWords,
+                  "ThresholdRegisters must complete the checksum set");
+    static_assert(DSP_CFG_CKSUM >= kCalibrationBase && DSP_CFG_CKSUM < kCalibrationBase + kCalibrationWords,
+                  "DSP_CFG_CKSUM must be part of CalibrationRegisters");
+
+    using Transport::Transport;
+
+    void SetRetryPolicy(const V93XX_RetryPolicy &policy) { this->retry_policy = policy; }
+    const V93XX_RetryPolicy &RetryPolicy() const { return this->retry_policy; }
+    const V93XX_RetryCounters &RetryCounters() const { return this->retry_counters; }
+    void ResetRetryCounters() { this->retry_counters = V93XX_RetryCounters(); }
+
+    /**
+     * @brief Route every SYS_INTSTS poll made while waiting for a status bit (waveform capture,
+     * V93XX_Calibration, V93XX_ReadCache::PollStatus()) through @p source, e.g. a V93XX_Events
+     * dispatcher, so one read also serves its handlers. nullptr reads SYS_INTSTS directly.
+     */
+    void SetInterruptStatusSource(V93XX_InterruptStatusSource source, void *context = nullptr) {
+        this->interrupt_status_source = source;
+        this->interrupt_status_context = context;
+    }
+
+    bool HasInterruptStatusSource() const { return this->interrupt_status_source != nullptr; }
+
+    /**
+     * @brief Read SYS_INTSTS through the configured source, otherwise with RegisterReadWithRetry().
+     */
+    V93XX_Status ReadInterruptStatus(uint32_t &sys_intsts) {
+        sys_intsts = 0;
+        if (this->interrupt_status_source) {
+            return this->interrupt_status_source(this->interrupt_status_context, sys_intsts);
+        }
+        V93XX_Result<uint32_t> result = RegisterReadWithRetry(SYS_INTSTS);
+        if (result.Ok()) {
+            sys_intsts = result.value;
+        }
+        return result.status;
+    }
+
+    /**
+     * @brief Latency histograms and link health counters (all zero unless built with V93XX_ENABLE_STATS=1).
+     */
+    const V93XX_LinkStats &LinkStats() const { return this->link_stats.Stats(); }
+    void ResetLinkStats() { this->link_stats.Reset(); }
+
+    /**
+     * @brief Read a register, retrying failed frames per the retry policy.
+     *
+     * Only registers whose reads have no side effects are retried (V93XX_RegisterMap::IsReadIdempotent()).
+     * Reads of DAT_WAVE and SYS_RAMDATA advance the chip's pointer, so a read that failed after the
+     * chip answered cannot be repeated without skipping a word; those are tried once.
+     */
+    V93XX_Result<uint32_t> RegisterReadWithRetry(uint8_t address) {
+        V93XX_Result<uint32_t> result;
+        do {
+            RetryBackoff(result.attempts);
+            result.attempts++;
+            result.status = this->RegisterReadStatus(address, result.value);
+        } while (ShouldRetry(result.status, result.attempts, V93XX_RegisterMap::IsReadIdempotent(address)));
+        CountOperation(result.status, result.attempts);
+        return result;
+    }
+
+    /**
+     * @brief Write a register, retrying per the retry policy.
+     *
+     * Only ReadWrite registers are idempotent and retried; writes that trigger an action or clear
+     * state (DSP_PHS_STT, SYS_SFTRST, SYS_INTSTS, ...) are sent once. With verify_writes the value
+     * of a ReadWrite register is read back and a mismatch is retried as VerifyMismatch.
+     */
+    V93XX_Status RegisterWriteWithRetry(uint8_t address, uint32_t value) {
+        const bool idempotent = V93XX_RegisterMap::IsWritable(address) &&
+                                V93XX_RegisterMap::Describe(address).access == V93XX_RegisterMap::Access::ReadWrite;
+        V93XX_Status status = V93XX_Status::NoResponse;
+        uint8_t attempts = 0;
+        do {
+            RetryBackoff(attempts);
+            attempts++;
+            status = this->RegisterWriteStatus(address, value);
+            if (status == V93XX_Status::Ok && idempotent && this->retry_policy.verify_writes) {
+                uint32_t readback = 0;
+                status = this->RegisterReadStatus(address, readback);
+                if (status == V93XX_Status::Ok && readback != value) {
+                    status = V93XX_Status::VerifyMismatch;
+                }
+            }
+        } while (ShouldRetry(status, attempts, idempotent));
+        CountOperation(status, attempts);
+        return status;
+    }
+
+    /**
+     * @brief Block read (see ConfigureBlockRead()), retrying the whole block on a failed frame.
+     *
+     * A view that maps DAT_WAVE or SYS_RAMDATA is read once: every slot advances the chip's pointer.
+     */
+    V93XX_Status RegisterBlockReadWithRetry(uint32_t (&values)[], uint8_t num_values) {
+        V93XX_Status status = V93XX_Status::NoResponse;
+        uint8_t attempts = 0;
+        do {
+            RetryBackoff(attempts);
+            attempts++;
+            status = this->RegisterBlockReadStatus(values, num_values);
+        } while (ShouldRetry(status, attempts, this->block_view_idempotent));
+        CountOperation(status, attempts);
+        return status;
+    }
+
+    /**
+     * @brief Map up to 16 registers into the block-read window (SYS_BLK_ADDR0..3).
+     *
+     * Mapping words the chip already holds are not rewritten, so switching between views
+     * costs only the words that differ. Each mapping write is retried per the retry policy; a word
+     * whose write failed is marked unknown, so the next call rewrites it.
+     *
+     * @return Ok, or the status of the first mapping write that failed (the block read must not
+     *         be trusted then)
+     */
+    V93XX_Status ConfigureBlockRead(const uint8_t addresses[], uint8_t num_addresses) {
+        uint8_t count = (num_addresses > 16) ? 16 : num_addresses;
+        this->SetBlockReadView(addresses, count);
+        this->block_view_idempotent = V93XX_RegisterMap::IsReadIdempotent(addresses, count);
+
+        V93XX_Status result = V93XX_Status::Ok;
+        uint8_t const *address_ptr = addresses;
+        for (int blk = 0; blk < 4; blk++) {
+            uint32_t combined_address = 0;
+            for (int i = 0; (i < 4) && (num_addresses); i++) {
+                combined_address |= ((uint32_t)*address_ptr++ << (8 * i));
+                num_addresses--;
+            }
+            if ((this->block_addr_valid & (1 << blk)) && this->block_addr_shadow[blk] == combined_address) {
+                continue;
+            }
+            V93XX_Status status = RegisterWriteWithRetry(SYS_BLK_ADDR0 + blk, combined_address);
+            if (status != V93XX_Status::Ok) {
+                this->block_addr_valid &= (uint8_t)~(1 << blk);
+                if (result == V93XX_Status::Ok) {
+                    result = status;
+                }
+                continue;
+            }
+            this->block_addr_shadow[blk] = combined_address;
+            this->block_addr_valid |= (1 << blk);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Trigger a manual waveform capture and read it back through DAT_WAVE.
+     * @param word_count Words to read (clamped to SYS_MISC.WAVESTORE_CNT when the chip reports fewer)
+     * @param block_words Words per block read (1-16)
+     * @return false on timeout or if the chip reported WAVEOV
+     */
+    bool CaptureWaveform(uint32_t *buffer, size_t word_count, uint32_t ctrl5, uint32_t timeout_ms = 1000,
+                         uint8_t block_words = 16) {
+        if (!buffer) {
+            return false;
+        }
+        return CaptureWaveform(CopyWaveformChunk, buffer, word_count, ctrl5, timeout_ms, block_words);
+    }
+
+    /**
+     * @brief Streaming capture: hand each block read to @p sink as soon as it arrives.
+     *
+     * Needs no capture-sized buffer; the chunk (at most 16 words and their 32 unpacked samples)
+     * lives on this function's stack, so consumers can process the waveform incrementally.
+     *
+     * @return false if arming failed, on timeout, if the chip reported WAVEOV or if the sink stopped
+     *         the capture; per-block read failures are reported in each chunk's status
+     */
+    bool CaptureWaveform(V93XX_WaveformSink sink, void *context, size_t word_count, uint32_t ctrl5,
+                         uint32_t timeout_ms = 1000, uint8_t block_words = 16) {
+        if (!this->LinkReady() || !sink || word_count == 0) {
+            return false;
+        }
+
+        if (ArmWaveformCapture(ctrl5) != V93XX_Status::Ok) {
+            return false;
+        }
+
+        bool overflow = false;
+        if (!WaitForWaveform(timeout_ms, overflow)) {
+            return false;
+        }
+
+        word_count = StoredWaveformWords(word_count);
+        if (MapWaveformBlock() != V93XX_Status::Ok) {
+            return false;
+        }
+
+        uint8_t per_read = block_words;
+        if (per_read == 0 || per_read > 16) {
+            per_read = 16;
+        }
+
+        uint32_t words[16];
+        int16_t samples[32];
+        V93XX_WaveformChunk chunk;
+        chunk.words = words;
+        chunk.samples = samples;
+        chunk.overflow = overflow;
+
+        size_t index = 0;
+        while (index < word_count) {
+            uint8_t read_size = (word_count - index < per_read) ? (uint8_t)(word_count - index) : per_read;
+            chunk.status = ReadWaveformBlock(words, read_size);
+            for (uint8_t i = 0; i < read_size; i++) {
+                samples[2 * i] = (int16_t)(words[i] & 0xFFFF);
+                samples[2 * i + 1] = (int16_t)(words[i] >> 16);
+            }
+            chunk.first_word = index;
+            chunk.word_count = read_size;
+            chunk.sample_count = (uint8_t)(2 * read_size);
+            index += read_size;
+            chunk.last = (index >= word_count);
+            if (!sink(chunk, context)) {
+                return false;
+            }
+        }
+
+        return !overflow;
+    }
+
+    /**
+     * @brief Clear the wave status bits and start a manual capture (first step of CaptureWaveform()).
+     * @return Ok, or the status of the failed write (a capture is not started if the clear failed)
+     */
+    V93XX_Status ArmWaveformCapture(uint32_t ctrl5) {
+        V93XX_Status status =
+            RegisterWriteWithRetry(SYS_INTSTS, SYS_INTSTS_WAVEOV | SYS_INTSTS_WAVESTORE | SYS_INTSTS_WAVEUPD);
+        if (status != V93XX_Status::Ok) {
+            return status;
+        }
+
+        uint32_t ctrl5_value = V93XX_RegisterMap::Set<V93XX_RegisterMap::DspCtrl5::WaveAddrClr>(ctrl5, true);
+        ctrl5_value = V93XX_RegisterMap::Set<V93XX_RegisterMap::DspCtrl5::TrigManual>(ctrl5_value, true);
+        // Sent once: the trigger bits self-clear, so a verified or repeated write would re-arm.
+        return this->RegisterWriteStatus(DSP_CTRL5, ctrl5_value);
+    }
+
+    /**
+     * @brief Clamp @p word_count to SYS_MISC.WAVESTORE_CNT once the capture is stored.
+     */
+    size_t StoredWaveformWords(size_t word_count) {
+        uint16_t wavestore_cnt = V93XX_RegisterMap::Get<V93XX_RegisterMap::SysMisc::WaveStoreCnt>(
+            this->RegisterRead(SYS_MISC));
+        if (wavestore_cnt > 0 && wavestore_cnt < word_count) {
+            word_count = wavestore_cnt;
+        }
+        return word_count;
+    }
+
+    /**
+     * @brief Map DAT_WAVE into all 16 block-read slots (no bus traffic if already mapped).
+     */
+    V93XX_Status MapWaveformBlock() { return MapRepeatedBlock(DAT_WAVE); }
+
+    /**
+     * @brief Read the next @p count (1-16) stored words; requires MapWaveformBlock().
+     *
+     * Each DAT_WAVE read advances the chip's wave pointer, so a capture can be read in any number of
+     * blocks with other traffic in between, as long as the mapping is restored before each block.
+     */
+    V93XX_Status ReadWaveformBlock(uint32_t *buffer, uint8_t count) {
+        return ReadRepeatedBlock(DAT_WAVE, buffer, count);
+    }
+
+    /**
+     * @brief Find out whether SYS_RAMDATA reads step through RAM (sets RamAccess() to the result).
+     *
+     * Reads a few words one by one, then again as a stream after a single address write, and compares.
+     * A RAM region that reads uniform is skipped; if the first V93XX_Ram::kProbeSpan words are all
+     * uniform, per-word access is kept.
+     */
+    V93XX_Status ProbeRamAutoIncrement(bool &supported) {
+        supported = false;
+        if (!this->LinkReady()) {
+            return V93XX_Status::NotReady;
+        }
+        uint32_t single[V93XX_Ram::kProbeWords];
+        uint32_t streamed[V93XX_Ram::kProbeWords];
+        for (uint16_t base = 0; base < V93XX_Ram::kProbeSpan; base += V93XX_Ram::kProbeWords) {
+            V93XX_Status status = ReadRamChunk(base, single, V93XX_Ram::kProbeWords, false, false);
+            if (status != V93XX_Status::Ok) {
+                return status;
+            }
+            bool uniform = true;
+            for (uint8_t i = 1; i < V93XX_Ram::kProbeWords; i++) {
+                uniform = uniform && single[i] == single[0];
+            }
+            if (uniform) {
+                continue;
+            }
+            status = MapRepeatedBlock(SYS_RAMDATA);
+            if (status == V93XX_Status::Ok) {
+                status = ReadRamChunk(base, streamed, V93XX_Ram::kProbeWords, true, false);
+            }
+            if (status != V93XX_Status::Ok) {
+                return status;
+            }
+            supported = true;
+            for (uint8_t i = 0; i < V93XX_Ram::kProbeWords; i++) {
+                supported = supported && streamed[i] == single[i];
+            }
+            break;
+        }
+        this->ram_access = supported ? V93XX_RamAccess::AutoIncrement : V93XX_RamAccess::PerWord;
+        return V93XX_Status::Ok;
+    }
+
+    /**
+     * @brief Select how ReadRam() addresses RAM; Auto probes on the next dump.
+     */
+    void SetRamAccess(V93XX_RamAccess access) { this->ram_access = access; }
+    V93XX_RamAccess RamAccess() const { return this->ram_access; }
+
+    /**
+     * @brief Dump internal RAM through SYS_RAMADDR / SYS_RAMDATA, 16 words per chunk.
+     *
+     * Every chunk must arrive with a valid checksum, in either ChecksumMode; a failed chunk is
+     * re-addressed and retried per the retry policy.
+     *
+     * @param crc If set, receives the CRC-32 (zlib) of the words read, little-endian
+     * @return Ok, also when the sink stopped early; InvalidArgument for a range outside RAM or no sink;
+     *         the status of a chunk that ran out of attempts
+     */
+    V93XX_Status ReadRam(uint16_t address, size_t word_count, V93XX_RamSink sink, void *context,
+                         uint32_t *crc = nullptr) {
+        if (!this->LinkReady()) {
+            return V93XX_Status::NotReady;
+        }
+        if (!sink || word_count == 0 || address >= V93XX_Ram::kWords ||
+            word_count > (size_t)(V93XX_Ram::kWords - address)) {
+            return V93XX_Status::InvalidArgument;
+        }
+        if (this->ram_access == V93XX_RamAccess::Auto) {
+            bool supported = false;
+            V93XX_Status status = ProbeRamAutoIncrement(supported);
+            if (status != V93XX_Status::Ok) {
+                return status;
+            }
+        }
+        const bool increment = this->ram_access == V93XX_RamAccess::AutoIncrement;
+        if (increment) {
+            V93XX_Status status = MapRepeatedBlock(SYS_RAMDATA);
+            if (status != V93XX_Status::Ok) {
+                return status;
+            }
+        }
+
+        uint32_t words[16];
+        V93XX_RamChunk chunk;
+        chunk.words = words;
+        uint32_t running_crc = 0;
+        size_t index = 0;
+        while (index < word_count) {
+            uint8_t count = (word_count - index < 16) ? (uint8_t)(word_count - index) : 16;
+            uint16_t chunk_address = (uint16_t)(address + index);
+            // After a complete chunk the chip's pointer is already at the next one.
+            V93XX_Status status = ReadRamChunk(chunk_address, words, count, increment, index > 0);
+            if (status != V93XX_Status::Ok) {
+                return status;
+            }
+
+            running_crc = RamCrc32(words, count, running_crc);
+            if (crc) {
+                *crc = running_crc;
+            }
+            chunk.first_word = index;
+            chunk.address = chunk_address;
+            chunk.word_count = count;
+            index += count;
+            chunk.last = (index >= word_count);
+            if (!sink(chunk, context)) {
+                break;
+            }
+        }
+        return V93XX_Status::Ok;
+    }
+
+    /**
+     * @brief Dump internal RAM into @p buffer (word_count words).
+     */
+    V93XX_Status ReadRam(uint16_t address, uint32_t *buffer, size_t word_count, uint32_t *crc = nullptr) {
+        if (!buffer) {
+            return V93XX_Status::InvalidArgument;
+        }
+        return ReadRam(address, word_count, CopyRamChunk, buffer, crc);
+    }
+
+    /**
+     * @brief Write internal RAM word by word (SYS_RAMDATA, then SYS_RAMADDR with WR and REQ).
+     *
+     * Each word's pair of writes is retried per the retry policy. With @p verify the range is read
+     * back and compared by CRC-32, returning VerifyMismatch on a difference.
+     */
+    V93XX_Status WriteRam(uint16_t address, const uint32_t *words, size_t word_count, bool verify = true) {
+        if (!this->LinkReady()) {
+            return V93XX_Status::NotReady;
+        }
+        if (!words || word_count == 0 || address >= V93XX_Ram::kWords ||
+            word_count > (size_t)(V93XX_Ram::kWords - address)) {
+            return V93XX_Status::InvalidArgument;
+        }
+        for (size_t i = 0; i < word_count; i++) {
+            V93XX_Status status = V93XX_Status::NoResponse;
+            uint8_t attempts = 0;
+            do {
+                RetryBackoff(attempts);
+                attempts++;
+                status = this->RegisterWriteStatus(SYS_RAMDATA, words[i]);
+                if (status == V93XX_Status::Ok) {
+                    status = this->RegisterWriteStatus(SYS_RAMADDR, RamAddressWord((uint16_t)(address + i), true));
+                }
+            } while (ShouldRetry(status, attempts, true));
+            CountOperation(status, attempts);
+            if (status != V93XX_Status::Ok) {
+                return status;
+            }
+        }
+        return verify ? VerifyRam(address, word_count, RamCrc32(words, word_count)) : V93XX_Status::Ok;
+    }
+
+    /**
+     * @brief Read a RAM range back and compare its CRC-32 with @p expected_crc (see RamCrc32()).
+     */
+    V93XX_Status VerifyRam(uint16_t address, size_t word_count, uint32_t expected_crc) {
+        uint32_t crc = 0;
+        V93XX_Status status = ReadRam(address, word_count, DiscardRamChunk, nullptr, &crc);
+        if (status == V93XX_Status::Ok && crc != expected_crc) {
+            status = V93XX_Status::VerifyMismatch;
+        }
+        return status;
+    }
+
+    /**
+     * @brief CRC-32 (zlib) of RAM words as little-endian bytes; pass the previous result to continue.
+     */
+    static uint32_t RamCrc32(const uint32_t *words, size_t word_count, uint32_t crc = 0) {
+        for (size_t i = 0; i < word_count; i++) {
+            uint8_t bytes[4] = {(uint8_t)words[i], (uint8_t)(words[i] >> 8), (uint8_t)(words[i] >> 16),
+                                (uint8_t)(words[i] >> 24)};
+            crc = V93XX_ConfigImage::Crc32(bytes, sizeof(bytes), crc);
+        }
+        return crc;
+    }
+
+    /**
+     * @brief Load complete configuration (control and calibration registers), DSP_CFG_CKSUM last.
+     *
+     * The chip's self-check also covers the thresholds 0x55-0x60. With @p thresholds they are
+     * written too; without, the values the chip holds are read back (strict reads) and balanced.
+     *
+     * Every word is written with RegisterWriteWithRetry(); the load stops at the first write that
+     * still fails, without writing DSP_CFG_CKSUM.
+     *
+     * @return Ok, the status of the failed threshold read (nothing is written then), or of the
+     *         first failed write
+     */
+    V93XX_Status LoadConfiguration(const ControlRegisters &ctrl, const CalibrationRegisters &calibrations,
+                                   const ThresholdRegisters *thresholds = nullptr) {
+        ThresholdRegisters loaded;
+        if (thresholds) {
+            loaded = *thresholds;
+        } else {
+            V93XX_Status status = ReadThresholds(loaded);
+            if (status != V93XX_Status::Ok) {
+                return status;
+            }
+        }
+
+        // Load control values [0x00 - 0x07]
+        V93XX_Status status = V93XX_Status::Ok;
+        for (uint8_t i = 0; i < kControlWords && status == V93XX_Status::Ok; i++) {
+            status = RegisterWriteWithRetry(kControlBase + i, ctrl._array[i]);
+        }
+
+        // Load calibration values [0x25 - 0x3a], DSP_CFG_CKSUM is written last
+        for (uint8_t i = 0; i < kCalibrationWords && status == V93XX_Status::Ok; i++) {
+            if (kCalibrationBase + i == DSP_CFG_CKSUM) {
+                continue;
+            }
+            status = RegisterWriteWithRetry(kCalibrationBase + i, calibrations._array[i]);
+        }
+
+        // Load thresholds [0x55 - 0x60] when given
+        if (thresholds) {
+            for (uint8_t i = 0; i < kThresholdWords && status == V93XX_Status::Ok; i++) {
+                status = RegisterWriteWithRetry(kThresholdBase + i, loaded._array[i]);
+            }
+        }
+
+        if (status != V93XX_Status::Ok) {
+            return status;
+        }
+        return RegisterWriteWithRetry(DSP_CFG_CKSUM, ConfigurationChecksum(ctrl, calibrations, loaded));
+    }
+
+    /**
+     * @brief Read DSP_OV_THL..FD_IB_LCTH (0x55-0x60); every word needs a valid frame checksum.
+     */
+    V93XX_Status ReadThresholds(ThresholdRegisters &thresholds) {
+        uint32_t values[kThresholdWords] = {0};
+        V93XX_Status status = V93XX_Status::Ok;
+        if constexpr (Transport::kNativeBlockRead) {
+            uint8_t addresses[kThresholdWords];
+            for (uint8_t i = 0; i < kThresholdWords; i++) {
+                addresses[i] = kThresholdBase + i;
+            }
+            status = ConfigureBlockRead(addresses, kThresholdWords);
+            if (status == V93XX_Status::Ok) {
+                status = RegisterBlockReadWithRetry(values, kThresholdWords);
+            }
+        } else {
+            for (uint8_t i = 0; i < kThresholdWords && status == V93XX_Status::Ok; i++) {
+                V93XX_Result<uint32_t> result = RegisterReadWithRetry(kThresholdBase + i);
+                status = result.status;
+                values[i] = result.value;
+            }
+        }
+        if (status == V93XX_Status::Ok) {
+            for (uint8_t i = 0; i < kThresholdWords; i++) {
+                thresholds._array[i] = values[i];
+            }
+        }
+        return status;
+    }
+
+    /**
+     * @brief DSP_CFG_CKSUM value that makes the checksum set {0x00-0x07, 0x25-0x3a, 0x55-0x60}
+     * sum to 0xFFFFFFFF for this image (V93XX_RegisterMap::ConfigurationChecksum()).
+     *
+     * The image's own DSP_CFG_CKSUM slot is a placeholder, not part of the sum.
+     */
+    static uint32_t ConfigurationChecksum(const ControlRegisters &ctrl, const CalibrationRegisters &calibrations,
+                                          const ThresholdRegisters &thresholds) {
+        return V93XX_RegisterMap::ConfigurationChecksum([&](uint8_t address) -> uint32_t {
+            if (address < kControlBase + kControlWords) {
+                return ctrl._array[address - kControlBase];
+            }
+            if (address < kCalibrationBase + kCalibrationWords) {
+                return calibrations._array[address - kCalibrationBase];
+            }
+            return thresholds._array[address - kThresholdBase];
+        });
+    }
+
+    /**
+     * @brief Check whether the chip still holds a configuration image.
+     *
+     * Status reads require a valid frame checksum even in Dirty mode.
+     *
+     * @param compare_registers Also read back 0x00-0x07 and 0x25-0x3a (and 0x55-0x60 when
+     *        @p thresholds is given) and compare word by word
+     * @param thresholds Expected 0x55-0x60, or nullptr to take the chip's own values for the checksum
+     * @return true if SYS_STS reports no checksum error and DSP_CFG_CKSUM matches the image
+     */
+    bool VerifyConfiguration(const ControlRegisters &ctrl, const CalibrationRegisters &calibrations,
+                             bool compare_registers = false, const ThresholdRegisters *thresholds = nullptr) {
+        if (!this->LinkReady()) {
+            return false;
+        }
+
+        ThresholdRegisters chip_thresholds;
+        if (!thresholds || compare_registers) {
+            if (ReadThresholds(chip_thresholds) != V93XX_Status::Ok) {
+                return false;
+            }
+        }
+        if (thresholds && compare_registers) {
+            for (uint8_t i = 0; i < kThresholdWords; i++) {
+                if (chip_thresholds._array[i] != thresholds->_array[i]) {
+                    return false;
+                }
+            }
+        }
+        const uint32_t expected_checksum =
+            ConfigurationChecksum(ctrl, calibrations, thresholds ? *thresholds : chip_thresholds);
+
+        uint32_t sys_sts = 0;
+        uint32_t cfg_checksum = 0;
+        if (!this->RegisterReadStrict(SYS_STS, sys_sts) || !this->RegisterReadStrict(DSP_CFG_CKSUM, cfg_checksum)) {
+            return false;
+        }
+        if ((sys_sts & SYS_STS_CKERR) || cfg_checksum != expected_checksum) {
+            return false;
+        }
+        if (!compare_registers) {
+            return true;
+        }
+
+        // Both configuration ranges: two block reads (16 + 14 words) on a native block-read bus,
+        // otherwise one checked read per register.
+        const uint8_t total_words = kControlWords + kCalibrationWords;
+        uint8_t index = 0;
+        while (index < total_words) {
+            uint8_t count = (total_words - index < 16) ? (uint8_t)(total_words - index) : 16;
+            uint8_t addresses[16];
+            uint32_t expected[16];
+            for (uint8_t i = 0; i < count; i++) {
+                uint8_t word = index + i;
+                if (word < kControlWords) {
+                    addresses[i] = kControlBase + word;
+                    expected[i] = ctrl._array[word];
+                } else {
+                    addresses[i] = kCalibrationBase + (word - kControlWords);
+                    expected[i] =
+                        (addresses[i] == DSP_CFG_CKSUM) ? expected_checksum : calibrations._array[word - kControlWords];
+                }
+            }
+
+            uint32_t values[16] = {0};
+            if constexpr (Transport::kNativeBlockRead) {
+                if (ConfigureBlockRead(addresses, count) != V93XX_Status::Ok ||
+                    RegisterBlockReadWithRetry(values, count) != V93XX_Status::Ok) {
+                    return false;
+                }
+            } else {
+                for (uint8_t i = 0; i < count; i++) {
+                    if (!this->RegisterReadStrict(addresses[i], values[i])) {
+                        return false;
+                    }
+                }
+            }
+            for (uint8_t i = 0; i < count; i++) {
+                if (values[i] != expected[i]) {
+                    return false;
+                }
+            }
+            index += count;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Keep a chip that still holds this image (e.g. after an MCU-only brownout), otherwise
+     * re-establish the link and reload it. Call after Init().
+     * @param reloaded Set to false if the chip kept the image, true if a reload was attempted
+     * @return Ok if the chip holds the image now; otherwise the status of the failed reload (see
+     *         LoadConfiguration()), and the chip must be treated as unconfigured
+     */
+    V93XX_Status WarmStart(const ControlRegisters &ctrl, const CalibrationRegisters &calibrations, bool &reloaded,
+                           bool compare_registers = false, const ThresholdRegisters *thresholds = nullptr) {
+        reloaded = false;
+        if (VerifyConfiguration(ctrl, calibrations, compare_registers, thresholds)) {
+            return V93XX_Status::Ok;
+        }
+
+        reloaded = true;
+        this->Recover();
+        return LoadConfiguration(ctrl, calibrations, thresholds);
+    }
+
+  private:
+    V93XX_RetryPolicy retry_policy;
+    V93XX_RetryCounters retry_counters;
+    V93XX_RamAccess ram_access = V93XX_RamAccess::Auto;
+    bool block_view_idempotent = true;
+    V93XX_InterruptStatusSource interrupt_status_source = nullptr;
+    void *interrupt_status_context = nullptr;
+
+    /**
+     * @brief Map @p address into all 16 block-read slots (no bus traffic if already mapped).
+     */
+    V93XX_Status MapRepeatedBlock(uint8_t address) {
+        uint8_t block_read_addrs[16];
+        for (size_t i = 0; i < 16; i++) {
+            block_read_addrs[i] = address;
+        }
+        return ConfigureBlockRead(block_read_addrs, 16);
+    }
+
+    /**
+     * @brief Read @p count (1-16) words from a register whose reads advance an internal pointer.
+     */
+    V93XX_Status ReadRepeatedBlock(uint8_t address, uint32_t *buffer, uint8_t count) {
+        count = (count > 16) ? 16 : count;
+        V93XX_Status status = V93XX_Status::Ok;
+        if constexpr (Transport::kNativeBlockRead) {
+            uint32_t data[16] = {0};
+            status = this->RegisterBlockReadStatus(data, count);
+            for (uint8_t i = 0; i < count; i++) {
+                buffer[i] = data[i];
+            }
+        } else {
+            // Keep reading after a failed word: every read advances the pointer, and stopping
+            // early would shift all later blocks.
+            for (uint8_t i = 0; i < count; i++) {
+                V93XX_Status word_status = this->RegisterReadStatus(address, buffer[i]);
+                if (status == V93XX_Status::Ok) {
+                    status = word_status;
+                }
+            }
+        }
+        if constexpr (Transport::kInterBlockDelayMs != 0) {
+            delay(Transport::kInterBlockDelayMs);
+        }
+        return status;
+    }
+
+    static uint32_t RamAddressWord(uint16_t address, bool write) {
+        uint32_t value = V93XX_RegisterMap::Set<V93XX_RegisterMap::SysRamAddr::Addr>(0, address);
+        value = V93XX_RegisterMap::Set<V93XX_RegisterMap::SysRamAddr::Wr>(value, write);
+        return V93XX_RegisterMap::Set<V93XX_RegisterMap::SysRamAddr::Req>(value, true);
+    }
+
+    /**
+     * @brief One chunk of RAM, retried per the retry policy.
+     *
+     * With @p increment the address is written once (not at all when @p addressed says the chip's
+     * pointer is already there) and the words are streamed: one block read on a native block-read
+     * bus, otherwise one read per word, so a failed word is re-addressed and retried on its own.
+     * Without it every word costs an address write and a read.
+     *
+     * The chip finishes a RAM access within a few system clocks, well before the next frame, so
+     * SYS_RAMADDR.REQ is not polled.
+     */
+    V93XX_Status ReadRamChunk(uint16_t address, uint32_t *words, uint8_t count, bool increment, bool addressed) {
+        const bool block = increment && Transport::kNativeBlockRead;
+        V93XX_Status status = V93XX_Status::Ok;
+        uint8_t done = 0;
+        while (done < count && status == V93XX_Status::Ok) {
+            uint16_t word_address = (uint16_t)(address + done);
+            uint8_t attempts = 0;
+            do {
+                RetryBackoff(attempts);
+                attempts++;
+                // A failed attempt may have moved the chip's pointer, so every retry addresses explicitly.
+                bool in_place = increment && attempts == 1 && (addressed || done > 0);
+                status = in_place ? V93XX_Status::Ok
+                                  : this->RegisterWriteStatus(SYS_RAMADDR, RamAddressWord(word_address, false));
+                if (status == V93XX_Status::Ok) {
+                    status = block ? ReadRepeatedBlock(SYS_RAMDATA, words, count)
+                                   : this->RegisterReadStatus(SYS_RAMDATA, words[done]);
+                }
+            } while (ShouldRetry(status, attempts, true));
+            CountOperation(status, attempts);
+            done = block ? count : (uint8_t)(done + 1);
+        }
+        return status;
+    }
+
+    static bool CopyRamChunk(const V93XX_RamChunk &chunk, void *context) {
+        uint32_t *buffer = static_cast<uint32_t *>(context) + chunk.first_word;
+        for (uint8_t i = 0; i < chunk.word_count; i++) {
+            buffer[i] = chunk.words[i];
+        }
+        return true;
+    }
+
+    static bool DiscardRamChunk(const V93XX_RamChunk &, void *) { return true; }
+
+    /**
+     * @brief Poll SYS_INTSTS (ReadInterruptStatus()) until the armed capture is stored (WAVESTORE)
+     * or overflowed (WAVEOV). A failed status read is never taken for either bit.
+     * @return false on timeout
+     */
+    bool WaitForWaveform(uint32_t timeout_ms, bool &overflow) {
+        uint32_t start = millis();
+        while ((millis() - start) < timeout_ms) {
+            uint32_t sys_intsts = 0;
+            V93XX_Status status = ReadInterruptStatus(sys_intsts);
+            if (status == V93XX_Status::NotReady) {
+                return false;
+            }
+            if (sys_intsts & SYS_INTSTS_WAVEOV) {
+                overflow = true;
+                return true;
+            }
+            if (sys_intsts & SYS_INTSTS_WAVESTORE) {
+                return true;
+            }
+            delay(1);
+        }
+        return false;
+    }
+
+    static bool CopyWaveformChunk(const V93XX_WaveformChunk &chunk, void *context) {
+        uint32_t *buffer = static_cast<uint32_t *>(context) + chunk.first_word;
+        for (uint8_t i = 0; i < chunk.word_count; i++) {
+            buffer[i] = chunk.words[i];
+        }
+        return true;
+    }
+
+    bool ShouldRetry(V93XX_Status status, uint8_t attempts, bool retryable) {
+        if (status == V93XX_Status::Ok) {
+            return false;
+        }
+        this->retry_counters.errors[(size_t)status]++;
+        // Retrying cannot help an uninitialized link or a rejected argument.
+        return retryable && status != V93XX_Status::NotReady && status != V93XX_Status::InvalidArgument &&
+               attempts < this->retry_policy.max_attempts;
+    }
+
+    void RetryBackoff(uint8_t failed_attempts) {
+        if (failed_attempts == 0) {
+            return;
+        }
+        this->retry_counters.retries++;
+        this->link_stats.CountRetry();
+        uint32_t wait_us = (uint32_t)failed_attempts * this->retry_policy.backoff_byte_times * this->ByteTimeUs();
+        if (wait_us > 0) {
+            delayMicroseconds(wait_us);
+        }
+    }
+
+    void CountOperation(V93XX_Status status, uint8_t attempts) {
+        this->retry_counters.operations++;
+        if (status != V93XX_Status::Ok) {
+            this->retry_counters.failures++;
+        } else if (attempts > 1) {
+            this->retry_counters.recovered++;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,350 @@
+#ifndef V93XX_ACQUISITION_H__
+#define V93XX_ACQUISITION_H__
+
+#include "V93XX_Registers.h"
+#include "V93XX_Status.h"
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#endif
+#if defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <chrono>
+#include <thread>
+#endif
+
+/**
+ * @brief Register values published by V93XX_Acquisition (the same layout for every transport).
+ */
+struct V93XX_AcquisitionSnapshot {
+    static constexpr uint8_t kMaxGroups = 8;
+    static constexpr uint8_t kRegisterCount = 0x80;
+
+    uint32_t sequence;     // Publishes so far (1 for the first snapshot)
+    uint32_t timestamp_ms; // V93XX_AcquisitionNowMs() (millis() on Arduino) at publish
+    uint32_t values[kRegisterCount];
+    uint32_t group_timestamp_ms[kMaxGroups]; // Last read of each group
+    V93XX_Status group_status[kMaxGroups];   // Outcome of that read (values keep the last good data)
+};
+
+/**
+ * @brief Time base of every acquisition timestamp: millis() on Arduino, a steady clock elsewhere.
+ */
+inline uint32_t V93XX_AcquisitionNowMs() {
+#if defined(ARDUINO)
+    return millis();
+#else
+    static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - origin)
+        .count();
+#endif
+}
+
+struct V93XX_AcquisitionTaskConfig {
+    uint32_t stack_bytes = 4096;
+    uint8_t priority = 2; // Above the Arduino loop task (1)
+    int8_t core = 1;      // ESP32 only; -1 = no affinity
+};
+
+/**
+ * @brief Background acquisition: one task owns the bus, any number of readers share the results.
+ *
+ * Register groups (up to 16 consecutive registers each) are polled at their own period by a
+ * dedicated task (FreeRTOS task pinned to a core on ESP32, std::thread elsewhere). After each
+ * pass the task publishes a Snapshot through a seqlock over two buffers: the task always
+ * writes the buffer readers are not directed to, so Latest()/ReadValue() never block and
+ * only repeat a copy if the task published twice while it was in progress.
+ *
+ * While the service runs it is the only user of the device; other code reads the snapshot.
+ * Poll() runs one scheduling pass in the caller's thread for single-threaded use.
+ *
+ * Works with V93XX_UART and V93XX_SPI (uses ConfigureBlockRead() and the *WithRetry() calls).
+ */
+template <typename Device> class V93XX_Acquisition {
+  public:
+    typedef V93XX_AcquisitionSnapshot Snapshot;
+    typedef V93XX_AcquisitionTaskConfig TaskConfig;
+
+    static constexpr uint8_t kMaxGroups = Snapshot::kMaxGroups;
+    static constexpr uint8_t kRegisterCount = Snapshot::kRegisterCount;
+
+    explicit V93XX_Acquisition(Device &device) : device(device) {}
+    ~V93XX_Acquisition() { Stop(); }
+
+    V93XX_Acquisition(const V93XX_Acquisition &) = delete;
+    V93XX_Acquisition &operator=(const V93XX_Acquisition &) = delete;
+
+    /**
+     * @brief Poll @p count registers from @p first_address every @p period_ms (call before Start()).
+     * @return Group index, or -1 if the table is full, the service runs or the range is invalid
+     */
+    int8_t AddGroup(uint8_t first_address, uint8_t count, uint32_t period_ms) {
+        if (this->running.load() || this->group_count >= kMaxGroups || count == 0 || count > 16 ||
+            first_address + count > kRegisterCount) {
+            return -1;
+        }
+        Group &group = this->groups[this->group_count];
+        group.first = first_address;
+        group.count = count;
+        group.period_ms = period_ms;
+        group.next_due_ms = V93XX_AcquisitionNowMs();
+        return (int8_t)this->group_count++;
+    }
+
+    /**
+     * @brief Make every group first due at @p epoch_ms (V93XX_AcquisitionNowMs() time base; call before Start()).
+     *
+     * Instances given the same epoch and periods sample at the same instants (see V93XX_MultiBus).
+     */
+    bool SetEpoch(uint32_t epoch_ms) {
+        if (this->running.load()) {
+            return false;
+        }
+        for (uint8_t i = 0; i < this->group_count; i++) {
+            this->groups[i].next_due_ms = epoch_ms;
+        }
+        return true;
+    }
+
+    bool Start(const TaskConfig &config = TaskConfig()) {
+        if (this->running.load() || this->group_count == 0) {
+            return false;
+        }
+        this->running.store(true);
+#if defined(ARDUINO_ARCH_ESP32)
+        this->task_done.store(false);
+        BaseType_t core = (config.core < 0) ? tskNO_AFFINITY : (BaseType_t)config.core;
+        if (xTaskCreatePinnedToCore(TaskEntry, "v93xx_acq", config.stack_bytes, this, config.priority,
+                                    &this->task, core) != pdPASS) {
+            this->running.store(false);
+            return false;
+        }
+#else
+        (void)config;
+        this->thread = std::thread(TaskEntry, this);
+#endif
+        return true;
+    }
+
+    /**
+     * @brief Stop the task after its current pass and wait for it to exit.
+     */
+    void Stop() {
+        if (!this->running.exchange(false)) {
+            return;
+        }
+#if defined(ARDUINO_ARCH_ESP32)
+        while (!this->task_done.load()) {
+            delay(1);
+        }
+        this->task = nullptr;
+#else
+        if (this->thread.joinable()) {
+            this->thread.join();
+        }
+#endif
+    }
+
+    bool Running() const { return this->running.load(); }
+
+    /**
+     * @brief Read every due group once and publish if anything was read.
+     * @return Milliseconds until the next group is due.
+     */
+    uint32_t Poll() {
+        uint32_t now = V93XX_AcquisitionNowMs();
+        bool updated = false;
+        uint32_t wait_ms = UINT32_MAX;
+        for (uint8_t i = 0; i < this->group_count; i++) {
+            Group &group = this->groups[i];
+            if ((int32_t)(now - group.next_due_ms) >= 0) {
+                ReadGroup(i);
+                updated = true;
+                group.next_due_ms += group.period_ms;
+                if ((int32_t)(now - group.next_due_ms) >= 0) {
+                    // Overran a whole period: skip the missed reads rather than bursting.
+                    group.next_due_ms = now + group.period_ms;
+                }
+            }
+            uint32_t until = group.next_due_ms - now;
+            if ((int32_t)until < 0) {
+                until = 0;
+            }
+            wait_ms = (until < wait_ms) ? until : wait_ms;
+        }
+        if (updated) {
+            Publish();
+        }
+        return (wait_ms == UINT32_MAX) ? 0 : wait_ms;
+    }
+
+    /**
+     * @brief Copy the most recent snapshot (lock-free; safe from any task or thread).
+     * @return false until the first snapshot has been published.
+     */
+    bool Latest(Snapshot &out) const {
+        uint32_t words[kSnapshotWords];
+        if (!ReadConsistent(0, kSnapshotWords, words)) {
+            return false;
+        }
+        memcpy(&out, words, sizeof(Snapshot));
+        return true;
+    }
+
+    /**
+     * @brief Copy one register of the most recent snapshot.
+     */
+    bool ReadValue(uint8_t address, uint32_t &value, uint32_t *timestamp_ms = nullptr) const {
+        if (address >= kRegisterCount) {
+            return false;
+        }
+        // timestamp_ms directly precedes values[]: one consistent read covers both.
+        uint32_t words[1 + kRegisterCount];
+        const size_t first = offsetof(Snapshot, timestamp_ms) / sizeof(uint32_t);
+        if (!ReadConsistent(first, (size_t)address + 2, words)) {
+            return false;
+        }
+        value = words[1 + address];
+        if (timestamp_ms) {
+            *timestamp_ms = words[0];
+        }
+        return true;
+    }
+
+    uint32_t Publishes() const { return this->publishes.load(); }
+
+  private:
+    struct Group {
+        uint8_t first;
+        uint8_t count;
+        uint32_t period_ms;
+        uint32_t next_due_ms;
+    };
+
+    static constexpr uint8_t kNone = 0xFF;
+    static constexpr size_t kSnapshotWords = (sizeof(Snapshot) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    static_assert(offsetof(Snapshot, values) == offsetof(Snapshot, timestamp_ms) + sizeof(uint32_t),
+                  "ReadValue() reads timestamp_ms and values[] as one range");
+
+    Device &device;
+    Group groups[kMaxGroups] = {};
+    uint8_t group_count = 0;
+
+    Snapshot working = {}; // Task-private state, copied out on publish
+
+    // Published copies, stored as relaxed atomic words so concurrent copies are well defined.
+    std::atomic<uint32_t> buffers[2][kSnapshotWords] = {};
+    std::atomic<uint32_t> buffer_seq[2] = {{0}, {0}}; // Odd while the buffer is being written
+    std::atomic<uint8_t> published{kNone};
+    std::atomic<uint32_t> publishes{0};
+    std::atomic<bool> running{false};
+
+#if defined(ARDUINO_ARCH_ESP32)
+    TaskHandle_t task = nullptr;
+    std::atomic<bool> task_done{true};
+#else
+    std::thread thread;
+#endif
+
+    void ReadGroup(uint8_t index) {
+        const Group &group = this->groups[index];
+        V93XX_Status status;
+        if (group.count == 1) {
+            V93XX_Result<uint32_t> result = this->device.RegisterReadWithRetry(group.first);
+            status = result.status;
+            if (result.Ok()) {
+                this->working.values[group.first] = result.value;
+            }
+        } else {
+            uint8_t addresses[16];
+            uint32_t values[16] = {0};
+            for (uint8_t i = 0; i < group.count; i++) {
+                addresses[i] = (uint8_t)(group.first + i);
+            }
+            status = this->device.ConfigureBlockRead(addresses, group.count);
+            if (status == V93XX_Status::Ok) {
+                status = this->device.RegisterBlockReadWithRetry(values, group.count);
+            }
+            if (status == V93XX_Status::Ok) {
+                for (uint8_t i = 0; i < group.count; i++) {
+                    this->working.values[group.first + i] = values[i];
+                }
+            }
+        }
+        this->working.group_status[index] = status;
+        this->working.group_timestamp_ms[index] = V93XX_AcquisitionNowMs();
+    }
+
+    void Publish() {
+        uint8_t current = this->published.load(std::memory_order_relaxed);
+        uint8_t target = (current == 0) ? 1 : 0;
+
+        this->working.sequence = this->publishes.load(std::memory_order_relaxed) + 1;
+        this->working.timestamp_ms = V93XX_AcquisitionNowMs();
+
+        uint32_t words[kSnapshotWords] = {0};
+        memcpy(words, &this->working, sizeof(Snapshot));
+
+        this->buffer_seq[target].fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kSnapshotWords; i++) {
+            this->buffers[target][i].store(words[i], std::memory_order_relaxed);
+        }
+        this->buffer_seq[target].fetch_add(1, std::memory_order_release);
+
+        this->published.store(target, std::memory_order_release);
+        this->publishes.store(this->working.sequence, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy words [first, first + count) of the latest published snapshot.
+     */
+    bool ReadConsistent(size_t first, size_t count, uint32_t *out) const {
+        for (;;) {
+            uint8_t index = this->published.load(std::memory_order_acquire);
+            if (index == kNone) {
+                return false;
+            }
+            uint32_t before = this->buffer_seq[index].load(std::memory_order_acquire);
+            if (before & 1) {
+                continue; // Lapped: the task is rewriting this buffer, a newer one is about to be published
+            }
+            for (size_t i = 0; i < count; i++) {
+                out[i] = this->buffers[index][first + i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (this->buffer_seq[index].load(std::memory_order_relaxed) == before) {
+                return true;
+            }
+        }
+    }
+
+    static void SleepMs(uint32_t ms) {
+#if defined(ARDUINO_ARCH_ESP32)
+        vTaskDelay(ms ? pdMS_TO_TICKS(ms) : 1);
+#else
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms ? ms : 1));
+#endif
+    }
+
+    static void TaskEntry(void *context) {
+        V93XX_Acquisition *self = static_cast<V93XX_Acquisition *>(context);
+        while (self->running.load()) {
+            uint32_t wait_ms = self->Poll();
+            // Wake at least every 10 ms so Stop() is not held up by long periods.
+            SleepMs(wait_ms < 10 ? wait_ms : 10);
+        }
+#if defined(ARDUINO_ARCH_ESP32)
+        self->task_done.store(true);
+        vTaskDelete(nullptr);
+#endif
+    }
+};
+
+#endif
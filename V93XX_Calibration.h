@@ -0,0 +1,615 @@
+#ifndef V93XX_CALIBRATION_H__
+#define V93XX_CALIBRATION_H__
+
+#include "V93XX_RegisterMap.h"
+#include "V93XX_Registers.h"
+#include "V93XX_Status.h"
+#include <Arduino.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Correction arithmetic for the DSP_CFG_* calibration registers; no bus access.
+ *
+ * Model: a ratio register holds a signed Q31 fraction, so the chip reports raw * (1 + CALI / 2^31);
+ * a small-signal register adds its signed value in output counts.
+ */
+namespace V93XX_CalibrationMath {
+
+constexpr double kQ31 = 2147483648.0;
+
+inline int32_t Saturate(double value) {
+    if (value >= 2147483647.0) {
+        return INT32_MAX;
+    }
+    if (value <= -2147483648.0) {
+        return INT32_MIN;
+    }
+    return (int32_t)lround(value);
+}
+
+/**
+ * @brief Ratio register value that turns @p measured (read with @p current applied) into @p target.
+ */
+inline uint32_t Gain(uint32_t current, double measured, double target) {
+    if (measured == 0.0) {
+        return current;
+    }
+    double gain = 1.0 + (double)(int32_t)current / kQ31;
+    return (uint32_t)Saturate((gain * target / measured - 1.0) * kQ31);
+}
+
+/**
+ * @brief Small-signal register value that moves @p measured onto @p target.
+ */
+inline uint32_t Offset(uint32_t current, double measured, double target) {
+    return (uint32_t)Saturate((double)(int32_t)current + (target - measured));
+}
+
+/**
+ * @brief DSP_CFG_CKSUM after changing checksum-set registers: the set sums to 0xFFFFFFFF, so the
+ * checksum moves by minus the total change (modulo 2^32).
+ */
+inline uint32_t UpdateChecksum(uint32_t checksum, const uint32_t *old_values, const uint32_t *new_values,
+                               size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        checksum -= new_values[i] - old_values[i];
+    }
+    return checksum;
+}
+
+} // namespace V93XX_CalibrationMath
+
+/**
+ * @brief Reference-load calibration of the DSP_CFG_* registers of one current channel.
+ *
+ * Each step averages the measurement registers (DSP_DAT_RMS1UA, RMS1IA/IB, PA1/QA1 or PB1/QB1)
+ * once per AVGRMSUPD update, for as many updates as it takes the standard error of every quantity
+ * to fall below Config::confidence (between min_periods and max_periods), computes corrections,
+ * writes them and measures again, until every quantity is within Config::tolerance of its target,
+ * no register would change by a whole LSB, or max_iterations runs out:
+ *
+ *   - CalibrateGain(): CALI_RMSUA, CALI_RMSIA/IB and CALI_PA/PB from a reference at any power
+ *     factor; CALI_QA/QB get the P ratio. At a phase angle of 30 degrees or more also DSP_CFG_PHC
+ *     (channel A), from atan2(Q, P) against the reference angle.
+ *   - CalibrateOffset(): RMS_DCUA, RMS_DCIA/IB and DC_PA/QA (or PB/QB) from a low-level reference,
+ *     run after CalibrateGain(). Repeat CalibrateGain() afterwards if the offsets were large: they
+ *     bias the power angle the PHC correction is taken from.
+ *   - CalibrateChannelDc(): DSP_CFG_DCUA/DCIA/DCIB from DSP_DAT_DCU/DCI/DCIB.
+ *
+ * Targets are the reference in engineering units times the counts-per-unit scales of Config. The
+ * PHC step is not documented in the datasheet material at hand: Config::phc_deg_per_lsb is only a
+ * starting estimate, refined from the angle change each PHC write produces.
+ *
+ * Writes use an incremental checksum: DSP_CFG_CKSUM is read from the chip and adjusted by the
+ * change in the written registers, so nothing else of the checksum set is read or needs to be
+ * known (thresholds 0x55-0x60 included). A step reports VerifyMismatch if SYS_STS.CKERR is set
+ * once it has converged. Registers() holds the calibration block for saving (e.g. V93XX_ConfigImage).
+ *
+ * Update bits are polled through the driver's ReadInterruptStatus(), so with a V93XX_Events
+ * dispatcher installed there (SetInterruptStatusSource()) its handlers keep running meanwhile.
+ *
+ * Works with V93XX_UART and V93XX_SPI (uses the *WithRetry() calls and ConfigureBlockRead()).
+ */
+template <typename Device> class V93XX_Calibration {
+  public:
+    enum class Channel : uint8_t {
+        A = 0,
+        B,
+    };
+
+    enum Quantity : uint8_t {
+        Voltage = 0,
+        Current,
+        ActivePower,
+        ReactivePower,
+        kQuantities,
+    };
+
+    struct Config {
+        Channel channel;
+        float voltage_counts_per_volt; // Target DSP_DAT_RMS1UA per volt
+        float current_counts_per_amp;  // Target DSP_DAT_RMS1IA/IB per ampere
+        float power_counts_per_watt;   // Target DSP_DAT_PA1/QA1 (PB1/QB1) per watt (var)
+        float confidence;              // Standard error of the mean, relative, at which averaging stops
+        float tolerance;               // Relative error at which a step has converged
+        uint16_t min_periods;          // Update periods averaged at least
+        uint16_t max_periods;          // ... and at most
+        uint8_t settle_periods;        // Updates discarded before averaging (filters catch up after a write)
+        uint8_t max_iterations;        // Write/measure rounds per step
+        uint32_t period_timeout_ms;    // Longest wait for one update
+        float phc_deg_per_lsb;         // Initial estimate of the DSP_CFG_PHC step (sign included)
+    };
+
+    /**
+     * @brief Reference source settings in engineering units.
+     */
+    struct Reference {
+        float voltage_rms;
+        float current_rms;
+        float phase_deg; // Current lag behind voltage; P = U I cos, Q = U I sin
+    };
+
+    struct Average {
+        V93XX_Status status;
+        float mean[kQuantities];
+        float std_error[kQuantities]; // Standard error of each mean
+        uint16_t periods;             // Updates averaged
+        bool confident;               // Every std_error within Config::confidence
+    };
+
+    struct Result {
+        V93XX_Status status;             // First failure, VerifyMismatch if CKERR is set at the end
+        bool converged;                  // Every targeted quantity within Config::tolerance (or one LSB)
+        uint8_t iterations;              // Correction writes performed
+        uint16_t periods;                // Update periods averaged in total
+        float error_before[kQuantities]; // Relative error of the first measurement
+        float error_after[kQuantities];  // Relative error of the last measurement
+    };
+
+    static Config DefaultConfig() {
+        Config config;
+        config.channel = Channel::A;
+        config.voltage_counts_per_volt = 1.0f;
+        config.current_counts_per_amp = 1.0f;
+        config.power_counts_per_watt = 1.0f;
+        config.confidence = 2e-4f;
+        config.tolerance = 1e-3f;
+        config.min_periods = 4;
+        config.max_periods = 64;
+        config.settle_periods = 2;
+        config.max_iterations = 4;
+        config.period_timeout_ms = 2000;
+        config.phc_deg_per_lsb = 0.01f;
+        return config;
+    }
+
+    explicit V93XX_Calibration(Device &device) : device(device), config(DefaultConfig()) {}
+
+    /**
+     * @brief Read the calibration block (0x25-0x3A) the corrections start from.
+     */
+    V93XX_Status Begin(const Config &config) {
+        this->config = config;
+        if (this->config.min_periods < 2) {
+            this->config.min_periods = 2;
+        }
+        if (this->config.max_periods < this->config.min_periods) {
+            this->config.max_periods = this->config.min_periods;
+        }
+        this->phc_deg_per_lsb = this->config.phc_deg_per_lsb;
+
+        const uint8_t words = Device::kCalibrationWords;
+        uint8_t index = 0;
+        while (index < words) {
+            uint8_t count = (words - index < 16) ? (uint8_t)(words - index) : 16;
+            uint8_t addresses[16];
+            uint32_t values[16] = {0};
+            for (uint8_t i = 0; i < count; i++) {
+                addresses[i] = (uint8_t)(Device::kCalibrationBase + index + i);
+            }
+            V93XX_Status status = this->device.ConfigureBlockRead(addresses, count);
+            if (status == V93XX_Status::Ok) {
+                status = this->device.RegisterBlockReadWithRetry(values, count);
+            }
+            if (status != V93XX_Status::Ok) {
+                return status;
+            }
+            for (uint8_t i = 0; i < count; i++) {
+                this->registers._array[index + i] = values[i];
+            }
+            index += count;
+        }
+        return V93XX_Status::Ok;
+    }
+
+    /**
+     * @brief Average the measurement registers until they are stable (see Config::confidence).
+     */
+    Average Measure() {
+        Average average = {};
+        double mean[kQuantities] = {0};
+        double m2[kQuantities] = {0};
+        average.status = V93XX_Status::Ok;
+
+        for (uint8_t i = 0; i < this->config.settle_periods; i++) {
+            float discard[kQuantities];
+            average.status = ReadUpdate(discard);
+            if (average.status != V93XX_Status::Ok) {
+                return average;
+            }
+        }
+
+        uint16_t n = 0;
+        while (n < this->config.max_periods) {
+            float sample[kQuantities];
+            average.status = ReadUpdate(sample);
+            if (average.status != V93XX_Status::Ok) {
+                break;
+            }
+            n++;
+            // Welford's running mean and variance.
+            for (uint8_t q = 0; q < kQuantities; q++) {
+                double delta = sample[q] - mean[q];
+                mean[q] += delta / n;
+                m2[q] += delta * (sample[q] - mean[q]);
+            }
+            if (n < this->config.min_periods) {
+                continue;
+            }
+            average.confident = true;
+            // Powers are judged against the apparent power, so Q near zero at unity PF still settles.
+            double apparent = sqrt(mean[ActivePower] * mean[ActivePower] + mean[ReactivePower] * mean[ReactivePower]);
+            for (uint8_t q = 0; q < kQuantities; q++) {
+                double scale = (q >= ActivePower) ? apparent : fabs(mean[q]);
+                double std_error = sqrt(m2[q] / (n - 1) / n);
+                average.std_error[q] = (float)std_error;
+                if (std_error > this->config.confidence * scale) {
+                    average.confident = false;
+                }
+            }
+            if (average.confident) {
+                break;
+            }
+        }
+
+        average.periods = n;
+        for (uint8_t q = 0; q < kQuantities; q++) {
+            average.mean[q] = (float)mean[q];
+        }
+        return average;
+    }
+
+    /**
+     * @brief Ratio (and, at a phase angle of 30 degrees or more, PHC) calibration at a reference load.
+     */
+    Result CalibrateGain(const Reference &reference) {
+        const bool phase_step = fabsf(sinf(reference.phase_deg * kRadPerDeg)) >= 0.5f;
+        return Run(reference, phase_step ? Step::GainAndPhase : Step::Gain);
+    }
+
+    /**
+     * @brief Small-signal calibration at a low reference load (after CalibrateGain()).
+     */
+    Result CalibrateOffset(const Reference &reference) { return Run(reference, Step::Offset); }
+
+    /**
+     * @brief Cancel the channel DC levels reported in DSP_DAT_DCU/DCI/DCIB.
+     */
+    V93XX_Status CalibrateChannelDc() {
+        static constexpr uint8_t kDcView[3] = {DSP_DAT_DCU, DSP_DAT_DCI, DSP_DAT_DCIB};
+        static constexpr uint8_t kDcConfig[3] = {DSP_CFG_DCUA, DSP_CFG_DCIA, DSP_CFG_DCIB};
+        uint32_t values[16] = {0};
+        V93XX_Status status = this->device.ConfigureBlockRead(kDcView, 3);
+        if (status == V93XX_Status::Ok) {
+            status = this->device.RegisterBlockReadWithRetry(values, 3);
+        }
+        if (status != V93XX_Status::Ok) {
+            return status;
+        }
+        uint32_t corrections[3];
+        for (uint8_t i = 0; i < 3; i++) {
+            corrections[i] = V93XX_CalibrationMath::Offset(Stored(kDcConfig[i]), (double)(int32_t)values[i], 0.0);
+        }
+        return WriteRegisters(kDcConfig, corrections, 3);
+    }
+
+    /**
+     * @brief Write checksum-set registers and adjust DSP_CFG_CKSUM by their change (DSP_CFG_CKSUM last).
+     *
+     * The old values and the checksum are read from the chip, so the update is correct even if the
+     * rest of the set is unknown to the caller. More than 16 registers, or one outside the checksum
+     * set, is InvalidArgument and nothing is read or written. If a write fails, the writes before it
+     * have landed: DSP_CFG_CKSUM is still adjusted for those, and the failed write's status is returned.
+     */
+    V93XX_Status WriteRegisters(const uint8_t *addresses, const uint32_t *values, uint8_t count) {
+        if (!addresses || !values || count == 0 || count > 16) {
+            return V93XX_Status::InvalidArgument;
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            if (!V93XX_RegisterMap::InChecksumSet(addresses[i]) || addresses[i] == DSP_CFG_CKSUM) {
+                return V93XX_Status::InvalidArgument;
+            }
+        }
+        uint32_t old_values[16];
+        for (uint8_t i = 0; i < count; i++) {
+            V93XX_Result<uint32_t> old_value = this->device.RegisterReadWithRetry(addresses[i]);
+            if (!old_value.Ok()) {
+                return old_value.status;
+            }
+            old_values[i] = old_value.value;
+        }
+        V93XX_Result<uint32_t> checksum = this->device.RegisterReadWithRetry(DSP_CFG_CKSUM);
+        if (!checksum.Ok()) {
+            return checksum.status;
+        }
+
+        V93XX_Status write_status = V93XX_Status::Ok;
+        uint8_t written = 0;
+        for (; written < count; written++) {
+            write_status = this->device.RegisterWriteWithRetry(addresses[written], values[written]);
+            if (write_status != V93XX_Status::Ok) {
+                break;
+            }
+            Store(addresses[written], values[written]);
+        }
+        if (written == 0) {
+            return write_status;
+        }
+        // Balance the checksum for the writes that landed, even if a later one failed.
+        uint32_t updated = V93XX_CalibrationMath::UpdateChecksum(checksum.value, old_values, values, written);
+        V93XX_Status status = this->device.RegisterWriteWithRetry(DSP_CFG_CKSUM, updated);
+        if (status == V93XX_Status::Ok) {
+            Store(DSP_CFG_CKSUM, updated);
+        }
+        return (write_status != V93XX_Status::Ok) ? write_status : status;
+    }
+
+    /**
+     * @brief Read SYS_STS.CKERR.
+     */
+    V93XX_Status ChecksumOk(bool &ok) {
+        V93XX_Result<uint32_t> sys_sts = this->device.RegisterReadWithRetry(SYS_STS);
+        ok = sys_sts.Ok() && !(sys_sts.value & SYS_STS_CKERR);
+        return sys_sts.status;
+    }
+
+    /**
+     * @brief Calibration block as last read or written (DSP_CFG_CKSUM included).
+     */
+    const typename Device::CalibrationRegisters &Registers() const { return this->registers; }
+
+    /**
+     * @brief Current DSP_CFG_PHC step estimate (degrees per LSB), refined by each phase correction.
+     */
+    float PhaseStepEstimate() const { return this->phc_deg_per_lsb; }
+
+  private:
+    enum class Step : uint8_t {
+        Gain = 0,
+        GainAndPhase,
+        Offset,
+    };
+
+    static constexpr float kRadPerDeg = 3.14159265f / 180.0f;
+    static constexpr uint32_t kUpdateMask = SYS_INTSTS_AVGRMSUPD | SYS_INTSTS_AVGPWRUPD;
+
+    Device &device;
+    Config config;
+    typename Device::CalibrationRegisters registers = {};
+    float phc_deg_per_lsb = 0.01f;
+
+    bool ChannelB() const { return this->config.channel == Channel::B; }
+
+    uint32_t Stored(uint8_t address) const { return this->registers._array[address - Device::kCalibrationBase]; }
+
+    void Store(uint8_t address, uint32_t value) {
+        if (address >= Device::kCalibrationBase && address < Device::kCalibrationBase + Device::kCalibrationWords) {
+            this->registers._array[address - Device::kCalibrationBase] = value;
+        }
+    }
+
+    /**
+     * @brief Wait for the next averaged update, then read U, I, P and Q in one block read.
+     */
+    V93XX_Status ReadUpdate(float (&sample)[kQuantities]) {
+        // Drop an update that completed before this call, then wait for a fresh one. The bits are
+        // collected over several polls: a dispatcher (see ReadInterruptStatus()) may clear them.
+        // A stale bit left by a failed clear would pass an old update off as fresh, so the clear
+        // (write-1-to-clear, not retried by the driver) is repeated within the period timeout.
+        uint32_t start = millis();
+        while (true) {
+            V93XX_Status status = this->device.RegisterWriteWithRetry(SYS_INTSTS, kUpdateMask);
+            if (status == V93XX_Status::Ok) {
+                break;
+            }
+            if (status == V93XX_Status::NotReady || (millis() - start) >= this->config.period_timeout_ms) {
+                return status;
+            }
+            delay(1);
+        }
+        uint32_t seen = 0;
+        while (true) {
+            uint32_t sys_intsts = 0;
+            V93XX_Status status = this->device.ReadInterruptStatus(sys_intsts);
+            seen |= sys_intsts & kUpdateMask;
+            if (seen == kUpdateMask) {
+                break;
+            }
+            if (status == V93XX_Status::NotReady) {
+                return status;
+            }
+            if ((millis() - start) >= this->config.period_timeout_ms) {
+                return V93XX_Status::NoResponse;
+            }
+            delay(1);
+        }
+
+        const uint8_t view[kQuantities] = {
+            DSP_DAT_RMS1UA,
+            ChannelB() ? (uint8_t)DSP_DAT_RMS1IB : (uint8_t)DSP_DAT_RMS1IA,
+            ChannelB() ? (uint8_t)DSP_DAT_PB1 : (uint8_t)DSP_DAT_PA1,
+            ChannelB() ? (uint8_t)DSP_DAT_QB1 : (uint8_t)DSP_DAT_QA1,
+        };
+        uint32_t values[16] = {0};
+        V93XX_Status status = this->device.ConfigureBlockRead(view, kQuantities);
+        if (status == V93XX_Status::Ok) {
+            status = this->device.RegisterBlockReadWithRetry(values, kQuantities);
+        }
+        if (status != V93XX_Status::Ok) {
+            return status;
+        }
+        // RMS registers are unsigned, power registers two's complement.
+        sample[Voltage] = (float)values[0];
+        sample[Current] = (float)values[1];
+        sample[ActivePower] = (float)(int32_t)values[2];
+        sample[ReactivePower] = (float)(int32_t)values[3];
+        return V93XX_Status::Ok;
+    }
+
+    void Targets(const Reference &reference, float (&target)[kQuantities]) const {
+        float apparent = reference.voltage_rms * reference.current_rms * this->config.power_counts_per_watt;
+        target[Voltage] = reference.voltage_rms * this->config.voltage_counts_per_volt;
+        target[Current] = reference.current_rms * this->config.current_counts_per_amp;
+        target[ActivePower] = apparent * cosf(reference.phase_deg * kRadPerDeg);
+        target[ReactivePower] = apparent * sinf(reference.phase_deg * kRadPerDeg);
+    }
+
+    /**
+     * @brief Relative errors; powers relative to the target apparent power.
+     */
+    static void Errors(const float (&mean)[kQuantities], const float (&target)[kQuantities],
+                       float (&error)[kQuantities]) {
+        float apparent =
+            sqrtf(target[ActivePower] * target[ActivePower] + target[ReactivePower] * target[ReactivePower]);
+        for (uint8_t q = 0; q < kQuantities; q++) {
+            float scale = (q >= ActivePower) ? apparent : fabsf(target[q]);
+            error[q] = (scale > 0.0f) ? (mean[q] - target[q]) / scale : 0.0f;
+        }
+    }
+
+    Result Run(const Reference &reference, Step step) {
+        Result result = {};
+        float target[kQuantities];
+        Targets(reference, target);
+        const bool b = ChannelB();
+        const bool phase_step = step == Step::GainAndPhase && !b;
+
+        bool have_previous_phase = false;
+        float previous_angle = 0.0f;
+        int32_t previous_phc = 0;
+
+        for (uint8_t round = 0;; round++) {
+            Average average = Measure();
+            result.periods += average.periods;
+            if (average.status != V93XX_Status::Ok) {
+                result.status = average.status;
+                return result;
+            }
+            float error[kQuantities];
+            Errors(average.mean, target, error);
+            for (uint8_t q = 0; q < kQuantities; q++) {
+                if (round == 0) {
+                    result.error_before[q] = error[q];
+                }
+                result.error_after[q] = error[q];
+            }
+
+            // Power angle with the present P and Q ratios divided out, so that a P/Q gain mismatch
+            // (equalized by the first write) does not show up as phase error.
+            float gain_p = 1.0f + (float)((double)(int32_t)Stored(b ? DSP_CFG_CALI_PB : DSP_CFG_CALI_PA) /
+                                          V93XX_CalibrationMath::kQ31);
+            float gain_q = 1.0f + (float)((double)(int32_t)Stored(b ? DSP_CFG_CALI_QB : DSP_CFG_CALI_QA) /
+                                          V93XX_CalibrationMath::kQ31);
+            float angle = atan2f(average.mean[ReactivePower] / gain_q, average.mean[ActivePower] / gain_p) / kRadPerDeg;
+            float angle_error = angle - reference.phase_deg;
+
+            result.converged = true;
+            for (uint8_t q = 0; q < kQuantities; q++) {
+                bool targeted = (q != ReactivePower) || step != Step::Gain;
+                if (targeted && fabsf(error[q]) > this->config.tolerance) {
+                    result.converged = false;
+                }
+            }
+            if (phase_step && fabsf(angle_error) * kRadPerDeg > this->config.tolerance) {
+                result.converged = false;
+            }
+            if (result.converged || round >= this->config.max_iterations) {
+                break;
+            }
+
+            uint8_t addresses[6];
+            uint32_t values[6];
+            uint8_t count = 0;
+            if (step == Step::Offset) {
+                addresses[count] = DSP_CFG_RMS_DCUA;
+                values[count++] = V93XX_CalibrationMath::Offset(Stored(DSP_CFG_RMS_DCUA), average.mean[Voltage],
+                                                                target[Voltage]);
+                uint8_t rms_dc = b ? DSP_CFG_RMS_DCIB : DSP_CFG_RMS_DCIA;
+                addresses[count] = rms_dc;
+                values[count++] = V93XX_CalibrationMath::Offset(Stored(rms_dc), average.mean[Current], target[Current]);
+                uint8_t dc_p = b ? DSP_CFG_DC_PB : DSP_CFG_DC_PA;
+                addresses[count] = dc_p;
+                values[count++] =
+                    V93XX_CalibrationMath::Offset(Stored(dc_p), average.mean[ActivePower], target[ActivePower]);
+                uint8_t dc_q = b ? DSP_CFG_DC_QB : DSP_CFG_DC_QA;
+                addresses[count] = dc_q;
+                values[count++] =
+                    V93XX_CalibrationMath::Offset(Stored(dc_q), average.mean[ReactivePower], target[ReactivePower]);
+            } else {
+                addresses[count] = DSP_CFG_CALI_RMSUA;
+                values[count++] =
+                    V93XX_CalibrationMath::Gain(Stored(DSP_CFG_CALI_RMSUA), average.mean[Voltage], target[Voltage]);
+                uint8_t cali_i = b ? DSP_CFG_CALI_RMSIB : DSP_CFG_CALI_RMSIA;
+                addresses[count] = cali_i;
+                values[count++] = V93XX_CalibrationMath::Gain(Stored(cali_i), average.mean[Current], target[Current]);
+
+                // One ratio for P and Q: an angle error is PHC's to fix, not a P/Q gain mismatch.
+                uint32_t gain;
+                uint8_t cali_p = b ? DSP_CFG_CALI_PB : DSP_CFG_CALI_PA;
+                if (step == Step::Gain) {
+                    gain = V93XX_CalibrationMath::Gain(Stored(cali_p), average.mean[ActivePower], target[ActivePower]);
+                } else {
+                    // |S| is insensitive to the angle error being corrected at the same time.
+                    float measured_apparent = sqrtf(average.mean[ActivePower] * average.mean[ActivePower] +
+                                                    average.mean[ReactivePower] * average.mean[ReactivePower]);
+                    float target_apparent = sqrtf(target[ActivePower] * target[ActivePower] +
+                                                  target[ReactivePower] * target[ReactivePower]);
+                    gain = V93XX_CalibrationMath::Gain(Stored(cali_p), measured_apparent, target_apparent);
+                }
+                addresses[count] = cali_p;
+                values[count++] = gain;
+                addresses[count] = b ? DSP_CFG_CALI_QB : DSP_CFG_CALI_QA;
+                values[count++] = gain;
+
+                if (phase_step) {
+                    int32_t phc = (int32_t)Stored(DSP_CFG_PHC);
+                    // Secant refinement of the step from the previous correction's observed effect.
+                    if (have_previous_phase && phc != previous_phc) {
+                        float observed = (angle - previous_angle) / (float)(phc - previous_phc);
+                        float ratio = observed / this->phc_deg_per_lsb;
+                        if (ratio > 0.1f && ratio < 10.0f) {
+                            this->phc_deg_per_lsb = observed;
+                        }
+                    }
+                    have_previous_phase = true;
+                    previous_angle = angle;
+                    previous_phc = phc;
+                    if (fabsf(angle_error) * kRadPerDeg > this->config.tolerance && this->phc_deg_per_lsb != 0.0f) {
+                        addresses[count] = DSP_CFG_PHC;
+                        values[count++] = (uint32_t)V93XX_CalibrationMath::Saturate(
+                            (double)phc - (double)angle_error / (double)this->phc_deg_per_lsb);
+                    }
+                }
+            }
+
+            // Drop corrections below one LSB; with none left the step is at its resolution limit.
+            uint8_t changed = 0;
+            for (uint8_t i = 0; i < count; i++) {
+                if (values[i] != Stored(addresses[i])) {
+                    addresses[changed] = addresses[i];
+                    values[changed++] = values[i];
+                }
+            }
+            if (changed == 0) {
+                result.converged = true;
+                break;
+            }
+            result.status = WriteRegisters(addresses, values, changed);
+            if (result.status != V93XX_Status::Ok) {
+                return result;
+            }
+            result.iterations++;
+        }
+
+        bool checksum_ok = false;
+        result.status = ChecksumOk(checksum_ok);
+        if (result.status == V93XX_Status::Ok && !checksum_ok) {
+            result.status = V93XX_Status::VerifyMismatch;
+        }
+        return result;
+    }
+};
+
+#endif
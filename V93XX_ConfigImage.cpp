@@ -0,0 +1,271 @@
+#include "V93XX_ConfigImage.h"
+#include "V93XX_RegisterMap.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <Preferences.h>
+#endif
+
+bool V93XX_ConfigImage::InChecksumSet(uint8_t address) { return V93XX_RegisterMap::InChecksumSet(address); }
+
+uint32_t V93XX_ConfigImage::Crc32(const uint8_t *data, size_t length, uint32_t crc) {
+    // Nibble-table CRC-32 (reflected 0xEDB88320): 64 bytes of table, same result as zlib.crc32().
+    static const uint32_t kTable[16] = {
+        0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL, 0x76DC4190UL, 0x6B6B51F4UL,
+        0x4DB26158UL, 0x5005713CUL, 0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+        0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL,
+    };
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ kTable[crc & 0x0F];
+        crc = (crc >> 4) ^ kTable[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+uint32_t V93XX_ConfigImage::ComputeChecksum(const uint8_t *ranges, uint8_t range_count) {
+    return V93XX_RegisterMap::ConfigurationChecksum([ranges, range_count](uint8_t address) -> uint32_t {
+        // Later ranges win, as they do when the image is loaded.
+        uint32_t value = 0;
+        const uint8_t *cursor = ranges;
+        for (uint8_t range = 0; range < range_count; range++) {
+            uint8_t start = cursor[0];
+            uint8_t count = cursor[1];
+            cursor += kRangeHeaderSize;
+            if (start <= address && address < start + count) {
+                value = ReadLe32(cursor + 4 * (address - start));
+            }
+            cursor += 4 * (size_t)count;
+        }
+        return value;
+    });
+}
+
+V93XX_ConfigImage::Status V93XX_ConfigImage::Parse(const uint8_t *data, size_t length) {
+    this->data = nullptr;
+    this->length = 0;
+    if (!data || length < kHeaderSize + kTrailerSize) {
+        return Status::TooShort;
+    }
+    if (ReadLe32(data) != kMagic) {
+        return Status::BadMagic;
+    }
+    if ((uint16_t)(data[4] | (data[5] << 8)) != kFormatVersion) {
+        return Status::UnsupportedVersion;
+    }
+
+    uint16_t revision = (uint16_t)(data[6] | (data[7] << 8));
+    uint32_t cfg_checksum = ReadLe32(data + 8);
+    uint16_t word_count = (uint16_t)(data[12] | (data[13] << 8));
+    uint8_t range_count = data[14];
+
+    // Walk the ranges once for layout, then CRC, then the configuration checksum.
+    size_t offset = kHeaderSize;
+    uint16_t words = 0;
+    for (uint8_t range = 0; range < range_count; range++) {
+        if (offset + kRangeHeaderSize > length - kTrailerSize) {
+            return Status::BadLayout;
+        }
+        uint8_t start = data[offset];
+        uint8_t count = data[offset + 1];
+        offset += kRangeHeaderSize;
+        if (count == 0 || (uint16_t)start + count > V93XX_RegisterMap::kRegisterCount ||
+            offset + 4 * (size_t)count > length - kTrailerSize) {
+            return Status::BadLayout;
+        }
+        offset += 4 * (size_t)count;
+        words += count;
+    }
+    if (words != word_count || offset + kTrailerSize != length) {
+        return Status::BadLayout;
+    }
+    if (Crc32(data, offset) != ReadLe32(data + offset)) {
+        return Status::BadCrc;
+    }
+    if (ComputeChecksum(data + kHeaderSize, range_count) != cfg_checksum) {
+        return Status::BadChecksum;
+    }
+
+    this->data = data;
+    this->length = length;
+    this->revision = revision;
+    this->cfg_checksum = cfg_checksum;
+    this->word_count = word_count;
+    this->range_count = range_count;
+    return Status::Ok;
+}
+
+bool V93XX_ConfigImage::Find(uint8_t address, uint32_t &value) const {
+    bool found = false;
+    ForEach([&](uint8_t register_address, uint32_t register_value) {
+        if (register_address == address) {
+            value = register_value;
+            found = true;
+        }
+    });
+    return found;
+}
+
+V93XX_ConfigImageBuilder::V93XX_ConfigImageBuilder(uint8_t *buffer, size_t capacity, uint16_t revision)
+    : buffer(buffer), capacity(capacity), used(V93XX_ConfigImage::kHeaderSize) {
+    if (!buffer || capacity < V93XX_ConfigImage::kHeaderSize + V93XX_ConfigImage::kTrailerSize) {
+        this->overflow = true;
+        return;
+    }
+    memset(buffer, 0, V93XX_ConfigImage::kHeaderSize);
+    WriteLe32(buffer, V93XX_ConfigImage::kMagic);
+    WriteLe16(buffer + 4, V93XX_ConfigImage::kFormatVersion);
+    WriteLe16(buffer + 6, revision);
+}
+
+bool V93XX_ConfigImageBuilder::AddRange(uint8_t start_address, const uint32_t *values, uint8_t count) {
+    if (this->overflow || !values || count == 0 ||
+        (uint16_t)start_address + count > V93XX_RegisterMap::kRegisterCount || this->range_count == UINT8_MAX) {
+        this->overflow = true;
+        return false;
+    }
+    size_t needed = V93XX_ConfigImage::kRangeHeaderSize + 4 * (size_t)count;
+    if (this->used + needed + V93XX_ConfigImage::kTrailerSize > this->capacity) {
+        this->overflow = true;
+        return false;
+    }
+
+    uint8_t *cursor = this->buffer + this->used;
+    cursor[0] = start_address;
+    cursor[1] = count;
+    cursor[2] = 0;
+    cursor[3] = 0;
+    cursor += V93XX_ConfigImage::kRangeHeaderSize;
+    for (uint8_t i = 0; i < count; i++) {
+        WriteLe32(cursor + 4 * i, values[i]);
+    }
+
+    this->used += needed;
+    this->word_count += count;
+    this->range_count++;
+    return true;
+}
+
+size_t V93XX_ConfigImageBuilder::Finish() {
+    if (this->overflow) {
+        return 0;
+    }
+
+    const uint32_t cfg_checksum =
+        V93XX_ConfigImage::ComputeChecksum(this->buffer + V93XX_ConfigImage::kHeaderSize, this->range_count);
+
+    // Keep an embedded DSP_CFG_CKSUM slot consistent with the header.
+    size_t offset = V93XX_ConfigImage::kHeaderSize;
+    for (uint8_t range = 0; range < this->range_count; range++) {
+        uint8_t start = this->buffer[offset];
+        uint8_t count = this->buffer[offset + 1];
+        offset += V93XX_ConfigImage::kRangeHeaderSize;
+        if (start <= DSP_CFG_CKSUM && DSP_CFG_CKSUM < start + count) {
+            WriteLe32(this->buffer + offset + 4 * (DSP_CFG_CKSUM - start), cfg_checksum);
+        }
+        offset += 4 * (size_t)count;
+    }
+
+    WriteLe32(this->buffer + 8, cfg_checksum);
+    WriteLe16(this->buffer + 12, this->word_count);
+    this->buffer[14] = this->range_count;
+    WriteLe32(this->buffer + this->used, V93XX_ConfigImage::Crc32(this->buffer, this->used));
+    return this->used + V93XX_ConfigImage::kTrailerSize;
+}
+
+void V93XX_ConfigImageBuilder::WriteLe16(uint8_t *dst, uint16_t value) {
+    dst[0] = (uint8_t)(value & 0xFF);
+    dst[1] = (uint8_t)(value >> 8);
+}
+
+void V93XX_ConfigImageBuilder::WriteLe32(uint8_t *dst, uint32_t value) {
+    dst[0] = (uint8_t)(value & 0xFF);
+    dst[1] = (uint8_t)((value >> 8) & 0xFF);
+    dst[2] = (uint8_t)((value >> 16) & 0xFF);
+    dst[3] = (uint8_t)((value >> 24) & 0xFF);
+}
+
+bool V93XX_FileConfigStore::BuildPath(char *path, size_t path_size, const char *key, const char *suffix) const {
+    if (!key || !this->directory) {
+        return false;
+    }
+    int written = snprintf(path, path_size, "%s/%s%s", this->directory, key, suffix);
+    return written > 0 && (size_t)written < path_size;
+}
+
+size_t V93XX_FileConfigStore::Load(const char *key, uint8_t *buffer, size_t capacity) {
+    char path[128];
+    if (!buffer || !BuildPath(path, sizeof(path), key, ".bin")) {
+        return 0;
+    }
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return 0;
+    }
+    size_t length = fread(buffer, 1, capacity, file);
+    // One extra byte means the stored image does not fit.
+    uint8_t extra;
+    bool truncated = fread(&extra, 1, 1, file) == 1;
+    fclose(file);
+    return truncated ? 0 : length;
+}
+
+bool V93XX_FileConfigStore::Save(const char *key, const uint8_t *data, size_t length) {
+    char path[128];
+    char temp_path[128];
+    if (!data || !BuildPath(path, sizeof(path), key, ".bin") ||
+        !BuildPath(temp_path, sizeof(temp_path), key, ".tmp")) {
+        return false;
+    }
+    FILE *file = fopen(temp_path, "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = fwrite(data, 1, length, file) == length;
+    ok = (fflush(file) == 0) && ok;
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        remove(temp_path);
+        return false;
+    }
+    // rename() over an existing file is not atomic on every VFS (SPIFFS/FAT); drop the old one first there.
+    if (rename(temp_path, path) != 0) {
+        remove(path);
+        if (rename(temp_path, path) != 0) {
+            remove(temp_path);
+            return false;
+        }
+    }
+    return true;
+}
+
+#if defined(ARDUINO_ARCH_ESP32)
+size_t V93XX_NvsConfigStore::Load(const char *key, uint8_t *buffer, size_t capacity) {
+    Preferences preferences;
+    if (!buffer || !preferences.begin(this->nvs_namespace, true)) {
+        return 0;
+    }
+    size_t length = preferences.getBytesLength(key);
+    if (length == 0 || length > capacity) {
+        preferences.end();
+        return 0;
+    }
+    length = preferences.getBytes(key, buffer, length);
+    preferences.end();
+    return length;
+}
+
+bool V93XX_NvsConfigStore::Save(const char *key, const uint8_t *data, size_t length) {
+    Preferences preferences;
+    if (!data || !preferences.begin(this->nvs_namespace, false)) {
+        return false;
+    }
+    // NVS commits blobs atomically: a reset mid-write keeps the previous value.
+    bool ok = preferences.putBytes(key, data, length) == length;
+    preferences.end();
+    return ok;
+}
+#endif
@@ -0,0 +1,247 @@
+#ifndef V93XX_CONFIGIMAGE_H__
+#define V93XX_CONFIGIMAGE_H__
+
+#include "V93XX_Registers.h"
+#include "V93XX_Status.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Read-only view over a versioned binary configuration image.
+ *
+ * Layout (all fields little-endian, no alignment requirements):
+ *
+ *   Header (16 bytes)
+ *     uint32 magic           "V93C" (0x43333956)
+ *     uint16 format_version  kFormatVersion
+ *     uint16 revision        Free for the application (calibration revision, unit id, ...)
+ *     uint32 cfg_checksum    DSP_CFG_CKSUM value for this image
+ *     uint16 word_count      Total register words over all ranges
+ *     uint8  range_count
+ *     uint8  reserved        0
+ *   Ranges (range_count times)
+ *     uint8  start_address
+ *     uint8  count           Consecutive registers starting at start_address
+ *     uint16 reserved        0
+ *     uint32 values[count]
+ *   Trailer
+ *     uint32 crc32           IEEE CRC-32 (zlib) of every preceding byte
+ *
+ * The view never copies: Parse() validates the buffer in place (flash, rodata or a RAM buffer
+ * filled from a V93XX_ConfigStore) and ForEach() streams register/value pairs straight from it.
+ * cfg_checksum covers the checksum set {0x00-0x07, 0x25-0x3A, 0x55-0x60}, computed by the same
+ * V93XX_RegisterMap::ConfigurationChecksum() as V93XX<>::ConfigurationChecksum(); registers of that
+ * set missing from the image are assumed to hold 0.
+ */
+class V93XX_ConfigImage {
+  public:
+    static constexpr uint32_t kMagic = 0x43333956UL;
+    static constexpr uint16_t kFormatVersion = 1;
+    static constexpr size_t kHeaderSize = 16;
+    static constexpr size_t kRangeHeaderSize = 4;
+    static constexpr size_t kTrailerSize = 4;
+
+    enum class Status : uint8_t {
+        Ok = 0,
+        TooShort,
+        BadMagic,
+        UnsupportedVersion,
+        BadLayout,
+        BadCrc,
+        BadChecksum,
+    };
+
+    Status Parse(const uint8_t *data, size_t length);
+
+    bool Valid() const { return this->data != nullptr; }
+    uint16_t Revision() const { return this->revision; }
+    uint32_t ConfigChecksum() const { return this->cfg_checksum; }
+    uint16_t WordCount() const { return this->word_count; }
+    uint8_t RangeCount() const { return this->range_count; }
+    size_t Size() const { return this->length; }
+
+    /**
+     * @brief Look up the image's value for @p address.
+     */
+    bool Find(uint8_t address, uint32_t &value) const;
+
+    /**
+     * @brief Call visit(address, value) for every register in image order.
+     */
+    template <typename Visitor> void ForEach(Visitor &&visit) const {
+        if (!this->data) {
+            return;
+        }
+        const uint8_t *cursor = this->data + kHeaderSize;
+        for (uint8_t range = 0; range < this->range_count; range++) {
+            uint8_t start = cursor[0];
+            uint8_t count = cursor[1];
+            cursor += kRangeHeaderSize;
+            for (uint8_t i = 0; i < count; i++) {
+                visit((uint8_t)(start + i), ReadLe32(cursor));
+                cursor += 4;
+            }
+        }
+    }
+
+    static bool InChecksumSet(uint8_t address);
+    static uint32_t Crc32(const uint8_t *data, size_t length, uint32_t crc = 0);
+    static uint32_t ReadLe32(const uint8_t *src) {
+        return (uint32_t)src[0] | ((uint32_t)src[1] << 8) | ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+    }
+
+    /**
+     * @brief DSP_CFG_CKSUM for the @p range_count ranges at @p ranges (layout already checked).
+     */
+    static uint32_t ComputeChecksum(const uint8_t *ranges, uint8_t range_count);
+
+  private:
+    const uint8_t *data = nullptr;
+    size_t length = 0;
+    uint16_t revision = 0;
+    uint32_t cfg_checksum = 0;
+    uint16_t word_count = 0;
+    uint8_t range_count = 0;
+};
+
+/**
+ * @brief Serializes register ranges into a caller-provided buffer.
+ *
+ * DSP_CFG_CKSUM is computed by Finish(); if the image contains 0x38 its slot is overwritten
+ * with the computed value.
+ */
+class V93XX_ConfigImageBuilder {
+  public:
+    V93XX_ConfigImageBuilder(uint8_t *buffer, size_t capacity, uint16_t revision = 0);
+
+    bool AddRange(uint8_t start_address, const uint32_t *values, uint8_t count);
+
+    /**
+     * @brief Add the driver register structs (ControlRegisters, CalibrationRegisters) and thresholds 0x55-0x60.
+     * @param thresholds 12 words for DSP_OV_THL..FD_IB_LCTH, or nullptr to leave them out
+     */
+    template <typename Control, typename Calibration>
+    bool AddConfiguration(const Control &ctrl, const Calibration &calibrations, const uint32_t *thresholds) {
+        // The register structs are packed: copy out instead of passing possibly unaligned pointers.
+        uint32_t words[sizeof(calibrations._array) / sizeof(uint32_t)];
+        const uint8_t ctrl_words = sizeof(ctrl._array) / sizeof(uint32_t);
+        const uint8_t calibration_words = sizeof(calibrations._array) / sizeof(uint32_t);
+        static_assert(ctrl_words <= calibration_words, "control block larger than scratch buffer");
+
+        for (uint8_t i = 0; i < ctrl_words; i++) {
+            words[i] = ctrl._array[i];
+        }
+        bool ok = AddRange(DSP_ANA0, words, ctrl_words);
+        for (uint8_t i = 0; i < calibration_words; i++) {
+            words[i] = calibrations._array[i];
+        }
+        ok = ok && AddRange(DSP_CFG_CALI_PA, words, calibration_words);
+        if (thresholds) {
+            ok = ok && AddRange(DSP_OV_THL, thresholds, FD_IB_LCTH - DSP_OV_THL + 1);
+        }
+        return ok;
+    }
+
+    /**
+     * @brief Write the checksum and CRC.
+     * @return Image size in bytes, or 0 if the buffer overflowed.
+     */
+    size_t Finish();
+
+  private:
+    uint8_t *buffer;
+    size_t capacity;
+    size_t used;
+    uint16_t word_count = 0;
+    uint8_t range_count = 0;
+    bool overflow = false;
+
+    static void WriteLe16(uint8_t *dst, uint16_t value);
+    static void WriteLe32(uint8_t *dst, uint32_t value);
+};
+
+/**
+ * @brief Write an image through a driver's RegisterWriteWithRetry(), DSP_CFG_CKSUM last.
+ *
+ * Stops at the first write that still fails after retries and returns its status; DSP_CFG_CKSUM is
+ * only written once every other register landed, so a partial load never looks complete.
+ */
+template <typename Device> V93XX_Status V93XX_LoadImage(Device &device, const V93XX_ConfigImage &image) {
+    V93XX_Status status = V93XX_Status::Ok;
+    image.ForEach([&device, &status](uint8_t address, uint32_t value) {
+        if (status == V93XX_Status::Ok && address != DSP_CFG_CKSUM) {
+            status = device.RegisterWriteWithRetry(address, value);
+        }
+    });
+    if (status != V93XX_Status::Ok) {
+        return status;
+    }
+    return device.RegisterWriteWithRetry(DSP_CFG_CKSUM, image.ConfigChecksum());
+}
+
+/**
+ * @brief True if the chip reports no checksum error and holds the image's DSP_CFG_CKSUM.
+ *
+ * Both reads need a valid frame checksum, in either ChecksumMode.
+ */
+template <typename Device> bool V93XX_VerifyImage(Device &device, const V93XX_ConfigImage &image) {
+    uint32_t sys_sts = 0;
+    uint32_t cfg_checksum = 0;
+    if (!device.RegisterReadStrict(SYS_STS, sys_sts) || !device.RegisterReadStrict(DSP_CFG_CKSUM, cfg_checksum)) {
+        return false;
+    }
+    return !(sys_sts & SYS_STS_CKERR) && cfg_checksum == image.ConfigChecksum();
+}
+
+/**
+ * @brief Pluggable persistent storage for configuration images.
+ */
+class V93XX_ConfigStore {
+  public:
+    virtual ~V93XX_ConfigStore() {}
+
+    /**
+     * @brief Read the image stored under @p key into @p buffer.
+     * @return Bytes read, or 0 if missing or larger than @p capacity
+     */
+    virtual size_t Load(const char *key, uint8_t *buffer, size_t capacity) = 0;
+
+    virtual bool Save(const char *key, const uint8_t *data, size_t length) = 0;
+};
+
+/**
+ * @brief Stores each image as "<directory>/<key>.bin" through stdio.
+ *
+ * On the host this is a plain file; on ESP32 point it at a mounted VFS such as "/littlefs".
+ * Save() writes a temporary file and renames it so a power cut never leaves a torn image.
+ */
+class V93XX_FileConfigStore : public V93XX_ConfigStore {
+  public:
+    explicit V93XX_FileConfigStore(const char *directory) : directory(directory) {}
+
+    size_t Load(const char *key, uint8_t *buffer, size_t capacity) override;
+    bool Save(const char *key, const uint8_t *data, size_t length) override;
+
+  private:
+    const char *directory;
+
+    bool BuildPath(char *path, size_t path_size, const char *key, const char *suffix) const;
+};
+
+#if defined(ARDUINO_ARCH_ESP32)
+/**
+ * @brief Stores each image as an NVS blob (Preferences) in the given namespace.
+ */
+class V93XX_NvsConfigStore : public V93XX_ConfigStore {
+  public:
+    explicit V93XX_NvsConfigStore(const char *nvs_namespace) : nvs_namespace(nvs_namespace) {}
+
+    size_t Load(const char *key, uint8_t *buffer, size_t capacity) override;
+    bool Save(const char *key, const uint8_t *data, size_t length) override;
+
+  private:
+    const char *nvs_namespace;
+};
+#endif
+
+#endif
@@ -0,0 +1,113 @@
+#include "V93XX_DmaReceiver.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <string.h>
+
+bool V93XX_DmaReceiver::Begin(spi_host_device_t host, const Config &config, V93XX_DmaParser &parser) {
+    if (this->running || config.buffer_bytes == 0 || (config.buffer_bytes % 4) != 0) {
+        return false;
+    }
+    this->host = host;
+    this->parser = &parser;
+    this->buffer_bytes = config.buffer_bytes;
+    this->counters = Counters();
+
+    for (uint8_t i = 0; i < kBuffers; i++) {
+        this->buffers[i] = (uint8_t *)heap_caps_malloc(this->buffer_bytes, MALLOC_CAP_DMA);
+        if (!this->buffers[i]) {
+            FreeBuffers();
+            return false;
+        }
+    }
+
+    spi_bus_config_t bus = {};
+    bus.mosi_io_num = config.data_pin;
+    bus.miso_io_num = -1;
+    bus.sclk_io_num = config.sclk_pin;
+    bus.quadwp_io_num = -1;
+    bus.quadhd_io_num = -1;
+    bus.max_transfer_sz = this->buffer_bytes;
+
+    spi_slave_interface_config_t slave = {};
+    slave.spics_io_num = config.cs_pin;
+    slave.flags = 0;
+    slave.queue_size = kBuffers;
+    slave.mode = V93XX_DmaFormat::SpiMode(config.ctrl5);
+
+    if (spi_slave_initialize(this->host, &bus, &slave, SPI_DMA_CH_AUTO) != ESP_OK) {
+        FreeBuffers();
+        return false;
+    }
+
+    // Both buffers are queued up front; the task requeues each one as soon as it is parsed.
+    for (uint8_t i = 0; i < kBuffers; i++) {
+        memset(&this->transactions[i], 0, sizeof(this->transactions[i]));
+        this->transactions[i].length = (size_t)this->buffer_bytes * 8;
+        this->transactions[i].rx_buffer = this->buffers[i];
+        this->transactions[i].user = (void *)(uintptr_t)i;
+        spi_slave_queue_trans(this->host, &this->transactions[i], portMAX_DELAY);
+    }
+
+    this->running = true;
+    this->task_done = false;
+    BaseType_t core = (config.core < 0) ? tskNO_AFFINITY : (BaseType_t)config.core;
+    if (xTaskCreatePinnedToCore(TaskEntry, "v93xx_dma", config.stack_bytes, this, config.priority, &this->task,
+                                core) != pdPASS) {
+        this->running = false;
+        this->task_done = true;
+        spi_slave_free(this->host);
+        FreeBuffers();
+        return false;
+    }
+    return true;
+}
+
+void V93XX_DmaReceiver::End() {
+    if (!this->running) {
+        return;
+    }
+    this->running = false;
+    while (!this->task_done) {
+        delay(1);
+    }
+    this->task = nullptr;
+    spi_slave_free(this->host);
+    FreeBuffers();
+}
+
+void V93XX_DmaReceiver::FreeBuffers() {
+    for (uint8_t i = 0; i < kBuffers; i++) {
+        if (this->buffers[i]) {
+            heap_caps_free(this->buffers[i]);
+            this->buffers[i] = nullptr;
+        }
+    }
+}
+
+void V93XX_DmaReceiver::TaskEntry(void *context) {
+    V93XX_DmaReceiver *self = static_cast<V93XX_DmaReceiver *>(context);
+    while (self->running) {
+        spi_slave_transaction_t *done = nullptr;
+        // Short timeout so End() is noticed while the chip is not uploading.
+        if (spi_slave_get_trans_result(self->host, &done, pdMS_TO_TICKS(10)) != ESP_OK || !done) {
+            continue;
+        }
+        size_t received = done->trans_len / 8;
+        self->parser->Push(static_cast<const uint8_t *>(done->rx_buffer), received);
+        self->counters.transfers++;
+        self->counters.bytes += received;
+        // The next transfer starts at chip select, on a packet boundary.
+        self->parser->Restart();
+        if (received < self->buffer_bytes) {
+            self->counters.short_transfers++;
+        } else {
+            self->counters.possible_overruns++;
+        }
+        spi_slave_queue_trans(self->host, done, portMAX_DELAY);
+    }
+    self->task_done = true;
+    vTaskDelete(nullptr);
+}
+#endif
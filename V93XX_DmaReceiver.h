@@ -0,0 +1,78 @@
+#ifndef V93XX_DMARECEIVER_H__
+#define V93XX_DMARECEIVER_H__
+
+#include "V93XX_DmaStream.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include <driver/spi_slave.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+/**
+ * @brief ESP32 SPI slave receiver for the chip's active waveform upload (DSP_CTRL5 DMAEN).
+ *
+ * In upload mode the chip drives SCLK, chip select and data; the ESP32 SPI host runs as a slave
+ * with DMA into two buffers. While the peripheral fills one, a task hands the other to a
+ * V93XX_DmaParser and queues it again, so reception never waits for parsing. Every transfer
+ * starts at chip select, so packet alignment restarts after each one. A transfer that fills its
+ * buffer may have been cut off while the chip was still clocking; the rest of that burst is lost
+ * and counted as a possible overrun (use a buffer_bytes larger than one chip-select burst).
+ *
+ * Register access stays on UART: the chip's SPI pins carry the upload. Enable the upload with
+ * DSP_CTRL5 (DMAEN, DMAMODE, wave channels, optional SP_CHECK) after Begin().
+ */
+class V93XX_DmaReceiver {
+  public:
+    static constexpr uint8_t kBuffers = 2;
+
+    struct Config {
+        int sclk_pin;
+        int data_pin; // Chip's data output, received on the slave's MOSI
+        int cs_pin;
+        uint32_t ctrl5;               // DSP_CTRL5 value the chip runs with (SPI mode)
+        uint16_t buffer_bytes = 1024; // Per DMA buffer, multiple of 4
+        uint32_t stack_bytes = 4096;
+        uint8_t priority = 5; // Above acquisition tasks: a late requeue loses upload data
+        int8_t core = 1;      // -1 = no affinity
+    };
+
+    struct Counters {
+        uint32_t transfers = 0;         // Completed DMA buffers
+        uint32_t short_transfers = 0;   // Transfers ended by chip select
+        uint32_t possible_overruns = 0; // Transfers that filled their buffer (the burst may have been cut)
+        uint32_t bytes = 0;
+    };
+
+    ~V93XX_DmaReceiver() { End(); }
+
+    /**
+     * @brief Initialize @p host as a DMA SPI slave and start the receive task.
+     * @param parser Begun with V93XX_DmaFormat::FromCtrl5(config.ctrl5); fed only from the receive task
+     */
+    bool Begin(spi_host_device_t host, const Config &config, V93XX_DmaParser &parser);
+
+    /**
+     * @brief Stop the task, release the peripheral and the DMA buffers.
+     */
+    void End();
+
+    bool Running() const { return this->running; }
+    const Counters &Stats() const { return this->counters; }
+
+  private:
+    spi_host_device_t host = SPI2_HOST;
+    V93XX_DmaParser *parser = nullptr;
+    uint8_t *buffers[kBuffers] = {nullptr};
+    spi_slave_transaction_t transactions[kBuffers] = {};
+    uint16_t buffer_bytes = 0;
+    TaskHandle_t task = nullptr;
+    volatile bool running = false;
+    volatile bool task_done = true;
+    Counters counters;
+
+    void FreeBuffers();
+    static void TaskEntry(void *context);
+};
+#endif
+
+#endif
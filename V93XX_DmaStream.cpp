@@ -0,0 +1,154 @@
+#include "V93XX_DmaStream.h"
+
+#include "V93XX_Frames.h"
+#include "V93XX_Registers.h"
+#include <string.h>
+
+V93XX_DmaFormat V93XX_DmaFormat::FromCtrl5(uint32_t ctrl5, uint8_t sample_bytes) {
+    V93XX_DmaFormat format = {};
+    if (ctrl5 & DSP_CTRL5_WAVE_U) {
+        format.channels[format.channel_count++] = V93XX_DmaChannel::U;
+    }
+    if (ctrl5 & DSP_CTRL5_WAVE_IA) {
+        format.channels[format.channel_count++] = V93XX_DmaChannel::IA;
+    }
+    if (ctrl5 & DSP_CTRL5_WVAE_IB) {
+        format.channels[format.channel_count++] = V93XX_DmaChannel::IB;
+    }
+    format.sample_bytes = sample_bytes;
+    format.check = (ctrl5 & DSP_CTRL5_SP_CHECK) != 0;
+    return format;
+}
+
+uint8_t V93XX_DmaFormat::SpiMode(uint32_t ctrl5) {
+    return (uint8_t)(((ctrl5 & DSP_CTRL5_SPI_POL) ? 2 : 0) | ((ctrl5 & DSP_CTRL5_SPI_PHA) ? 1 : 0));
+}
+
+bool V93XX_DmaRing::Begin(V93XX_DmaSample *storage, size_t capacity) {
+    const bool valid = storage && capacity != 0 && capacity <= 0x80000000UL && (capacity & (capacity - 1)) == 0;
+    this->storage = valid ? storage : nullptr;
+    this->capacity = valid ? (uint32_t)capacity : 0;
+    this->head.store(0, std::memory_order_relaxed);
+    this->tail.store(0, std::memory_order_relaxed);
+    this->dropped.store(0, std::memory_order_relaxed);
+    return valid;
+}
+
+bool V93XX_DmaRing::Push(const V93XX_DmaSample &sample) {
+    uint32_t head = this->head.load(std::memory_order_relaxed);
+    uint32_t tail = this->tail.load(std::memory_order_acquire);
+    if (this->capacity == 0 || head - tail >= this->capacity) {
+        this->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    this->storage[head & (this->capacity - 1)] = sample;
+    this->head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+size_t V93XX_DmaRing::Read(V93XX_DmaSample *out, size_t max_count) {
+    uint32_t tail = this->tail.load(std::memory_order_relaxed);
+    uint32_t head = this->head.load(std::memory_order_acquire);
+    size_t count = head - tail;
+    if (count > max_count) {
+        count = max_count;
+    }
+    for (size_t i = 0; i < count; i++) {
+        out[i] = this->storage[(tail + (uint32_t)i) & (this->capacity - 1)];
+    }
+    this->tail.store(tail + (uint32_t)count, std::memory_order_release);
+    return count;
+}
+
+size_t V93XX_DmaRing::Available() const {
+    return this->head.load(std::memory_order_acquire) - this->tail.load(std::memory_order_relaxed);
+}
+
+bool V93XX_DmaParser::Begin(const V93XX_DmaFormat &format, V93XX_DmaRing *ring) {
+    if (!format.Valid() || !ring) {
+        this->ring = nullptr;
+        return false;
+    }
+    this->format = format;
+    this->ring = ring;
+    this->packet_bytes = format.PacketBytes();
+    this->fill = 0;
+    // Without a check byte there is nothing to hunt with: trust the transfer alignment.
+    this->locked = !format.check;
+    this->good_run = 0;
+    this->counters = Counters();
+    return true;
+}
+
+size_t V93XX_DmaParser::Push(const uint8_t *data, size_t length) {
+    if (!this->ring) {
+        return 0;
+    }
+    size_t delivered = 0;
+    for (size_t i = 0; i < length; i++) {
+        this->pending[this->fill++] = data[i];
+        if (this->fill == this->packet_bytes && ProcessPacket()) {
+            delivered++;
+        }
+    }
+    return delivered;
+}
+
+void V93XX_DmaParser::Restart() {
+    this->counters.discarded_bytes += this->fill;
+    this->fill = 0;
+}
+
+bool V93XX_DmaParser::ProcessPacket() {
+    if (!this->format.check) {
+        Deliver();
+        this->fill = 0;
+        return true;
+    }
+
+    V93XX_Frames::RunningChecksum checksum;
+    for (uint8_t i = 0; i + 1 < this->packet_bytes; i++) {
+        checksum.Add(this->pending[i]);
+    }
+    if (checksum.Matches(this->pending[this->packet_bytes - 1])) {
+        this->fill = 0;
+        if (this->locked) {
+            Deliver();
+            return true;
+        }
+        // Hunting: hold off until enough consecutive packets agree on the boundary.
+        this->counters.discarded_bytes += this->packet_bytes;
+        if (++this->good_run >= kLockPackets) {
+            this->locked = true;
+            this->counters.resyncs++;
+        }
+        return false;
+    }
+
+    if (this->locked) {
+        this->counters.check_errors++;
+        this->locked = false;
+    }
+    this->good_run = 0;
+    // Slide the window by one byte and keep hunting.
+    memmove(this->pending, this->pending + 1, (size_t)this->packet_bytes - 1);
+    this->fill = (uint8_t)(this->packet_bytes - 1);
+    this->counters.discarded_bytes++;
+    return false;
+}
+
+void V93XX_DmaParser::Deliver() {
+    V93XX_DmaSample sample = {};
+    sample.index = this->counters.packets++;
+    const uint8_t *cursor = this->pending;
+    for (uint8_t ch = 0; ch < this->format.channel_count; ch++) {
+        uint32_t raw = 0;
+        for (uint8_t b = 0; b < this->format.sample_bytes; b++) {
+            raw = (raw << 8) | *cursor++;
+        }
+        // Sign-extend from sample_bytes * 8 bits.
+        const uint8_t shift = (uint8_t)(32 - 8 * this->format.sample_bytes);
+        sample.values[(size_t)this->format.channels[ch]] = (int32_t)(raw << shift) >> shift;
+    }
+    this->ring->Push(sample);
+}
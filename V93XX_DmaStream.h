@@ -0,0 +1,148 @@
+#ifndef V93XX_DMASTREAM_H__
+#define V93XX_DMASTREAM_H__
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Waveform channels the chip can upload (DSP_CTRL5 WAVE_U / WAVE_IA / WVAE_IB).
+ */
+enum class V93XX_DmaChannel : uint8_t {
+    U = 0,
+    IA,
+    IB,
+};
+
+constexpr size_t kV93XX_DmaChannelCount = (size_t)V93XX_DmaChannel::IB + 1;
+
+/**
+ * @brief Packet layout of the active waveform upload (DSP_CTRL5 DMAEN).
+ *
+ * One packet holds one sample of every enabled channel, in U, IA, IB order, each sample_bytes wide
+ * and MSB first (SPI bit order). With SP_CHECK set the chip appends one check byte per packet,
+ * using the register frames' checksum: 0x33 + ~(sum of the packet's sample bytes).
+ */
+struct V93XX_DmaFormat {
+    uint8_t channel_count;                             // 1-3
+    V93XX_DmaChannel channels[kV93XX_DmaChannelCount]; // Stream order
+    uint8_t sample_bytes;                              // 2-4
+    bool check;                                        // SP_CHECK
+
+    uint8_t PacketBytes() const { return (uint8_t)(this->channel_count * this->sample_bytes + (this->check ? 1 : 0)); }
+    bool Valid() const {
+        return this->channel_count >= 1 && this->channel_count <= kV93XX_DmaChannelCount && this->sample_bytes >= 2 &&
+               this->sample_bytes <= 4;
+    }
+
+    /**
+     * @brief Layout implied by a DSP_CTRL5 value (enabled wave channels and SP_CHECK).
+     */
+    static V93XX_DmaFormat FromCtrl5(uint32_t ctrl5, uint8_t sample_bytes = 2);
+
+    /**
+     * @brief SPI mode (0-3) matching DSP_CTRL5 SPI_POL / SPI_PHA, for the receiving peripheral.
+     */
+    static uint8_t SpiMode(uint32_t ctrl5);
+};
+
+/**
+ * @brief One packet: a sample of each enabled channel, indexed by V93XX_DmaChannel (absent channels are 0).
+ */
+struct V93XX_DmaSample {
+    uint32_t index; // Packets accepted by the parser before this one
+    int32_t values[kV93XX_DmaChannelCount];
+};
+
+/**
+ * @brief Single-producer, single-consumer ring of samples over caller-provided storage.
+ *
+ * The producer (the DMA receive task) never blocks: when the ring is full the new sample is dropped
+ * and counted, so a slow consumer loses the newest data rather than stalling the upload.
+ *
+ * head and tail run freely and wrap at 2^32; slots are head & (capacity - 1), which stays
+ * continuous across that wrap only for a power-of-two capacity.
+ */
+class V93XX_DmaRing {
+  public:
+    /**
+     * @return false (and a ring that drops everything) unless @p capacity is a power of two and
+     *         @p storage is non-null
+     */
+    bool Begin(V93XX_DmaSample *storage, size_t capacity);
+
+    bool Push(const V93XX_DmaSample &sample);
+
+    /**
+     * @return Samples copied to @p out (at most @p max_count)
+     */
+    size_t Read(V93XX_DmaSample *out, size_t max_count);
+
+    size_t Available() const;
+    uint32_t Dropped() const { return this->dropped.load(std::memory_order_relaxed); }
+
+  private:
+    V93XX_DmaSample *storage = nullptr;
+    uint32_t capacity = 0;
+    std::atomic<uint32_t> head{0}; // Written by the producer
+    std::atomic<uint32_t> tail{0}; // Written by the consumer
+    std::atomic<uint32_t> dropped{0};
+};
+
+/**
+ * @brief Splits the upload byte stream into packets, validates SP_CHECK and fills a V93XX_DmaRing.
+ *
+ * Bytes may arrive in chunks of any size (DMA buffers). Without SP_CHECK the stream is aligned by
+ * Restart(), called at each chip-select boundary. With SP_CHECK the parser also finds the packet
+ * boundary itself: after a check failure it slides one byte at a time and emits again once
+ * kLockPackets consecutive packets pass.
+ *
+ * Arduino-independent: tools/host/dma_replay.cpp runs it on recorded streams.
+ */
+class V93XX_DmaParser {
+  public:
+    static constexpr uint8_t kMaxPacketBytes = kV93XX_DmaChannelCount * 4 + 1;
+    static constexpr uint8_t kLockPackets = 2;
+
+    struct Counters {
+        uint32_t packets = 0;         // Packets delivered to the ring (including ones it dropped)
+        uint32_t check_errors = 0;    // SP_CHECK failures while locked
+        uint32_t resyncs = 0;         // Times the packet boundary was (re)acquired
+        uint32_t discarded_bytes = 0; // Bytes skipped while hunting for the boundary or cut off by Restart()
+    };
+
+    /**
+     * @return false if @p format is invalid or @p ring is null
+     */
+    bool Begin(const V93XX_DmaFormat &format, V93XX_DmaRing *ring);
+
+    /**
+     * @return Packets delivered from these bytes
+     */
+    size_t Push(const uint8_t *data, size_t length);
+
+    /**
+     * @brief Transfer boundary (chip select released): drop any partial packet.
+     */
+    void Restart();
+
+    bool Locked() const { return this->locked; }
+    const V93XX_DmaFormat &Format() const { return this->format; }
+    const Counters &Stats() const { return this->counters; }
+    void ResetStats() { this->counters = Counters(); }
+
+  private:
+    V93XX_DmaFormat format = {};
+    V93XX_DmaRing *ring = nullptr;
+    uint8_t packet_bytes = 0;
+    uint8_t pending[kMaxPacketBytes] = {0};
+    uint8_t fill = 0;
+    bool locked = false;
+    uint8_t good_run = 0;
+    Counters counters;
+
+    bool ProcessPacket();
+    void Deliver();
+};
+
+#endif
@@ -0,0 +1,291 @@
+#ifndef V93XX_ENERGY_H__
+#define V93XX_ENERGY_H__
+
+#include "V93XX_RegisterMap.h"
+#include "V93XX_Registers.h"
+#include "V93XX_Status.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Helpers for the energy accumulators that do not touch the bus.
+ */
+namespace V93XX_EnergyMath {
+
+constexpr uint8_t kWideBits = 46;   // EGY_OUT1L/H, EGY_OUT2L/H
+constexpr uint8_t kNarrowBits = 32; // EGY_OUT3..8, EGY_CFCNT1..8
+
+/**
+ * @brief Assemble a 46-bit accumulator from a high/low/high read sequence.
+ *
+ * If the two high reads differ, the low word carried during the read. A low word read
+ * after the carry is small (bit 31 clear), so it pairs with the second high word;
+ * otherwise it was read before the carry and pairs with the first.
+ */
+inline uint64_t Assemble46(uint32_t high_before, uint32_t low, uint32_t high_after) {
+    high_before &= 0x3FFF;
+    high_after &= 0x3FFF;
+    uint32_t high = high_before;
+    if (high_before != high_after && (low & 0x80000000UL) == 0) {
+        high = high_after;
+    }
+    return ((uint64_t)high << 32) | low;
+}
+
+/**
+ * @brief Advance a 64-bit host counter by the modular distance to a new raw reading.
+ */
+inline uint64_t Extend(uint64_t extended, uint64_t previous_raw, uint64_t raw, uint8_t bits) {
+    const uint64_t mask = (bits >= 64) ? ~0ULL : ((1ULL << bits) - 1);
+    return extended + ((raw - previous_raw) & mask);
+}
+
+/**
+ * @brief Time until an accumulator of @p bits wraps at @p counts_per_second, scaled by @p margin.
+ * @return Interval in milliseconds, or UINT32_MAX when the counter is not moving.
+ */
+inline uint32_t WrapHorizonMs(uint8_t bits, double counts_per_second, float margin) {
+    if (counts_per_second <= 0.0) {
+        return UINT32_MAX;
+    }
+    double span = (double)(1ULL << bits);
+    double ms = (span / counts_per_second) * 1000.0 * margin;
+    return (ms >= (double)UINT32_MAX) ? UINT32_MAX : (uint32_t)ms;
+}
+
+} // namespace V93XX_EnergyMath
+
+/**
+ * @brief Reads all energy accumulators through block-read views and extends them to 64-bit host counters.
+ *
+ * Works with V93XX_UART and V93XX_SPI (uses ConfigureBlockRead() and the *WithRetry() calls).
+ * Every read needs a valid frame checksum: a zero or corrupt word taken for a counter would look
+ * like a wrap and add up to 2^46 counts for good, so a poll with any failed read changes nothing.
+ *
+ * View 1 (16 slots): OUT1H, OUT1L, OUT1H, OUT2H, OUT2L, OUT2H, OUT3..OUT8, SA1, SB1, CFCNT1, CFCNT2
+ * View 2 (6 slots):  CFCNT3..CFCNT8 (only when Config::read_pulse_counters is set)
+ *
+ * After each Poll() the reader recomputes how long it can wait before the fastest moving
+ * accumulator could wrap, from both the configured accumulation model (EGY_CONSTn for
+ * constant-input accumulators, average apparent power otherwise) and the count rate observed
+ * between polls. NextPollDue() tells the application when to call Poll() again.
+ */
+template <typename Device> class V93XX_Energy {
+  public:
+    static constexpr uint8_t kAccumulators = 8;
+
+    struct Config {
+        float high_speed_rate_hz;  // Accumulation ticks per second for EGY_OUT1/2 (46-bit)
+        float low_speed_rate_hz;   // Accumulation ticks per second for EGY_OUT3..8 (32-bit)
+        float margin;              // Fraction of the wrap horizon to use (0 < margin <= 1)
+        uint32_t min_interval_ms;  // Never schedule polls closer than this
+        uint32_t max_interval_ms;  // Poll at least this often even when idle
+        bool read_pulse_counters;  // Also read EGY_CFCNT3..8 (second block read)
+    };
+
+    struct Snapshot {
+        uint64_t energy[kAccumulators];      // Extended EGY_OUTn counters
+        uint64_t pulse_count[kAccumulators]; // Extended EGY_CFCNTn counters
+        uint32_t apparent_power_a;           // DSP_DAT_SA1 at the time of the poll
+        uint32_t apparent_power_b;           // DSP_DAT_SB1 at the time of the poll
+        uint32_t timestamp_ms;               // now_ms passed to Poll()
+        uint32_t safe_interval_ms;           // Longest wait before the next Poll()
+        bool interval_exceeded;              // Previous poll was later than the safe interval
+    };
+
+    static Config DefaultConfig() {
+        Config config;
+        config.high_speed_rate_hz = 6400.0f;
+        config.low_speed_rate_hz = 32768.0f;
+        config.margin = 0.5f;
+        config.min_interval_ms = 100;
+        config.max_interval_ms = 3600000UL;
+        config.read_pulse_counters = false;
+        return config;
+    }
+
+    explicit V93XX_Energy(Device &device) : device(device), config(DefaultConfig()) {}
+
+    /**
+     * @brief Read EGY_CONST1..8 and the accumulator input modes, then take the baseline reading.
+     * @return Status of the first failed read; without a baseline the next successful Poll() takes it
+     */
+    V93XX_Status Begin(const Config &config, uint32_t now_ms) {
+        this->config = config;
+        if (this->config.margin <= 0.0f || this->config.margin > 1.0f) {
+            this->config.margin = 0.5f;
+        }
+        this->snapshot = Snapshot{};
+        this->started = false;
+
+        using namespace V93XX_RegisterMap;
+        V93XX_Result<uint32_t> ctrl2 = this->device.RegisterReadWithRetry(DSP_CTRL2);
+        if (!ctrl2.Ok()) {
+            return ctrl2.status;
+        }
+        V93XX_Result<uint32_t> ctrl3 = this->device.RegisterReadWithRetry(DSP_CTRL3);
+        if (!ctrl3.Ok()) {
+            return ctrl3.status;
+        }
+        const InputMode modes[kAccumulators] = {
+            Get<DspCtrl2::InMode1>(ctrl2.value), Get<DspCtrl2::InMode2>(ctrl2.value),
+            Get<DspCtrl2::InMode3>(ctrl2.value), Get<DspCtrl2::InMode4>(ctrl2.value),
+            Get<DspCtrl3::InMode5>(ctrl3.value), Get<DspCtrl3::InMode6>(ctrl3.value),
+            Get<DspCtrl3::InMode7>(ctrl3.value), Get<DspCtrl3::InMode8>(ctrl3.value),
+        };
+        for (uint8_t i = 0; i < kAccumulators; i++) {
+            V93XX_Result<uint32_t> constant = this->device.RegisterReadWithRetry(kConstAddresses[i]);
+            if (!constant.Ok()) {
+                return constant.status;
+            }
+            this->constants[i] = constant.value;
+            this->constant_input[i] = (modes[i] == InputMode::Constant);
+        }
+
+        return Poll(now_ms);
+    }
+
+    /**
+     * @brief Read the accumulators and update the extended counters and schedule.
+     * @return Ok, or the status of the failed read; the counters, snapshot and schedule are then untouched
+     */
+    V93XX_Status Poll(uint32_t now_ms) {
+        uint32_t values[16] = {0};
+        V93XX_Status status = this->device.ConfigureBlockRead(kEnergyView, sizeof(kEnergyView));
+        if (status == V93XX_Status::Ok) {
+            status = this->device.RegisterBlockReadWithRetry(values, sizeof(kEnergyView));
+        }
+        if (status != V93XX_Status::Ok) {
+            return status;
+        }
+
+        uint64_t raw_energy[kAccumulators];
+        raw_energy[0] = V93XX_EnergyMath::Assemble46(values[0], values[1], values[2]);
+        raw_energy[1] = V93XX_EnergyMath::Assemble46(values[3], values[4], values[5]);
+        for (uint8_t i = 2; i < kAccumulators; i++) {
+            raw_energy[i] = values[4 + i];
+        }
+
+        uint64_t raw_pulses[kAccumulators];
+        for (uint8_t i = 0; i < kAccumulators; i++) {
+            raw_pulses[i] = this->raw_pulses[i];
+        }
+        raw_pulses[0] = values[14];
+        raw_pulses[1] = values[15];
+        if (this->config.read_pulse_counters) {
+            uint32_t pulses[16] = {0};
+            status = this->device.ConfigureBlockRead(kPulseView, sizeof(kPulseView));
+            if (status == V93XX_Status::Ok) {
+                status = this->device.RegisterBlockReadWithRetry(pulses, sizeof(kPulseView));
+            }
+            if (status != V93XX_Status::Ok) {
+                return status;
+            }
+            for (uint8_t i = 2; i < kAccumulators; i++) {
+                raw_pulses[i] = pulses[i - 2];
+            }
+        }
+
+        Snapshot next = this->snapshot;
+        next.apparent_power_a = values[12];
+        next.apparent_power_b = values[13];
+        next.timestamp_ms = now_ms;
+
+        uint32_t elapsed_ms = now_ms - this->snapshot.timestamp_ms;
+        next.interval_exceeded = this->started && (elapsed_ms > this->snapshot.safe_interval_ms);
+
+        double observed_rate[kAccumulators] = {0};
+        for (uint8_t i = 0; i < kAccumulators; i++) {
+            uint8_t bits = (i < 2) ? V93XX_EnergyMath::kWideBits : V93XX_EnergyMath::kNarrowBits;
+            if (this->started) {
+                uint64_t before = next.energy[i];
+                next.energy[i] = V93XX_EnergyMath::Extend(before, this->raw_energy[i], raw_energy[i], bits);
+                next.pulse_count[i] = V93XX_EnergyMath::Extend(next.pulse_count[i], this->raw_pulses[i], raw_pulses[i],
+                                                               V93XX_EnergyMath::kNarrowBits);
+                if (elapsed_ms > 0) {
+                    observed_rate[i] = (double)(next.energy[i] - before) * 1000.0 / (double)elapsed_ms;
+                }
+            } else {
+                next.energy[i] = raw_energy[i];
+                next.pulse_count[i] = raw_pulses[i];
+            }
+            this->raw_energy[i] = raw_energy[i];
+            this->raw_pulses[i] = raw_pulses[i];
+        }
+
+        next.safe_interval_ms = ComputeSafeInterval(next, observed_rate);
+        this->snapshot = next;
+        this->started = true;
+        return V93XX_Status::Ok;
+    }
+
+    const Snapshot &Latest() const { return this->snapshot; }
+
+    uint32_t SafeReadIntervalMs() const { return this->snapshot.safe_interval_ms; }
+
+    /**
+     * @brief True once the safe interval since the last Poll() has elapsed.
+     */
+    bool NextPollDue(uint32_t now_ms) const {
+        return !this->started || (now_ms - this->snapshot.timestamp_ms) >= this->snapshot.safe_interval_ms;
+    }
+
+  private:
+    static constexpr uint8_t kConstAddresses[kAccumulators] = {
+        EGY_CONST1, EGY_CONST2, EGY_CONST3, EGY_CONST4, EGY_CONST5, EGY_CONST6, EGY_CONST7, EGY_CONST8,
+    };
+
+    static constexpr uint8_t kEnergyView[16] = {
+        EGY_OUT1H, EGY_OUT1L, EGY_OUT1H, EGY_OUT2H, EGY_OUT2L,   EGY_OUT2H,   EGY_OUT3,   EGY_OUT4,
+        EGY_OUT5,  EGY_OUT6,  EGY_OUT7,  EGY_OUT8,  DSP_DAT_SA1, DSP_DAT_SB1, EGY_CFCNT1, EGY_CFCNT2,
+    };
+
+    static constexpr uint8_t kPulseView[6] = {
+        EGY_CFCNT3, EGY_CFCNT4, EGY_CFCNT5, EGY_CFCNT6, EGY_CFCNT7, EGY_CFCNT8,
+    };
+
+    Device &device;
+    Config config;
+    Snapshot snapshot = {};
+    bool started = false;
+
+    uint32_t constants[kAccumulators] = {0};
+    bool constant_input[kAccumulators] = {false};
+    uint64_t raw_energy[kAccumulators] = {0};
+    uint64_t raw_pulses[kAccumulators] = {0};
+
+    uint32_t ComputeSafeInterval(const Snapshot &next, const double (&observed_rate)[kAccumulators]) const {
+        // Power registers are two's complement; apparent power bounds |P| and |Q| on its channel.
+        uint32_t power_a = Magnitude(next.apparent_power_a);
+        uint32_t power_b = Magnitude(next.apparent_power_b);
+        uint32_t power_bound = (power_a > power_b) ? power_a : power_b;
+
+        uint32_t interval = this->config.max_interval_ms;
+        for (uint8_t i = 0; i < kAccumulators; i++) {
+            bool wide = (i < 2);
+            uint32_t increment = this->constant_input[i] ? this->constants[i] : power_bound;
+            double rate = (double)increment * (wide ? this->config.high_speed_rate_hz : this->config.low_speed_rate_hz);
+            if (observed_rate[i] > rate) {
+                rate = observed_rate[i];
+            }
+
+            uint8_t bits = wide ? V93XX_EnergyMath::kWideBits : V93XX_EnergyMath::kNarrowBits;
+            uint32_t horizon = V93XX_EnergyMath::WrapHorizonMs(bits, rate, this->config.margin);
+            if (horizon < interval) {
+                interval = horizon;
+            }
+        }
+
+        if (interval < this->config.min_interval_ms) {
+            interval = this->config.min_interval_ms;
+        }
+        return interval;
+    }
+
+    static uint32_t Magnitude(uint32_t value) {
+        int32_t signed_value = (int32_t)value;
+        return (signed_value < 0) ? (uint32_t)(-(int64_t)signed_value) : value;
+    }
+};
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef V93XX_EVENTS_H__
+#define V93XX_EVENTS_H__
+
+#include "V93XX_Registers.h"
+#include "V93XX_Status.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Single-read SYS_INTSTS dispatcher.
+ *
+ * Subsystems register a handler for the status bits they care about (PHSDONE, WAVESTORE,
+ * WAVEOV, CKERR, HSEFAIL, REFERR, the update bits, ...). Poll() reads SYS_INTSTS once, calls
+ * every handler whose mask intersects the pending bits, and clears all handled bits with a
+ * single write, instead of each subsystem doing its own read/clear round trip.
+ *
+ * The status read needs a valid frame checksum: a failed read dispatches and clears nothing. A
+ * failed clear is counted (ClearFailures()); its bits stay set and the next Poll() dispatches them
+ * again. Code that waits on a bit inside the driver (waveform capture, V93XX_Calibration) can poll
+ * through the dispatcher too: pass StatusSource to the driver's SetInterruptStatusSource().
+ *
+ * Works with V93XX_UART and V93XX_SPI (uses the *WithRetry() calls).
+ */
+template <typename Device> class V93XX_Events {
+  public:
+    static constexpr uint8_t kMaxHandlers = 8;
+
+    /**
+     * @brief Status handler.
+     * @param bits Pending bits that intersect the handler's mask
+     * @param context Pointer given to On()
+     */
+    typedef void (*Handler)(uint32_t bits, void *context);
+
+    explicit V93XX_Events(Device &device) : device(device) {}
+
+    /**
+     * @brief Register @p handler for the SYS_INTSTS bits in @p mask.
+     * @param clear Clear these bits after dispatch (set false for bits another party acknowledges)
+     * @return false if all handler slots are used
+     */
+    bool On(uint32_t mask, Handler handler, void *context = nullptr, bool clear = true) {
+        if (!handler || mask == 0 || this->handler_count >= kMaxHandlers) {
+            return false;
+        }
+        Slot &slot = this->slots[this->handler_count++];
+        slot.mask = mask;
+        slot.handler = handler;
+        slot.context = context;
+        slot.clear = clear;
+        return true;
+    }
+
+    /**
+     * @brief Read SYS_INTSTS once, dispatch, and clear every handled bit in one write.
+     * @param sys_intsts If set, receives the status word (0 if the read failed)
+     * @return Status of the SYS_INTSTS read; on failure no handler is called and nothing is cleared.
+     *         A failed clear after a good read is counted in ClearFailures().
+     */
+    V93XX_Status Poll(uint32_t *sys_intsts = nullptr) {
+        V93XX_Result<uint32_t> result = this->device.RegisterReadWithRetry(SYS_INTSTS);
+        if (sys_intsts) {
+            *sys_intsts = result.Ok() ? (result.value & SYS_INTSTS_Msk) : 0;
+        }
+        if (!result.Ok()) {
+            return result.status;
+        }
+        uint32_t clear_mask = Dispatch(result.value & SYS_INTSTS_Msk);
+        if (clear_mask && this->device.RegisterWriteWithRetry(SYS_INTSTS, clear_mask) != V93XX_Status::Ok) {
+            this->clear_failures++;
+        }
+        return V93XX_Status::Ok;
+    }
+
+    /**
+     * @brief V93XX_InterruptStatusSource for the driver (context: this object): polls and dispatches.
+     */
+    static V93XX_Status StatusSource(void *context, uint32_t &sys_intsts) {
+        return static_cast<V93XX_Events *>(context)->Poll(&sys_intsts);
+    }
+
+    /**
+     * @brief Dispatch a status word obtained elsewhere (no bus access).
+     * @return Bits that handlers registered with clear=true have consumed; the caller clears them.
+     */
+    uint32_t Dispatch(uint32_t status) {
+        this->last_status = status;
+        uint32_t clear_mask = 0;
+        if (status == 0) {
+            return 0;
+        }
+        for (uint8_t i = 0; i < this->handler_count; i++) {
+            const Slot &slot = this->slots[i];
+            uint32_t bits = status & slot.mask;
+            if (!bits) {
+                continue;
+            }
+            slot.handler(bits, slot.context);
+            if (slot.clear) {
+                clear_mask |= bits;
+            }
+        }
+        return clear_mask;
+    }
+
+    /**
+     * @brief Safe to call from the chip's IRQ pin handler; Service() then performs the read.
+     */
+    void OnInterrupt() { this->interrupt_pending = true; }
+
+    /**
+     * @brief Poll() only if OnInterrupt() fired since the last call; a failed poll stays pending.
+     * @return true if a poll was performed.
+     */
+    bool Service() {
+        if (!this->interrupt_pending) {
+            return false;
+        }
+        this->interrupt_pending = false;
+        if (Poll() != V93XX_Status::Ok) {
+            this->interrupt_pending = true;
+        }
+        return true;
+    }
+
+    uint32_t LastStatus() const { return this->last_status; }
+
+    /**
+     * @brief Polls whose batched SYS_INTSTS clear failed after retries.
+     */
+    uint32_t ClearFailures() const { return this->clear_failures; }
+
+  private:
+    struct Slot {
+        uint32_t mask;
+        Handler handler;
+        void *context;
+        bool clear;
+    };
+
+    Device &device;
+    Slot slots[kMaxHandlers] = {};
+    uint8_t handler_count = 0;
+    uint32_t last_status = 0;
+    uint32_t clear_failures = 0;
+    volatile bool interrupt_pending = false;
+};
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef V93XX_FRAMES_H__
+#define V93XX_FRAMES_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Request frames and checksum arithmetic shared by the UART and SPI transports.
+ *
+ * Read requests carry no runtime data, so every one of them is generated at compile time:
+ * kUartRequests holds the 4-byte UART read frame for each device address and register, and the
+ * block-read frame for each device address and block size (1-16 words). The transports send
+ * these straight from rodata.
+ *
+ * Responses are validated with RunningChecksum, fed one byte at a time as the bytes are taken
+ * off the RX buffer (UART) or shifted in (SPI), so the check is a single compare once the
+ * checksum byte arrives.
+ */
+namespace V93XX_Frames {
+
+constexpr uint8_t kMarker = 0x7D;
+constexpr uint8_t kDeviceAddressCount = 4; // UART A1:A0 pins
+constexpr uint8_t kAddressCount = 0x80;
+constexpr uint8_t kMaxBlockWords = 16;
+constexpr size_t kUartRequestSize = 4;
+
+// UART CMD1[1:0] (datasheet section 7)
+enum Operation : uint8_t {
+    Broadcast = 0,
+    Read = 1,
+    Write = 2,
+    Block = 3,
+};
+
+/**
+ * @brief Datasheet frame checksum: 0x33 + ~sum (8-bit arithmetic).
+ */
+constexpr uint8_t Checksum(uint8_t sum) { return (uint8_t)(0x33 + (uint8_t)~sum); }
+
+/**
+ * @brief UART CMD1: (words - 1) << 4 | device << 2 | operation.
+ */
+constexpr uint8_t UartCmd1(uint8_t words, uint8_t device_address, Operation operation) {
+    return (uint8_t)((((words - 1) & 0x0F) << 4) | ((device_address & 0x03) << 2) | operation);
+}
+
+/**
+ * @brief SPI CMD: ADDR[6:0] << 1 | R/W (write to 0x7F => 0xFE).
+ */
+constexpr uint8_t SpiCmd(uint8_t address7, bool is_read) {
+    return (uint8_t)(((address7 & 0x7F) << 1) | (is_read ? 1 : 0));
+}
+
+/**
+ * @brief Checksum accumulated byte by byte while a response streams in.
+ *
+ * Seed with the bytes the chip includes but does not send back (CMD1 + CMD2 on UART, CMD on SPI).
+ */
+class RunningChecksum {
+  public:
+    constexpr explicit RunningChecksum(uint8_t seed = 0) : sum(seed) {}
+
+    void Add(uint8_t byte) { this->sum = (uint8_t)(this->sum + byte); }
+    constexpr uint8_t Expected() const { return Checksum(this->sum); }
+    constexpr bool Matches(uint8_t received) const { return Expected() == received; }
+
+  private:
+    uint8_t sum;
+};
+
+struct UartRequest {
+    uint8_t bytes[kUartRequestSize]; // marker, CMD1, CMD2, checksum
+
+    constexpr uint8_t Cmd1() const { return bytes[1]; }
+    constexpr uint8_t Cmd2() const { return bytes[2]; }
+
+    /**
+     * @brief Checksum seed for the response to this request (CMD1 + CMD2).
+     */
+    constexpr RunningChecksum ResponseChecksum() const { return RunningChecksum((uint8_t)(bytes[1] + bytes[2])); }
+};
+
+constexpr UartRequest MakeUartRequest(uint8_t cmd1, uint8_t cmd2) {
+    return UartRequest{{kMarker, cmd1, cmd2, Checksum((uint8_t)(cmd1 + cmd2))}};
+}
+
+struct UartRequestTable {
+    UartRequest read[kDeviceAddressCount][kAddressCount];
+    UartRequest block[kDeviceAddressCount][kMaxBlockWords]; // [device][words - 1], CMD2 = 0
+};
+
+constexpr UartRequestTable BuildUartRequests() {
+    UartRequestTable table{};
+    for (uint8_t device = 0; device < kDeviceAddressCount; device++) {
+        for (uint8_t address = 0; address < kAddressCount; address++) {
+            table.read[device][address] = MakeUartRequest(UartCmd1(1, device, Read), address);
+        }
+        for (uint8_t words = 1; words <= kMaxBlockWords; words++) {
+            table.block[device][words - 1] = MakeUartRequest(UartCmd1(words, device, Block), 0x00);
+        }
+    }
+    return table;
+}
+
+inline constexpr UartRequestTable kUartRequests = BuildUartRequests();
+
+/**
+ * @brief Read requests for one device address, indexed by register address.
+ */
+constexpr const UartRequest *UartReadRequests(uint8_t device_address) {
+    return kUartRequests.read[device_address & 0x03];
+}
+
+/**
+ * @brief Block-read requests for one device address, indexed by word count - 1.
+ */
+constexpr const UartRequest *UartBlockRequests(uint8_t device_address) {
+    return kUartRequests.block[device_address & 0x03];
+}
+
+// Spot checks of the generated tables.
+static_assert(kUartRequests.read[0][0x7F].bytes[1] == 0x01, "read CMD1 for device 0");
+static_assert(kUartRequests.read[3][0x7F].bytes[1] == 0x0D, "read CMD1 for device 3");
+static_assert(kUartRequests.block[1][15].bytes[1] == 0xF7, "16-word block CMD1 for device 1");
+static_assert(kUartRequests.read[2][0x1A].bytes[3] == Checksum(0x09 + 0x1A), "request checksum");
+static_assert(SpiCmd(0x7F, false) == 0xFE, "SPI CMD for a write to 0x7F");
+static_assert(MakeUartRequest(0x01, 0x00).ResponseChecksum().Matches(Checksum(0x01)), "response seed");
+// 4 device addresses x (128 read + 16 block frames) x 4 bytes, kept once in rodata.
+static_assert(sizeof(UartRequestTable) == 2304, "kUartRequests is 2304 bytes");
+
+} // namespace V93XX_Frames
+
+#endif
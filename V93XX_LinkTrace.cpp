@@ -0,0 +1,130 @@
+#include "V93XX_LinkTrace.h"
+
+void V93XX_LinkTrace::Begin(Link link, Writer writer, void *context, uint32_t (*clock_us)()) {
+    this->writer = writer;
+    this->context = context;
+    this->clock_us = clock_us;
+    this->events = 0;
+    this->bytes_written = 0;
+    this->length = 0;
+    this->last_us = clock_us ? clock_us() : 0;
+    if (!writer) {
+        return;
+    }
+
+    uint8_t header[kHeaderSize] = {(uint8_t)kMagic,         (uint8_t)(kMagic >> 8), (uint8_t)(kMagic >> 16),
+                                   (uint8_t)(kMagic >> 24), kVersion,              (uint8_t)link,
+                                   0,                       0};
+    writer(header, sizeof(header), context);
+    this->bytes_written = sizeof(header);
+}
+
+void V93XX_LinkTrace::End() {
+    Flush();
+    this->writer = nullptr;
+}
+
+void V93XX_LinkTrace::Tx(const uint8_t *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        Tx(data[i]);
+    }
+}
+
+void V93XX_LinkTrace::Flush() {
+    if (this->writer && this->length) {
+        this->writer(this->buffer, this->length, this->context);
+        this->bytes_written += (uint32_t)this->length;
+    }
+    this->length = 0;
+}
+
+void V93XX_LinkTrace::Record(Event event, uint8_t first, uint8_t second, uint8_t data_bytes) {
+    if (!this->writer) {
+        return;
+    }
+    // Worst case: tag, 5-byte varint, 2 data bytes.
+    if (this->length + 8 > kBufferSize) {
+        Flush();
+    }
+    uint32_t now = this->clock_us ? this->clock_us() : this->last_us;
+    uint32_t delta = now - this->last_us;
+    this->last_us = now;
+
+    if (delta < kDeltaEscape) {
+        this->buffer[this->length++] = (uint8_t)(((uint8_t)event << 6) | delta);
+    } else {
+        this->buffer[this->length++] = (uint8_t)(((uint8_t)event << 6) | kDeltaEscape);
+        while (delta >= 0x80) {
+            this->buffer[this->length++] = (uint8_t)(delta | 0x80);
+            delta >>= 7;
+        }
+        this->buffer[this->length++] = (uint8_t)delta;
+    }
+    this->buffer[this->length++] = first;
+    if (data_bytes > 1) {
+        this->buffer[this->length++] = second;
+    }
+    this->events++;
+}
+
+bool V93XX_LinkTraceReader::Begin(const uint8_t *data, size_t length) {
+    this->data = data;
+    this->length = length;
+    this->offset = V93XX_LinkTrace::kHeaderSize;
+    this->time_us = 0;
+    this->first = true;
+    if (!data || length < V93XX_LinkTrace::kHeaderSize) {
+        return false;
+    }
+    uint32_t magic = (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) |
+                     ((uint32_t)data[3] << 24);
+    this->link = (V93XX_LinkTrace::Link)data[5];
+    return magic == V93XX_LinkTrace::kMagic && data[4] == V93XX_LinkTrace::kVersion;
+}
+
+bool V93XX_LinkTraceReader::Next(Entry &entry) {
+    size_t at = this->offset;
+    if (at >= this->length) {
+        return false;
+    }
+    uint8_t tag = this->data[at++];
+    uint32_t delta = tag & V93XX_LinkTrace::kDeltaEscape;
+    if (delta == V93XX_LinkTrace::kDeltaEscape) {
+        delta = 0;
+        for (uint8_t shift = 0;; shift += 7) {
+            if (at >= this->length || shift > 28) {
+                return false;
+            }
+            uint8_t byte = this->data[at++];
+            delta |= (uint32_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                break;
+            }
+        }
+    }
+    entry.event = (V93XX_LinkTrace::Event)(tag >> 6);
+    size_t data_bytes = (entry.event == V93XX_LinkTrace::Event::Exchange) ? 2 : 1;
+    if (at + data_bytes > this->length) {
+        return false;
+    }
+    entry.tx = 0;
+    entry.rx = 0;
+    switch (entry.event) {
+    case V93XX_LinkTrace::Event::Rx:
+        entry.rx = this->data[at];
+        break;
+    case V93XX_LinkTrace::Event::Exchange:
+        entry.tx = this->data[at];
+        entry.rx = this->data[at + 1];
+        break;
+    default:
+        entry.tx = this->data[at];
+        break;
+    }
+    // The first event's delta is measured from Begin(); the timeline starts at it.
+    this->time_us = this->first ? 0 : this->time_us + delta;
+    this->first = false;
+    entry.time_us = this->time_us;
+    this->offset = at + data_bytes;
+    return true;
+}
@@ -0,0 +1,127 @@
+#ifndef V93XX_LINKTRACE_H__
+#define V93XX_LINKTRACE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Byte-level recording of a transport's link traffic, for replay on a host.
+ *
+ * Attach with SetLinkTrace() on V93XX_UART / V93XX_SPI (before Init() to include the interface
+ * setup). Every byte the driver sends or takes off the link is logged with a microsecond timestamp:
+ * UART TX bytes as they are written and RX bytes as the driver consumes them (including stale bytes
+ * it flushes), SPI transfers as TX/RX pairs between Select and Deselect. Tracing stays on the
+ * driver's calling thread; the UART receive callback is not touched.
+ *
+ * Stream: uint32 magic "V93R", uint8 version (1), uint8 V93XX_LinkTrace::Link, uint16 reserved,
+ * then one record per event:
+ *   uint8 tag: bits 7:6 V93XX_LinkTrace::Event, bits 5:0 microseconds since the previous event
+ *              (63: a LEB128 varint with the delta follows the tag)
+ *   Tx, Rx: uint8 byte; Exchange: uint8 tx, uint8 rx; Control: uint8 V93XX_LinkTrace::Control
+ *
+ * A UART read costs about 20 bytes of trace. Output goes through a Writer in chunks of up to
+ * kBufferSize bytes (a file, or V93XX_Telemetry::Send(Type::LinkTrace, ...)).
+ * tools/host/link_replay.cpp replays a trace through the real drivers on Linux.
+ */
+class V93XX_LinkTrace {
+  public:
+    static constexpr uint32_t kMagic = 0x52333956UL; // "V93R"
+    static constexpr uint8_t kVersion = 1;
+    static constexpr size_t kHeaderSize = 8;
+    static constexpr size_t kBufferSize = 64;
+    static constexpr uint8_t kDeltaEscape = 0x3F;
+
+    enum class Link : uint8_t {
+        Uart = 0,
+        Spi = 1,
+    };
+
+    enum class Event : uint8_t {
+        Tx = 0,
+        Rx = 1,
+        Exchange = 2,
+        Control = 3,
+    };
+
+    enum class Control : uint8_t {
+        Select = 0,   // Operation start (SPI chip select asserted)
+        Deselect = 1, // Operation end
+    };
+
+    typedef void (*Writer)(const uint8_t *data, size_t length, void *context);
+
+    /**
+     * @brief Start a trace: writes the stream header.
+     * @param clock_us Timestamp source (micros on Arduino)
+     */
+    void Begin(Link link, Writer writer, void *context, uint32_t (*clock_us)());
+
+    /**
+     * @brief Stop recording (flushes buffered events).
+     */
+    void End();
+
+    void Tx(uint8_t byte) { Record(Event::Tx, byte, 0, 1); }
+    void Tx(const uint8_t *data, size_t length);
+    void Rx(uint8_t byte) { Record(Event::Rx, byte, 0, 1); }
+    void Exchange(uint8_t tx, uint8_t rx) { Record(Event::Exchange, tx, rx, 2); }
+    void Select() { Record(Event::Control, (uint8_t)Control::Select, 0, 1); }
+    void Deselect() { Record(Event::Control, (uint8_t)Control::Deselect, 0, 1); }
+
+    /**
+     * @brief Hand buffered events to the writer (also done whenever the buffer fills).
+     */
+    void Flush();
+
+    bool Active() const { return this->writer != nullptr; }
+    uint32_t Events() const { return this->events; }
+    uint32_t BytesWritten() const { return this->bytes_written; }
+
+  private:
+    Writer writer = nullptr;
+    void *context = nullptr;
+    uint32_t (*clock_us)() = nullptr;
+    uint32_t last_us = 0;
+    uint32_t events = 0;
+    uint32_t bytes_written = 0;
+    uint8_t buffer[kBufferSize] = {0};
+    size_t length = 0;
+
+    void Record(Event event, uint8_t first, uint8_t second, uint8_t data_bytes);
+};
+
+/**
+ * @brief Reads a V93XX_LinkTrace stream from memory (host replay and analysis).
+ */
+class V93XX_LinkTraceReader {
+  public:
+    struct Entry {
+        V93XX_LinkTrace::Event event;
+        uint64_t time_us; // Since the first event
+        uint8_t tx;       // Tx, Exchange; the V93XX_LinkTrace::Control code for Control
+        uint8_t rx;       // Rx, Exchange
+    };
+
+    /**
+     * @return false if the header is missing or of another version
+     */
+    bool Begin(const uint8_t *data, size_t length);
+
+    /**
+     * @return false at the end of the stream or on a truncated record
+     */
+    bool Next(Entry &entry);
+
+    V93XX_LinkTrace::Link Link() const { return this->link; }
+    size_t Offset() const { return this->offset; }
+
+  private:
+    const uint8_t *data = nullptr;
+    size_t length = 0;
+    size_t offset = 0;
+    uint64_t time_us = 0;
+    bool first = true;
+    V93XX_LinkTrace::Link link = V93XX_LinkTrace::Link::Uart;
+};
+
+#endif
@@ -0,0 +1,230 @@
+#include "V93XX_Metrics.h"
+
+#include <math.h>
+
+// Largest cycle we accumulate: keeps the int32 running sum and uint16 sample count from overflowing.
+static constexpr uint16_t kMaxCycleSamplesLimit = 32767;
+
+V93XX_Metrics::Config V93XX_Metrics::DefaultConfig() {
+    Config config;
+    config.sample_rate_hz = 0.0f;
+    config.hysteresis = 64;
+    config.min_cycle_samples = 16;
+    config.max_cycle_samples = 4096;
+    config.flicker_alpha = 0.05f;
+    return config;
+}
+
+V93XX_Metrics::V93XX_Metrics() : config(DefaultConfig()) { Reset(); }
+
+void V93XX_Metrics::Begin(uint8_t channel_count, const Config &config, CycleCallback callback, void *context) {
+    this->config = config;
+    if (this->config.max_cycle_samples == 0 || this->config.max_cycle_samples > kMaxCycleSamplesLimit) {
+        this->config.max_cycle_samples = kMaxCycleSamplesLimit;
+    }
+    if (this->config.min_cycle_samples > this->config.max_cycle_samples) {
+        this->config.min_cycle_samples = this->config.max_cycle_samples;
+    }
+
+    this->channel_count = (channel_count > kMaxChannels) ? kMaxChannels : channel_count;
+    this->callback = callback;
+    this->callback_context = context;
+    Reset();
+}
+
+void V93XX_Metrics::Reset() {
+    for (uint8_t i = 0; i < kMaxChannels; i++) {
+        ResetChannel(this->channels[i]);
+    }
+}
+
+void V93XX_Metrics::ResetChannel(ChannelState &state) {
+    StartCycle(state);
+    state.previous_sample = 0;
+    state.armed = false;
+    state.synced = false;
+    state.crossing_fraction = 0.0f;
+    state.crossing_sample = 0;
+    state.sample_index = 0;
+    state.dc_level = 0;
+    state.previous_rms = 0.0f;
+    state.flicker_index = 0.0f;
+    state.latest = V93XX_CycleMetrics{};
+}
+
+void V93XX_Metrics::StartCycle(ChannelState &state) {
+    state.sum = 0;
+    state.sum_sq = 0;
+    state.min = INT16_MAX;
+    state.max = INT16_MIN;
+    state.count = 0;
+    state.cycle_start_sample = state.sample_index;
+}
+
+void V93XX_Metrics::AccumulateSpan(ChannelState &state, const int16_t *samples, size_t count) {
+    // Branch-free body with local accumulators so the compiler can vectorize it
+    // (widening multiply-accumulate plus min/max lanes).
+    int32_t sum = 0;
+    uint64_t sum_sq = 0;
+    int16_t min = state.min;
+    int16_t max = state.max;
+    for (size_t i = 0; i < count; i++) {
+        int32_t value = samples[i];
+        sum += value;
+        sum_sq += (uint32_t)(value * value);
+        min = (samples[i] < min) ? samples[i] : min;
+        max = (samples[i] > max) ? samples[i] : max;
+    }
+
+    state.sum += sum;
+    state.sum_sq += sum_sq;
+    state.min = min;
+    state.max = max;
+    state.count += (uint16_t)count;
+}
+
+size_t V93XX_Metrics::FindCrossing(ChannelState &state, const int16_t *samples, size_t count) const {
+    const int32_t level = state.dc_level;
+    const int32_t arm_level = level - (int32_t)this->config.hysteresis;
+
+    bool armed = state.armed;
+    for (size_t i = 0; i < count; i++) {
+        int32_t value = samples[i];
+        if (armed) {
+            if (value >= level) {
+                state.armed = false;
+                return i;
+            }
+        } else if (value < arm_level) {
+            armed = true;
+        }
+    }
+    state.armed = armed;
+    return count;
+}
+
+void V93XX_Metrics::PushSamples(uint8_t channel, const int16_t *samples, size_t count) {
+    if (!samples || channel >= this->channel_count) {
+        return;
+    }
+    ChannelState &state = this->channels[channel];
+
+    size_t pos = 0;
+    while (pos < count) {
+        size_t span = count - pos;
+        size_t room = (size_t)(this->config.max_cycle_samples - state.count);
+        if (span > room) {
+            span = room;
+        }
+
+        size_t crossing = FindCrossing(state, samples + pos, span);
+        int16_t before_crossing = (crossing > 0) ? samples[pos + crossing - 1] : state.previous_sample;
+        AccumulateSpan(state, samples + pos, crossing);
+        state.sample_index += (uint32_t)crossing;
+        state.previous_sample = before_crossing;
+        pos += crossing;
+
+        if (crossing == span) {
+            if (state.count >= this->config.max_cycle_samples) {
+                // No usable crossing (DC or very small signal): publish what we have and resync.
+                PublishCycle(channel, state, 0.0f);
+                StartCycle(state);
+                state.synced = false;
+            }
+            continue;
+        }
+
+        // samples[pos] is the first sample at or above the DC level after an armed dip.
+        int16_t at_crossing = samples[pos];
+        float fraction = 0.0f;
+        if (at_crossing != before_crossing) {
+            fraction = (float)(state.dc_level - before_crossing) / (float)(at_crossing - before_crossing) - 1.0f;
+        }
+
+        if (state.synced) {
+            if (state.count < this->config.min_cycle_samples) {
+                // Too short for a grid cycle: treat as noise and keep accumulating.
+                continue;
+            }
+            float period = (float)(state.sample_index - state.crossing_sample) + (fraction - state.crossing_fraction);
+            PublishCycle(channel, state, period);
+        }
+
+        StartCycle(state);
+        state.synced = true;
+        state.crossing_sample = state.sample_index;
+        state.crossing_fraction = fraction;
+    }
+}
+
+void V93XX_Metrics::PushWords(uint8_t channel, const uint32_t *words, size_t word_count) {
+    if (!words) {
+        return;
+    }
+
+    int16_t unpacked[64];
+    while (word_count > 0) {
+        size_t chunk = (word_count < 32) ? word_count : 32;
+        for (size_t i = 0; i < chunk; i++) {
+            unpacked[2 * i] = (int16_t)(words[i] & 0xFFFF);
+            unpacked[2 * i + 1] = (int16_t)((words[i] >> 16) & 0xFFFF);
+        }
+        PushSamples(channel, unpacked, 2 * chunk);
+        words += chunk;
+        word_count -= chunk;
+    }
+}
+
+void V93XX_Metrics::PublishCycle(uint8_t channel, ChannelState &state, float period_samples) {
+    if (state.count == 0) {
+        return;
+    }
+
+    // Finalize in double: sum_sq / n - mean^2 cancels badly in float when the DC offset is large.
+    double n = (double)state.count;
+    double mean = (double)state.sum / n;
+    double variance = ((double)state.sum_sq / n) - (mean * mean);
+    float rms = (variance > 0.0) ? (float)sqrt(variance) : 0.0f;
+
+    float deviation_high = (float)(state.max - mean);
+    float deviation_low = (float)(mean - state.min);
+    float peak_deviation = (deviation_high > deviation_low) ? deviation_high : deviation_low;
+
+    float rms_delta = 0.0f;
+    if (state.previous_rms > 0.0f) {
+        rms_delta = (rms - state.previous_rms) / state.previous_rms;
+        state.flicker_index += this->config.flicker_alpha * (fabsf(rms_delta) - state.flicker_index);
+    }
+    state.previous_rms = rms;
+    state.dc_level = (int16_t)lround(mean);
+
+    V93XX_CycleMetrics &metrics = state.latest;
+    metrics.cycle_index++;
+    metrics.start_sample = state.cycle_start_sample;
+    metrics.sample_count = state.count;
+    metrics.period_samples = period_samples;
+    metrics.frequency_hz = (period_samples > 0.0f && this->config.sample_rate_hz > 0.0f)
+                               ? this->config.sample_rate_hz / period_samples
+                               : 0.0f;
+    metrics.dc_offset = (float)mean;
+    metrics.rms = rms;
+    metrics.peak_positive = state.max;
+    metrics.peak_negative = state.min;
+    metrics.crest_factor = (rms > 0.0f) ? peak_deviation / rms : 0.0f;
+    metrics.rms_delta = rms_delta;
+    metrics.flicker_index = state.flicker_index;
+
+    if (this->callback) {
+        this->callback(channel, metrics, this->callback_context);
+    }
+}
+
+const V93XX_CycleMetrics &V93XX_Metrics::Latest(uint8_t channel) const {
+    static const V93XX_CycleMetrics empty = {};
+    if (channel >= this->channel_count) {
+        return empty;
+    }
+    return this->channels[channel].latest;
+}
+
+uint32_t V93XX_Metrics::CycleCount(uint8_t channel) const { return Latest(channel).cycle_index; }
@@ -0,0 +1,113 @@
+#ifndef V93XX_METRICS_H__
+#define V93XX_METRICS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Power-quality metrics for one completed grid cycle of one waveform channel.
+ *
+ * Amplitudes are in raw ADC counts, i.e. the same scale as the 16-bit DAT_WAVE samples.
+ */
+struct V93XX_CycleMetrics {
+    uint32_t cycle_index;  // Cycles published on this channel since Begin()/Reset()
+    uint32_t start_sample; // Absolute index of the first sample in this cycle
+    uint16_t sample_count; // Whole samples in this cycle
+    float period_samples;  // Rising zero-crossing to rising zero-crossing, sub-sample interpolated (0 if forced)
+    float frequency_hz;    // sample_rate_hz / period_samples (0 if no sample rate configured)
+    float dc_offset;       // Mean value over the cycle
+    float rms;             // AC RMS with the cycle mean removed
+    int16_t peak_positive; // Largest sample in the cycle
+    int16_t peak_negative; // Smallest sample in the cycle
+    float crest_factor;    // Largest deviation from dc_offset divided by rms
+    float rms_delta;       // Relative RMS change versus the previous cycle (flicker precursor)
+    float flicker_index;   // Exponentially weighted mean of |rms_delta|
+};
+
+/**
+ * @brief Incremental, allocation-free power-quality metrics over waveform samples.
+ *
+ * Samples are consumed in spans of any length as they arrive (for example one block read of
+ * DAT_WAVE at a time). Each channel keeps O(1) state: running sum, sum of squares, extremes
+ * and zero-crossing tracking. A cycle is closed on every rising crossing of the running DC
+ * level and published through the callback and Latest().
+ */
+class V93XX_Metrics {
+  public:
+    static constexpr uint8_t kMaxChannels = 3;
+
+    typedef void (*CycleCallback)(uint8_t channel, const V93XX_CycleMetrics &metrics, void *context);
+
+    struct Config {
+        float sample_rate_hz;       // Waveform sample rate, used for frequency_hz only
+        uint16_t hysteresis;        // Counts below the DC level required to arm a rising crossing
+        uint16_t min_cycle_samples; // Crossings closer than this are treated as noise
+        uint16_t max_cycle_samples; // Force a cycle boundary when no crossing is seen (DC input)
+        float flicker_alpha;        // Smoothing factor for flicker_index
+    };
+
+    static Config DefaultConfig();
+
+    V93XX_Metrics();
+
+    /**
+     * @brief Configure the engine and clear all channel state.
+     * @param channel_count Number of independent channels (1..kMaxChannels)
+     * @param config Detection and smoothing parameters
+     * @param callback Optional per-cycle callback, invoked from PushSamples()/PushWords()
+     * @param context Opaque pointer handed back to @p callback
+     */
+    void Begin(uint8_t channel_count, const Config &config, CycleCallback callback = nullptr,
+               void *context = nullptr);
+
+    void Reset();
+
+    /**
+     * @brief Feed signed 16-bit samples of one channel.
+     */
+    void PushSamples(uint8_t channel, const int16_t *samples, size_t count);
+
+    /**
+     * @brief Feed packed DAT_WAVE words of a single-channel capture (low half = sample 2n, high half = 2n+1).
+     */
+    void PushWords(uint8_t channel, const uint32_t *words, size_t word_count);
+
+    const V93XX_CycleMetrics &Latest(uint8_t channel) const;
+    uint32_t CycleCount(uint8_t channel) const;
+
+  private:
+    struct ChannelState {
+        int32_t sum;
+        uint64_t sum_sq;
+        int16_t min;
+        int16_t max;
+        uint16_t count;
+
+        int16_t previous_sample;
+        bool armed;
+        bool synced;
+        float crossing_fraction;
+        uint32_t crossing_sample;
+        uint32_t sample_index;
+        uint32_t cycle_start_sample;
+
+        int16_t dc_level;
+        float previous_rms;
+        float flicker_index;
+        V93XX_CycleMetrics latest;
+    };
+
+    Config config;
+    uint8_t channel_count = 0;
+    CycleCallback callback = nullptr;
+    void *callback_context = nullptr;
+    ChannelState channels[kMaxChannels];
+
+    static void ResetChannel(ChannelState &state);
+    static void StartCycle(ChannelState &state);
+    static void AccumulateSpan(ChannelState &state, const int16_t *samples, size_t count);
+    size_t FindCrossing(ChannelState &state, const int16_t *samples, size_t count) const;
+    void PublishCycle(uint8_t channel, ChannelState &state, float period_samples);
+};
+
+#endif
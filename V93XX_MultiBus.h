@@ -0,0 +1,167 @@
+#ifndef V93XX_MULTIBUS_H__
+#define V93XX_MULTIBUS_H__
+
+#include "V93XX_Acquisition.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Runs several V93XX_Acquisition services (one worker per bus) on a common time base.
+ *
+ * The drivers block while a frame is on the wire (UART reads wait in delay(1), which yields), so
+ * chips on separate UART ports or SPI hosts are polled concurrently by giving each bus its own
+ * worker: the aggregate poll rate grows with the number of buses instead of being their sum of
+ * frame times. Start() gives every service the same epoch, so groups with equal periods sample at
+ * the same instants on every bus, and Collect() gathers the latest snapshots with their skew.
+ *
+ * Services may use different transports (V93XX_UART, V93XX_SPI). Each bus must have its own port
+ * (HardwareSerial or SPIClass instance); two services on one port would interleave frames.
+ */
+class V93XX_MultiBus {
+  public:
+    static constexpr uint8_t kMaxBuses = 6;
+
+    typedef V93XX_AcquisitionSnapshot Snapshot;
+    typedef V93XX_AcquisitionTaskConfig TaskConfig;
+
+    /**
+     * @brief Latest snapshot of every bus (about 600 bytes per bus: keep it static, not on a task stack).
+     */
+    struct Frame {
+        uint32_t timestamp_ms; // Collect() time (V93XX_AcquisitionNowMs() base)
+        uint32_t epoch_ms;     // First due time shared by all buses
+        uint32_t skew_ms;      // Newest minus oldest snapshot timestamp among valid buses
+        uint8_t bus_count;
+        uint8_t valid_mask; // Bit n set if bus n has published
+        Snapshot buses[kMaxBuses];
+    };
+
+    /**
+     * @brief Register an acquisition service (its groups already added) and the worker settings for its bus.
+     * @return Bus index, or -1 if the table is full or the coordinator is running
+     */
+    template <typename Device>
+    int8_t Add(V93XX_Acquisition<Device> &acquisition, const TaskConfig &config = TaskConfig()) {
+        if (this->running || this->bus_count >= kMaxBuses) {
+            return -1;
+        }
+        Bus &bus = this->buses[this->bus_count];
+        bus.acquisition = &acquisition;
+        bus.config = config;
+        bus.set_epoch = SetEpochThunk<Device>;
+        bus.start = StartThunk<Device>;
+        bus.stop = StopThunk<Device>;
+        bus.latest = LatestThunk<Device>;
+        bus.publishes = PublishesThunk<Device>;
+        return (int8_t)this->bus_count++;
+    }
+
+    /**
+     * @brief Align every bus on an epoch @p lead_ms from now and start all workers.
+     * @return false (with no worker left running) if any worker could not be started
+     */
+    bool Start(uint32_t lead_ms = 10) {
+        if (this->running || this->bus_count == 0) {
+            return false;
+        }
+        this->epoch_ms = V93XX_AcquisitionNowMs() + lead_ms;
+        for (uint8_t i = 0; i < this->bus_count; i++) {
+            this->buses[i].set_epoch(this->buses[i].acquisition, this->epoch_ms);
+        }
+        for (uint8_t i = 0; i < this->bus_count; i++) {
+            if (!this->buses[i].start(this->buses[i].acquisition, this->buses[i].config)) {
+                while (i-- > 0) {
+                    this->buses[i].stop(this->buses[i].acquisition);
+                }
+                return false;
+            }
+        }
+        this->running = true;
+        return true;
+    }
+
+    void Stop() {
+        for (uint8_t i = 0; i < this->bus_count; i++) {
+            this->buses[i].stop(this->buses[i].acquisition);
+        }
+        this->running = false;
+    }
+
+    bool Running() const { return this->running; }
+    uint8_t BusCount() const { return this->bus_count; }
+    uint32_t EpochMs() const { return this->epoch_ms; }
+
+    /**
+     * @brief Copy the latest snapshot of every bus (lock-free, see V93XX_Acquisition::Latest()).
+     * @return true if every bus has published at least once
+     */
+    bool Collect(Frame &frame) const {
+        frame.timestamp_ms = V93XX_AcquisitionNowMs();
+        frame.epoch_ms = this->epoch_ms;
+        frame.bus_count = this->bus_count;
+        frame.valid_mask = 0;
+        uint32_t oldest = 0;
+        uint32_t newest = 0;
+        for (uint8_t i = 0; i < this->bus_count; i++) {
+            if (!this->buses[i].latest(this->buses[i].acquisition, frame.buses[i])) {
+                continue;
+            }
+            uint32_t timestamp = frame.buses[i].timestamp_ms;
+            if (frame.valid_mask == 0 || (int32_t)(timestamp - oldest) < 0) {
+                oldest = timestamp;
+            }
+            if (frame.valid_mask == 0 || (int32_t)(timestamp - newest) > 0) {
+                newest = timestamp;
+            }
+            frame.valid_mask |= (uint8_t)(1 << i);
+        }
+        frame.skew_ms = newest - oldest;
+        return frame.valid_mask == (uint8_t)((1 << this->bus_count) - 1);
+    }
+
+    /**
+     * @brief Snapshots published by all buses together.
+     */
+    uint32_t Publishes() const {
+        uint32_t total = 0;
+        for (uint8_t i = 0; i < this->bus_count; i++) {
+            total += this->buses[i].publishes(this->buses[i].acquisition);
+        }
+        return total;
+    }
+
+  private:
+    // Type-erased V93XX_Acquisition<Device>, so UART and SPI buses share one table.
+    struct Bus {
+        void *acquisition;
+        TaskConfig config;
+        bool (*set_epoch)(void *acquisition, uint32_t epoch_ms);
+        bool (*start)(void *acquisition, const TaskConfig &config);
+        void (*stop)(void *acquisition);
+        bool (*latest)(const void *acquisition, Snapshot &out);
+        uint32_t (*publishes)(const void *acquisition);
+    };
+
+    Bus buses[kMaxBuses] = {};
+    uint8_t bus_count = 0;
+    bool running = false;
+    uint32_t epoch_ms = 0;
+
+    template <typename Device> static bool SetEpochThunk(void *acquisition, uint32_t epoch_ms) {
+        return static_cast<V93XX_Acquisition<Device> *>(acquisition)->SetEpoch(epoch_ms);
+    }
+    template <typename Device> static bool StartThunk(void *acquisition, const TaskConfig &config) {
+        return static_cast<V93XX_Acquisition<Device> *>(acquisition)->Start(config);
+    }
+    template <typename Device> static void StopThunk(void *acquisition) {
+        static_cast<V93XX_Acquisition<Device> *>(acquisition)->Stop();
+    }
+    template <typename Device> static bool LatestThunk(const void *acquisition, Snapshot &out) {
+        return static_cast<const V93XX_Acquisition<Device> *>(acquisition)->Latest(out);
+    }
+    template <typename Device> static uint32_t PublishesThunk(const void *acquisition) {
+        return static_cast<const V93XX_Acquisition<Device> *>(acquisition)->Publishes();
+    }
+};
+
+#endif
@@ -0,0 +1,356 @@
+#ifndef V93XX_PHASE_H__
+#define V93XX_PHASE_H__
+
+#include "V93XX_Registers.h"
+#include "V93XX_Status.h"
+#include <Arduino.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Zero-crossing interpolation for the DSP_PHS_* results; no bus access.
+ */
+namespace V93XX_PhaseMath {
+
+constexpr uint8_t kCounterBits = 16; // DSP_PHS_U / DSP_PHS_I
+
+/**
+ * @brief Fraction of a sample between the sample before a zero crossing and the sample after it.
+ *
+ * Linear interpolation: the waveform passes zero at -before / (after - before).
+ * @return 0..1, or -1 if the two samples do not bracket zero
+ */
+inline float CrossingFraction(int32_t before, int32_t after) {
+    if (before == after) {
+        return (before == 0) ? 0.0f : -1.0f;
+    }
+    if ((before > 0 && after > 0) || (before < 0 && after < 0)) {
+        return -1.0f;
+    }
+    return (float)((double)before / ((double)before - (double)after));
+}
+
+/**
+ * @brief Signed distance from counter value @p from to @p to, modulo the counter width.
+ */
+inline int32_t CounterDelta(uint32_t from, uint32_t to, uint8_t bits = kCounterBits) {
+    const uint32_t mask = (bits >= 32) ? 0xFFFFFFFFUL : ((1UL << bits) - 1);
+    uint32_t delta = (to - from) & mask;
+    if (bits < 32 && (delta & (1UL << (bits - 1)))) {
+        return (int32_t)delta - (int32_t)(1UL << bits);
+    }
+    return (int32_t)delta;
+}
+
+/**
+ * @brief Wrap an angle in degrees into (-180, 180].
+ */
+inline float WrapDegrees(float degrees) {
+    degrees = fmodf(degrees, 360.0f);
+    if (degrees > 180.0f) {
+        degrees -= 360.0f;
+    } else if (degrees <= -180.0f) {
+        degrees += 360.0f;
+    }
+    return degrees;
+}
+
+/**
+ * @brief Angle by which the current lags the voltage.
+ * @param voltage_crossing Voltage crossing position in samples (counter value + fraction)
+ * @param current_crossing Current crossing position in samples
+ * @param same_direction Both crossings have the same slope; otherwise they are half a cycle apart
+ */
+inline float LagDegrees(float voltage_crossing, float current_crossing, bool same_direction, float samples_per_cycle) {
+    float degrees = (current_crossing - voltage_crossing) * 360.0f / samples_per_cycle;
+    if (!same_direction) {
+        degrees += 180.0f;
+    }
+    return WrapDegrees(degrees);
+}
+
+} // namespace V93XX_PhaseMath
+
+/**
+ * @brief Batched U-I phase measurement: one trigger, one status wait, one block read.
+ *
+ * A measurement writes DSP_PHS_STT (sent once; it is an action, not a setting), waits for
+ * SYS_INTSTS.PHSDONE, then reads DSP_PHS_U..DSP_PHS_IP through a single 6-slot block-read view
+ * instead of six register reads. Each crossing is placed between the samples around it
+ * (V93XX_PhaseMath::CrossingFraction()), so the angle resolution is not limited to one sample.
+ *
+ * DSP_PHS_U/I are taken as the sample count at the sample before the crossing (DSP_PHS_UN/IN).
+ * Only their difference enters the angle, so a constant offset in that convention cancels out.
+ *
+ * Measure() blocks until the result is in. Poll() is the non-blocking form: it arms, checks
+ * PHSDONE on later calls, and re-arms every Config::interval_ms (0 = single shot). If a
+ * V93XX_Events dispatcher owns SYS_INTSTS, register OnPhaseDone() for SYS_INTSTS_PHSDONE and set
+ * Config::poll_status to false; Poll() then waits for the handler instead of reading the status.
+ *
+ * Works with V93XX_UART and V93XX_SPI (on SPI the block read is emulated with six reads).
+ */
+template <typename Device> class V93XX_Phase {
+  public:
+    static constexpr uint8_t kValues = 6;
+
+    enum class State : uint8_t {
+        Idle = 0,
+        Waiting,  // DSP_PHS_STT written, waiting for PHSDONE
+        Done,     // Latest() holds a new measurement
+        TimedOut, // PHSDONE did not arrive within Config::timeout_ms
+        Failed,   // PHSDONE clear, trigger or block read failed (Latest().status)
+    };
+
+    struct Config {
+        float sample_rate_hz;    // Rate of the phase counter (waveform samples per second)
+        float line_frequency_hz; // Nominal or tracked line frequency (SetLineFrequency())
+        uint32_t interval_ms;    // Re-arm period for Poll(); 0 = one measurement per Start()
+        uint32_t timeout_ms;     // Give up waiting for PHSDONE after this long
+        bool poll_status;        // Poll() reads SYS_INTSTS itself (false: OnPhaseDone() reports PHSDONE)
+    };
+
+    struct Measurement {
+        V93XX_Status status;    // Status of the block read (or of the trigger write or PHSDONE clear)
+        uint32_t raw[kValues];  // DSP_PHS_U, UN, UP, I, IN, IP
+        float voltage_crossing; // DSP_PHS_U + interpolated fraction, in samples
+        float current_crossing; // DSP_PHS_I + interpolated fraction, in samples
+        bool voltage_rising;    // Slope of the voltage crossing
+        bool current_rising;    // Slope of the current crossing
+        float angle_deg;        // Current lag behind voltage, (-180, 180]
+        bool valid;             // Both sample pairs bracket zero and status is Ok
+        uint32_t timestamp_ms;  // When PHSDONE was seen
+        uint32_t sequence;      // Measurements completed since construction
+    };
+
+    static Config DefaultConfig() {
+        Config config;
+        config.sample_rate_hz = 6400.0f; // 128 samples per 50 Hz cycle
+        config.line_frequency_hz = 50.0f;
+        config.interval_ms = 0;
+        config.timeout_ms = 200;
+        config.poll_status = true;
+        return config;
+    }
+
+    explicit V93XX_Phase(Device &device) : device(device), config(DefaultConfig()) {}
+
+    void Begin(const Config &config) {
+        this->config = config;
+        this->state = State::Idle;
+        this->done_reported = false;
+    }
+
+    /**
+     * @brief Update the line frequency used to convert samples to degrees (e.g. from DSP_DAT_FRQ or V93XX_Metrics).
+     */
+    void SetLineFrequency(float hz) {
+        if (hz > 0.0f) {
+            this->config.line_frequency_hz = hz;
+        }
+    }
+
+    float SamplesPerCycle() const {
+        return (this->config.line_frequency_hz > 0.0f) ? this->config.sample_rate_hz / this->config.line_frequency_hz
+                                                       : 0.0f;
+    }
+
+    /**
+     * @brief Trigger one measurement and wait for it.
+     * @return The measurement (also available through Latest()); status NoResponse on timeout
+     */
+    const Measurement &Measure(uint32_t timeout_ms) {
+        if (!Arm(millis())) {
+            return this->latest;
+        }
+        V93XX_Status status = V93XX_Status::NoResponse;
+        uint32_t start = millis();
+        do {
+            uint32_t sys_intsts = 0;
+            status = ReadDoneStatus(sys_intsts);
+            if (status == V93XX_Status::Ok && (sys_intsts & SYS_INTSTS_PHSDONE)) {
+                Collect(millis());
+                return this->latest;
+            }
+            if (status == V93XX_Status::NotReady) {
+                break;
+            }
+            delay(1);
+        } while ((millis() - start) < timeout_ms);
+        this->state = State::TimedOut;
+        this->latest.status = (status == V93XX_Status::NotReady) ? status : V93XX_Status::NoResponse;
+        this->latest.valid = false;
+        return this->latest;
+    }
+
+    /**
+     * @brief Start measuring through Poll(): the first trigger goes out on the next Poll().
+     */
+    void Start(uint32_t now_ms) {
+        this->running = true;
+        this->next_arm_ms = now_ms;
+        this->state = State::Idle;
+    }
+
+    void Stop() {
+        this->running = false;
+        this->state = State::Idle;
+    }
+
+    /**
+     * @brief Advance the measurement: arm when due, check PHSDONE, read the results.
+     * @return true when a new measurement (valid or not) has been stored in Latest()
+     */
+    bool Poll(uint32_t now_ms) {
+        if (this->state == State::Waiting) {
+            bool done = this->done_reported;
+            if (this->config.poll_status) {
+                uint32_t sys_intsts = 0;
+                done = (ReadDoneStatus(sys_intsts) == V93XX_Status::Ok) && (sys_intsts & SYS_INTSTS_PHSDONE);
+            }
+            if (done) {
+                Collect(now_ms);
+                Schedule(now_ms);
+                return true;
+            }
+            if ((now_ms - this->armed_ms) >= this->config.timeout_ms) {
+                this->state = State::TimedOut;
+                this->latest.status = V93XX_Status::NoResponse;
+                this->latest.valid = false;
+                Schedule(now_ms);
+            }
+            return false;
+        }
+        if (this->running && (int32_t)(now_ms - this->next_arm_ms) >= 0) {
+            if (!Arm(now_ms)) {
+                Schedule(now_ms);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief V93XX_Events handler for SYS_INTSTS_PHSDONE (context: this object).
+     */
+    static void OnPhaseDone(uint32_t bits, void *context) {
+        V93XX_Phase *phase = static_cast<V93XX_Phase *>(context);
+        if ((bits & SYS_INTSTS_PHSDONE) && phase->state == State::Waiting) {
+            phase->done_reported = true;
+        }
+    }
+
+    /**
+     * @brief Interpolate a measurement from the six raw values (no bus access).
+     */
+    static void Interpolate(Measurement &measurement, float samples_per_cycle) {
+        const uint32_t *raw = measurement.raw;
+        float voltage_fraction = V93XX_PhaseMath::CrossingFraction((int32_t)raw[1], (int32_t)raw[2]);
+        float current_fraction = V93XX_PhaseMath::CrossingFraction((int32_t)raw[4], (int32_t)raw[5]);
+        measurement.voltage_rising = (int32_t)raw[2] > (int32_t)raw[1];
+        measurement.current_rising = (int32_t)raw[5] > (int32_t)raw[4];
+
+        // Place the current crossing relative to the voltage one so counter wraps do not matter.
+        int32_t offset = V93XX_PhaseMath::CounterDelta(raw[0], raw[3]);
+        measurement.voltage_crossing = (float)(raw[0] & ((1UL << V93XX_PhaseMath::kCounterBits) - 1));
+        measurement.current_crossing = measurement.voltage_crossing + (float)offset;
+        if (voltage_fraction >= 0.0f) {
+            measurement.voltage_crossing += voltage_fraction;
+        }
+        if (current_fraction >= 0.0f) {
+            measurement.current_crossing += current_fraction;
+        }
+
+        measurement.valid = measurement.status == V93XX_Status::Ok && voltage_fraction >= 0.0f &&
+                            current_fraction >= 0.0f && samples_per_cycle > 0.0f;
+        measurement.angle_deg =
+            measurement.valid ? V93XX_PhaseMath::LagDegrees(measurement.voltage_crossing, measurement.current_crossing,
+                                                            measurement.voltage_rising == measurement.current_rising,
+                                                            samples_per_cycle)
+                              : 0.0f;
+    }
+
+    const Measurement &Latest() const { return this->latest; }
+    State CurrentState() const { return this->state; }
+    bool Running() const { return this->running; }
+
+  private:
+    static constexpr uint8_t kPhaseView[kValues] = {
+        DSP_PHS_U, DSP_PHS_UN, DSP_PHS_UP, DSP_PHS_I, DSP_PHS_IN, DSP_PHS_IP,
+    };
+
+    /**
+     * @brief Clear a stale PHSDONE and write DSP_PHS_STT.
+     * @return false if the clear or the trigger failed (state Failed); a stale PHSDONE would end the wait early
+     */
+    bool Arm(uint32_t now_ms) {
+        V93XX_Status status = this->device.RegisterWriteWithRetry(SYS_INTSTS, SYS_INTSTS_PHSDONE);
+        if (status == V93XX_Status::Ok) {
+            status = this->device.RegisterWriteWithRetry(DSP_PHS_STT, 1);
+        }
+        this->armed_ms = now_ms;
+        this->done_reported = false;
+        if (status != V93XX_Status::Ok) {
+            this->state = State::Failed;
+            this->latest.status = status;
+            this->latest.valid = false;
+            return false;
+        }
+        this->state = State::Waiting;
+        return true;
+    }
+
+    V93XX_Status ReadDoneStatus(uint32_t &sys_intsts) { return this->device.ReadInterruptStatus(sys_intsts); }
+
+    void Collect(uint32_t now_ms) {
+        Measurement next = {};
+        uint32_t values[16] = {0};
+        next.status = this->device.ConfigureBlockRead(kPhaseView, kValues);
+        if (next.status == V93XX_Status::Ok) {
+            next.status = this->device.RegisterBlockReadWithRetry(values, kValues);
+        }
+        for (uint8_t i = 0; i < kValues; i++) {
+            next.raw[i] = values[i];
+        }
+        next.timestamp_ms = now_ms;
+        next.sequence = this->latest.sequence + 1;
+        Interpolate(next, SamplesPerCycle());
+        this->latest = next;
+        this->state = (next.status == V93XX_Status::Ok) ? State::Done : State::Failed;
+        // Acknowledge PHSDONE here unless a dispatcher does it.
+        if (this->config.poll_status) {
+            V93XX_Status status = this->device.RegisterWriteWithRetry(SYS_INTSTS, SYS_INTSTS_PHSDONE);
+            if (status != V93XX_Status::Ok && this->latest.status == V93XX_Status::Ok) {
+                this->state = State::Failed;
+                this->latest.status = status;
+                this->latest.valid = false;
+            }
+        }
+    }
+
+    void Schedule(uint32_t now_ms) {
+        if (!this->running) {
+            return;
+        }
+        if (this->config.interval_ms == 0) {
+            this->running = false;
+            return;
+        }
+        this->next_arm_ms += this->config.interval_ms;
+        // A late Poll() skips the missed slots instead of firing them back to back.
+        if ((int32_t)(now_ms - this->next_arm_ms) > 0) {
+            this->next_arm_ms = now_ms + this->config.interval_ms;
+        }
+    }
+
+    Device &device;
+    Config config;
+    Measurement latest = {};
+    State state = State::Idle;
+    bool running = false;
+    volatile bool done_reported = false;
+    uint32_t armed_ms = 0;
+    uint32_t next_arm_ms = 0;
+};
+
+#endif
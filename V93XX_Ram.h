@@ -0,0 +1,45 @@
+#ifndef V93XX_RAM_H__
+#define V93XX_RAM_H__
+
+#include "V93XX_Status.h"
+#include <stddef.h>
+#include <stdint.h>
+
+namespace V93XX_Ram {
+constexpr uint16_t kWords = 2048; // SYS_RAMADDR.ADDR is 11 bits
+constexpr uint8_t kProbeWords = 4;
+constexpr uint16_t kProbeSpan = 64; // Words searched for a probe window that is not uniform
+} // namespace V93XX_Ram
+
+/**
+ * @brief How ReadRam() walks internal RAM.
+ *
+ * Every access starts by writing the word address with SYS_RAMADDR.REQ. If SYS_RAMDATA reads
+ * then step through consecutive words, one address write serves a whole dump and the words come
+ * 16 at a time from a block-read view of SYS_RAMDATA; otherwise every word costs an address write
+ * and a read. The datasheet does not say which, so Auto probes once (ProbeRamAutoIncrement()).
+ */
+enum class V93XX_RamAccess : uint8_t {
+    Auto = 0,
+    AutoIncrement,
+    PerWord,
+};
+
+/**
+ * @brief One block of a RAM dump (ReadRam() with a sink). Pointers are valid only during the sink call.
+ */
+struct V93XX_RamChunk {
+    size_t first_word;     // Index of words[0] in the dump
+    uint16_t address;      // RAM word address of words[0]
+    const uint32_t *words; // Checksum-valid words
+    uint8_t word_count;    // 1-16
+    bool last;             // No further chunks follow
+};
+
+/**
+ * @brief RAM chunk consumer.
+ * @return false to stop the dump early (the remaining words are not read)
+ */
+typedef bool (*V93XX_RamSink)(const V93XX_RamChunk &chunk, void *context);
+
+#endif
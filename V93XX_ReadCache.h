@@ -0,0 +1,200 @@
+#ifndef V93XX_READCACHE_H__
+#define V93XX_READCACHE_H__
+
+#include "V93XX_Registers.h"
+#include "V93XX_Status.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Lazy read cache for measurement registers, refreshed once per chip update.
+ *
+ * The DSP only refreshes its measurement registers when it raises one of the update bits in
+ * SYS_INTSTS. Registers are grouped by the update bit that refreshes them; the first Read()
+ * of any register in a stale group fetches the whole group with one block read, and every
+ * later Read() in the same update period is served from RAM.
+ *
+ * Groups are invalidated by:
+ *   - Invalidate(sys_intsts) with a status word read elsewhere,
+ *   - PollStatus(), which reads SYS_INTSTS once (the driver's ReadInterruptStatus()) and clears
+ *     the consumed update bits, unless an interrupt-status source owns SYS_INTSTS,
+ *   - OnInterrupt() from the IRQ handler, which defers that single status read to the next Read(),
+ *   - OnUpdate(), a V93XX_Events handler for kUpdateMask, when a dispatcher owns SYS_INTSTS.
+ *
+ * Status and group reads need a valid frame checksum (the *WithRetry() calls). A group whose
+ * block read failed stays stale: Read() returns its previous values and tries again next time,
+ * and LastStatus() reports the failure. A failed status read invalidates and clears nothing; a
+ * failed clear is reported like one, so the next PollStatus() sees the bits again.
+ *
+ * Works with V93XX_UART and V93XX_SPI (uses ConfigureBlockRead(), the *WithRetry() calls and
+ * RegisterRead()). Registers outside the groups are read through.
+ */
+template <typename Device> class V93XX_ReadCache {
+  public:
+    enum Group : uint8_t {
+        CurrentPower = 0, // DSP_DAT_PA..DSP_DAT_SB (0x08-0x0D), refreshed on CURPWRUPD
+        CurrentRms,       // DSP_DAT_RMS0UA..DSP_DAT_CH2 (0x0E-0x12), refreshed on CURRMSUPD
+        AveragePower,     // DSP_DAT_PA1..DSP_DAT_SB1 (0x13-0x18), refreshed on AVGPWRUPD
+        AverageRms,       // DSP_DAT_RMS1UA..DSP_DAT_DCIB (0x19-0x24), refreshed on AVGRMSUPD
+        kGroupCount,
+    };
+
+    static constexpr uint32_t kUpdateMask =
+        SYS_INTSTS_CURPWRUPD | SYS_INTSTS_CURRMSUPD | SYS_INTSTS_AVGPWRUPD | SYS_INTSTS_AVGRMSUPD;
+
+    explicit V93XX_ReadCache(Device &device) : device(device) {}
+
+    /**
+     * @brief Read a register, serving measurement registers from the cache when current.
+     */
+    uint32_t Read(uint8_t address) {
+        if (this->interrupt_pending) {
+            // Cleared before polling so an OnInterrupt() during the poll is kept; a failed poll is repeated.
+            this->interrupt_pending = false;
+            if (PollStatus() != V93XX_Status::Ok) {
+                this->interrupt_pending = true;
+            }
+        }
+
+        int8_t group = GroupOf(address);
+        if (group < 0) {
+            return this->device.RegisterRead(address);
+        }
+        if (!(this->valid_mask & (1 << group))) {
+            Refresh((Group)group);
+        } else {
+            this->hits++;
+        }
+        return this->values[group][address - kGroups[group].first];
+    }
+
+    /**
+     * @brief Copy a whole group (refreshing it first if stale).
+     * @return Number of registers copied into @p out (up to 12).
+     */
+    uint8_t ReadGroup(Group group, uint32_t *out) {
+        if (group >= kGroupCount || !out) {
+            return 0;
+        }
+        (void)Read(kGroups[group].first);
+        for (uint8_t i = 0; i < kGroups[group].count; i++) {
+            out[i] = this->values[group][i];
+        }
+        return kGroups[group].count;
+    }
+
+    /**
+     * @brief Invalidate the groups whose update bits are set in @p sys_intsts.
+     */
+    void Invalidate(uint32_t sys_intsts) {
+        for (uint8_t group = 0; group < kGroupCount; group++) {
+            if (sys_intsts & kGroups[group].update_bit) {
+                this->valid_mask &= (uint8_t)~(1 << group);
+            }
+        }
+    }
+
+    void InvalidateAll() { this->valid_mask = 0; }
+
+    /**
+     * @brief Read SYS_INTSTS once, invalidate updated groups and clear the update bits.
+     * @param sys_intsts If set, receives the status word (0 if the read failed)
+     * @return Status of the SYS_INTSTS read, or of the clear that followed it. The clear is left to the
+     *         driver's interrupt-status source when one is installed.
+     */
+    V93XX_Status PollStatus(uint32_t *sys_intsts = nullptr) {
+        uint32_t value = 0;
+        this->last_status = this->device.ReadInterruptStatus(value);
+        if (sys_intsts) {
+            *sys_intsts = value;
+        }
+        if (this->last_status != V93XX_Status::Ok) {
+            return this->last_status;
+        }
+        Invalidate(value);
+        if ((value & kUpdateMask) && !this->device.HasInterruptStatusSource()) {
+            this->last_status = this->device.RegisterWriteWithRetry(SYS_INTSTS, value & kUpdateMask);
+        }
+        return this->last_status;
+    }
+
+    /**
+     * @brief V93XX_Events handler for kUpdateMask (context: this object).
+     */
+    static void OnUpdate(uint32_t bits, void *context) { static_cast<V93XX_ReadCache *>(context)->Invalidate(bits); }
+
+    /**
+     * @brief Safe to call from an ISR: the next Read() performs the status read.
+     */
+    void OnInterrupt() { this->interrupt_pending = true; }
+
+    uint32_t Hits() const { return this->hits; }
+    uint32_t Refreshes() const { return this->refreshes; }
+    uint32_t Failures() const { return this->failures; }
+
+    /**
+     * @brief Status of the last status read or group refresh.
+     */
+    V93XX_Status LastStatus() const { return this->last_status; }
+
+  private:
+    struct GroupInfo {
+        uint8_t first;
+        uint8_t count;
+        uint32_t update_bit;
+    };
+
+    static constexpr uint8_t kMaxGroupSize = 12;
+
+    static constexpr GroupInfo kGroups[kGroupCount] = {
+        {DSP_DAT_PA, 6, SYS_INTSTS_CURPWRUPD},
+        {DSP_DAT_RMS0UA, 5, SYS_INTSTS_CURRMSUPD},
+        {DSP_DAT_PA1, 6, SYS_INTSTS_AVGPWRUPD},
+        {DSP_DAT_RMS1UA, kMaxGroupSize, SYS_INTSTS_AVGRMSUPD},
+    };
+
+    Device &device;
+    uint32_t values[kGroupCount][kMaxGroupSize] = {{0}};
+    uint8_t valid_mask = 0;
+    volatile bool interrupt_pending = false;
+    uint32_t hits = 0;
+    uint32_t refreshes = 0;
+    uint32_t failures = 0;
+    V93XX_Status last_status = V93XX_Status::Ok;
+
+    static int8_t GroupOf(uint8_t address) {
+        for (uint8_t group = 0; group < kGroupCount; group++) {
+            if (address >= kGroups[group].first && address < kGroups[group].first + kGroups[group].count) {
+                return (int8_t)group;
+            }
+        }
+        return -1;
+    }
+
+    void Refresh(Group group) {
+        const GroupInfo &info = kGroups[group];
+        uint8_t addresses[kMaxGroupSize];
+        for (uint8_t i = 0; i < info.count; i++) {
+            addresses[i] = (uint8_t)(info.first + i);
+        }
+
+        uint32_t block[16] = {0};
+        V93XX_Status status = this->device.ConfigureBlockRead(addresses, info.count);
+        if (status == V93XX_Status::Ok) {
+            status = this->device.RegisterBlockReadWithRetry(block, info.count);
+        }
+        this->last_status = status;
+        if (status != V93XX_Status::Ok) {
+            this->failures++;
+            return;
+        }
+        for (uint8_t i = 0; i < info.count; i++) {
+            this->values[group][i] = block[i];
+        }
+
+        this->valid_mask |= (uint8_t)(1 << group);
+        this->refreshes++;
+    }
+};
+
+#endif
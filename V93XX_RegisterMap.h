@@ -0,0 +1,492 @@
+#ifndef V93XX_REGISTERMAP_H__
+#define V93XX_REGISTERMAP_H__
+
+#include "V93XX_Registers.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief constexpr register and field descriptors for the V93XX register file.
+ *
+ * kRegisters describes every address (access type, membership of the configuration checksum
+ * set). Fields are types: Get<F>(), Set<F>() and Encode<F>() fold to the same
+ * shift-and-mask code as the V93XX_Registers.h macros, but take typed values and cannot be
+ * applied to the wrong width. The static_asserts at the end of this file reject overlapping
+ * fields and cross-check the legacy macros at compile time.
+ *
+ *   uint32_t ctrl5 = Encode<DspCtrl5::WaveU>(true) | Encode<DspCtrl5::WaveMemMode>(DspCtrl5::WaveMem::Cyclic);
+ *   uint16_t stored = Get<SysMisc::WaveStoreCnt>(misc);
+ */
+namespace V93XX_RegisterMap {
+
+enum class Access : uint8_t {
+    ReadOnly = 0,
+    ReadWrite,
+    WriteOnly,       // Writing triggers an action (DSP_PHS_STT, SYS_SFTRST)
+    WriteToClear,    // Any write clears the register (DAT_SWELL_CNT, DAT_DIP_CNT)
+    WriteOneToClear, // Writing 1 clears the corresponding bit (SYS_INTSTS)
+    ReadAdvances,    // Read-only; every read advances the chip's buffer pointer (DAT_WAVE)
+    StreamPort,      // Read/write port whose accesses may auto-increment an address (SYS_RAMDATA)
+};
+
+struct Register {
+    uint8_t address;
+    Access access;
+    bool checksummed; // Part of {0x00-0x07, 0x25-0x3A, 0x55-0x60}, balanced by DSP_CFG_CKSUM
+};
+
+constexpr uint8_t kRegisterCount = 0x80;
+
+constexpr Register kRegisters[kRegisterCount] = {
+    {DSP_ANA0, Access::ReadWrite, true},
+    {DSP_ANA1, Access::ReadWrite, true},
+    {DSP_CTRL0, Access::ReadWrite, true},
+    {DSP_CTRL1, Access::ReadWrite, true},
+    {DSP_CTRL2, Access::ReadWrite, true},
+    {DSP_CTRL3, Access::ReadWrite, true},
+    {DSP_CTRL4, Access::ReadWrite, true},
+    {DSP_CTRL5, Access::ReadWrite, true},
+    {DSP_DAT_PA, Access::ReadOnly, false},
+    {DSP_DAT_QA, Access::ReadOnly, false},
+    {DSP_DAT_SA, Access::ReadOnly, false},
+    {DSP_DAT_PB, Access::ReadOnly, false},
+    {DSP_DAT_QB, Access::ReadOnly, false},
+    {DSP_DAT_SB, Access::ReadOnly, false},
+    {DSP_DAT_RMS0UA, Access::ReadOnly, false},
+    {DSP_DAT_RMS0IA, Access::ReadOnly, false},
+    {DSP_DAT_RMS0IB, Access::ReadOnly, false},
+    {DSP_DAT_CH1, Access::ReadOnly, false},
+    {DSP_DAT_CH2, Access::ReadOnly, false},
+    {DSP_DAT_PA1, Access::ReadOnly, false},
+    {DSP_DAT_QA1, Access::ReadOnly, false},
+    {DSP_DAT_SA1, Access::ReadOnly, false},
+    {DSP_DAT_PB1, Access::ReadOnly, false},
+    {DSP_DAT_QB1, Access::ReadOnly, false},
+    {DSP_DAT_SB1, Access::ReadOnly, false},
+    {DSP_DAT_RMS1UA, Access::ReadOnly, false},
+    {DSP_DAT_RMS1IA, Access::ReadOnly, false},
+    {DSP_DAT_RMS1IB, Access::ReadOnly, false},
+    {DSP_DAT_CH1_AVG, Access::ReadOnly, false},
+    {DSP_DAT_CH2_AVG, Access::ReadOnly, false},
+    {DSP_DAT_RMSU_AVG, Access::ReadOnly, false},
+    {DSP_DAT_RMSIA_AVG, Access::ReadOnly, false},
+    {DSP_DAT_RMSIB_AVG, Access::ReadOnly, false},
+    {DSP_DAT_FRQ, Access::ReadOnly, false},
+    {DSP_DAT_DCU, Access::ReadOnly, false},
+    {DSP_DAT_DCI, Access::ReadOnly, false},
+    {DSP_DAT_DCIB, Access::ReadOnly, false},
+    {DSP_CFG_CALI_PA, Access::ReadWrite, true},
+    {DSP_CFG_DC_PA, Access::ReadWrite, true},
+    {DSP_CFG_CALI_QA, Access::ReadWrite, true},
+    {DSP_CFG_DC_QA, Access::ReadWrite, true},
+    {DSP_CFG_CALI_PB, Access::ReadWrite, true},
+    {DSP_CFG_DC_PB, Access::ReadWrite, true},
+    {DSP_CFG_CALI_QB, Access::ReadWrite, true},
+    {DSP_CFG_DC_QB, Access::ReadWrite, true},
+    {DSP_CFG_CALI_RMSUA, Access::ReadWrite, true},
+    {DSP_CFG_RMS_DCUA, Access::ReadWrite, true},
+    {DSP_CFG_CALI_RMSIA, Access::ReadWrite, true},
+    {DSP_CFG_RMS_DCIA, Access::ReadWrite, true},
+    {DSP_CFG_CALI_RMSIB, Access::ReadWrite, true},
+    {DSP_CFG_RMS_DCIB, Access::ReadWrite, true},
+    {DSP_CFG_PHC, Access::ReadWrite, true},
+    {DSP_CFG_DCUA, Access::ReadWrite, true},
+    {DSP_CFG_DCIA, Access::ReadWrite, true},
+    {DSP_CFG_DCIB, Access::ReadWrite, true},
+    {DSP_CFG_BPF, Access::ReadWrite, true},
+    {DSP_CFG_CKSUM, Access::ReadWrite, true},
+    {EGY_PROCTH, Access::ReadWrite, true},
+    {EGY_PWRTH, Access::ReadWrite, true},
+    {EGY_CONST1, Access::ReadWrite, false},
+    {EGY_OUT1L, Access::ReadWrite, false},
+    {EGY_OUT1H, Access::ReadWrite, false},
+    {EGY_CFCNT1, Access::ReadWrite, false},
+    {EGY_CONST2, Access::ReadWrite, false},
+    {EGY_OUT2L, Access::ReadWrite, false},
+    {EGY_OUT2H, Access::ReadWrite, false},
+    {EGY_CFCNT2, Access::ReadWrite, false},
+    {EGY_CONST3, Access::ReadWrite, false},
+    {EGY_OUT3, Access::ReadWrite, false},
+    {EGY_CFCNT3, Access::ReadWrite, false},
+    {EGY_CONST4, Access::ReadWrite, false},
+    {EGY_OUT4, Access::ReadWrite, false},
+    {EGY_CFCNT4, Access::ReadWrite, false},
+    {EGY_CONST5, Access::ReadWrite, false},
+    {EGY_OUT5, Access::ReadWrite, false},
+    {EGY_CFCNT5, Access::ReadWrite, false},
+    {EGY_CONST6, Access::ReadWrite, false},
+    {EGY_OUT6, Access::ReadWrite, false},
+    {EGY_CFCNT6, Access::ReadWrite, false},
+    {EGY_CONST7, Access::ReadWrite, false},
+    {EGY_OUT7, Access::ReadWrite, false},
+    {EGY_CFCNT7, Access::ReadWrite, false},
+    {EGY_CONST8, Access::ReadWrite, false},
+    {EGY_OUT8, Access::ReadWrite, false},
+    {EGY_CFCNT8, Access::ReadWrite, false},
+    {DSP_OV_THL, Access::ReadWrite, true},
+    {DSP_OV_THH, Access::ReadWrite, true},
+    {DSP_SWELL_THL, Access::ReadWrite, true},
+    {DSP_SWELL_THH, Access::ReadWrite, true},
+    {DSP_DIP_THL, Access::ReadWrite, true},
+    {DSP_DIP_THH, Access::ReadWrite, true},
+    {FD_OVTH, Access::ReadWrite, true},
+    {FD_LVTH, Access::ReadWrite, true},
+    {FD_IA_OCTH, Access::ReadWrite, true},
+    {FD_IA_LCTH, Access::ReadWrite, true},
+    {FD_IB_OCTH, Access::ReadWrite, true},
+    {FD_IB_LCTH, Access::ReadWrite, true},
+    {DSP_PHS_STT, Access::WriteOnly, false},
+    {DSP_PHS_U, Access::ReadOnly, false},
+    {DSP_PHS_UN, Access::ReadOnly, false},
+    {DSP_PHS_UP, Access::ReadOnly, false},
+    {DSP_PHS_I, Access::ReadOnly, false},
+    {DSP_PHS_IN, Access::ReadOnly, false},
+    {DSP_PHS_IP, Access::ReadOnly, false},
+    {TEMPERATE, Access::ReadOnly, false},
+    {DAT_WAVE, Access::ReadAdvances, false},
+    {DAT_SWELL_CNT, Access::WriteToClear, false},
+    {DAT_DIP_CNT, Access::WriteToClear, false},
+    {SYS_SFTRST, Access::WriteOnly, false},
+    {SYS_FPGACW0, Access::ReadWrite, false},
+    {SYS_FPGACW1, Access::ReadWrite, false},
+    {SYS_FPGACW2, Access::ReadWrite, false},
+    {SYS_BAUDCNT1, Access::ReadOnly, false},
+    {SYS_BAUDCNT8, Access::ReadOnly, false},
+    {SYS_INTSTS, Access::WriteOneToClear, false},
+    {SYS_INTEN, Access::ReadWrite, false},
+    {SYS_STS, Access::ReadOnly, false},
+    {SYS_MISC, Access::ReadWrite, false},
+    {SYS_ROMCS, Access::ReadWrite, false},
+    {SYS_RAMADDR, Access::ReadWrite, false},
+    {SYS_RAMDATA, Access::StreamPort, false},
+    {SYS_BLK_ADDR0, Access::ReadWrite, false},
+    {SYS_BLK_ADDR1, Access::ReadWrite, false},
+    {SYS_BLK_ADDR2, Access::ReadWrite, false},
+    {SYS_BLK_ADDR3, Access::ReadWrite, false},
+    {SYS_IOCFG0, Access::ReadWrite, false},
+    {SYS_IOCFG1, Access::ReadWrite, false},
+    {SYS_VERSION, Access::ReadOnly, false},
+};
+
+/**
+ * @brief Returned by Describe() for addresses outside the register file: read-only, not checksummed.
+ */
+constexpr Register kUnknownRegister = {0xFF, Access::ReadOnly, false};
+
+constexpr const Register &Describe(uint8_t address) {
+    return address < kRegisterCount ? kRegisters[address] : kUnknownRegister;
+}
+
+constexpr bool InChecksumSet(uint8_t address) { return address < kRegisterCount && kRegisters[address].checksummed; }
+
+constexpr bool IsWritable(uint8_t address) {
+    return address < kRegisterCount && kRegisters[address].access != Access::ReadOnly &&
+           kRegisters[address].access != Access::ReadAdvances;
+}
+
+/**
+ * @brief True if reading @p address twice returns the same data as reading it once, so a failed
+ * read can simply be repeated.
+ */
+constexpr bool IsReadIdempotent(uint8_t address) {
+    return address < kRegisterCount && kRegisters[address].access != Access::ReadAdvances &&
+           kRegisters[address].access != Access::StreamPort;
+}
+
+/**
+ * @brief True if a block read of the view @p addresses[0, count) can be repeated (see IsReadIdempotent()).
+ */
+constexpr bool IsReadIdempotent(const uint8_t addresses[], uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (!IsReadIdempotent(addresses[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief DSP_CFG_CKSUM value that makes the checksum set sum to 0xFFFFFFFF.
+ *
+ * Every checksum-set register of kRegisters is counted; @p value(address) returns the value it
+ * holds (or will hold). DSP_CFG_CKSUM itself is never asked for.
+ */
+template <typename Lookup> uint32_t ConfigurationChecksum(Lookup &&value) {
+    uint32_t sum = 0;
+    for (uint8_t address = 0; address < kRegisterCount; address++) {
+        if (address != DSP_CFG_CKSUM && kRegisters[address].checksummed) {
+            sum += value(address);
+        }
+    }
+    return 0xFFFFFFFFUL - sum;
+}
+
+/**
+ * @brief True if [first, first + count) are all writable checksum-set registers.
+ */
+constexpr bool IsConfigurationBlock(uint8_t first, uint8_t count) {
+    for (uint16_t address = first; address < (uint16_t)first + count; address++) {
+        if (address >= kRegisterCount || !kRegisters[address].checksummed ||
+            kRegisters[address].access != Access::ReadWrite) {
+            return false;
+        }
+    }
+    return count > 0;
+}
+
+/**
+ * @brief A bit field of register @p Address, @p Width bits starting at @p Pos.
+ */
+template <uint8_t Address, uint8_t Pos, uint8_t Width, typename Value = uint32_t> struct Field {
+    static_assert(Width >= 1 && Pos + Width <= 32, "field does not fit in a 32-bit register");
+    static_assert(Address < kRegisterCount, "field of a non-existent register");
+
+    typedef Value value_type;
+    static constexpr uint8_t address = Address;
+    static constexpr uint8_t pos = Pos;
+    static constexpr uint8_t width = Width;
+    static constexpr uint32_t mask = (uint32_t)(((1ULL << Width) - 1) << Pos);
+};
+
+template <typename F> constexpr uint32_t Encode(typename F::value_type value) {
+    return ((uint32_t)value << F::pos) & F::mask;
+}
+
+template <typename F> constexpr uint32_t Set(uint32_t word, typename F::value_type value) {
+    return (word & ~F::mask) | Encode<F>(value);
+}
+
+template <typename F> constexpr typename F::value_type Get(uint32_t word) {
+    return (typename F::value_type)((word & F::mask) >> F::pos);
+}
+
+/**
+ * @brief True if all fields belong to the same register and no two share a bit.
+ */
+template <typename First, typename... Rest> constexpr bool FieldsDisjoint() {
+    const uint32_t masks[] = {First::mask, Rest::mask...};
+    const uint8_t addresses[] = {First::address, Rest::address...};
+    uint32_t seen = 0;
+    for (size_t i = 0; i < sizeof(masks) / sizeof(masks[0]); i++) {
+        if ((seen & masks[i]) || addresses[i] != First::address) {
+            return false;
+        }
+        seen |= masks[i];
+    }
+    return true;
+}
+
+namespace DspCtrl1 {
+typedef Field<DSP_CTRL1, 6, 1, bool> CalcEn1;
+typedef Field<DSP_CTRL1, 7, 1, bool> CalcEn2;
+typedef Field<DSP_CTRL1, 15, 1, bool> EgyLcEn;
+typedef Field<DSP_CTRL1, 24, 1, bool> SlpMode;
+} // namespace DspCtrl1
+
+/**
+ * @brief Energy accumulator input select (INMODEn); only Constant (EGY_CONSTn per tick) is named here.
+ */
+enum class InputMode : uint8_t {
+    Mode0 = 0,
+    Mode1 = 1,
+    Constant = 2,
+    Mode3 = 3,
+};
+
+namespace DspCtrl2 {
+typedef Field<DSP_CTRL2, 6, 2, InputMode> InMode1;
+typedef Field<DSP_CTRL2, 14, 2, InputMode> InMode2;
+typedef Field<DSP_CTRL2, 22, 2, InputMode> InMode3;
+typedef Field<DSP_CTRL2, 30, 2, InputMode> InMode4;
+} // namespace DspCtrl2
+
+namespace DspCtrl3 {
+typedef Field<DSP_CTRL3, 6, 2, InputMode> InMode5;
+typedef Field<DSP_CTRL3, 14, 2, InputMode> InMode6;
+typedef Field<DSP_CTRL3, 22, 2, InputMode> InMode7;
+typedef Field<DSP_CTRL3, 30, 2, InputMode> InMode8;
+} // namespace DspCtrl3
+
+namespace DspCtrl5 {
+enum class WaveMem : uint8_t {
+    ManualSingle = 0,
+    Cyclic = 1,
+    TriggerSingle = 2,
+    Disable = 3,
+};
+
+typedef Field<DSP_CTRL5, 0, 3, uint8_t> DmaMode;
+typedef Field<DSP_CTRL5, 3, 1, bool> DmaEn;
+typedef Field<DSP_CTRL5, 5, 1, bool> SpiPha;
+typedef Field<DSP_CTRL5, 6, 1, bool> SpiPol;
+typedef Field<DSP_CTRL5, 7, 1, bool> SpCheck;
+typedef Field<DSP_CTRL5, 8, 1, bool> WaveIb;
+typedef Field<DSP_CTRL5, 9, 1, bool> WaveIa;
+typedef Field<DSP_CTRL5, 10, 1, bool> WaveU;
+typedef Field<DSP_CTRL5, 16, 4, uint8_t> WaveLen;
+typedef Field<DSP_CTRL5, 20, 1, bool> TrigUOv;
+typedef Field<DSP_CTRL5, 21, 1, bool> TrigULv;
+typedef Field<DSP_CTRL5, 22, 1, bool> TrigIaOc;
+typedef Field<DSP_CTRL5, 23, 1, bool> TrigIaLc;
+typedef Field<DSP_CTRL5, 24, 1, bool> TrigIbOc;
+typedef Field<DSP_CTRL5, 25, 1, bool> TrigIbLc;
+typedef Field<DSP_CTRL5, 26, 1, bool> TrigUSwell;
+typedef Field<DSP_CTRL5, 27, 1, bool> TrigUDip;
+typedef Field<DSP_CTRL5, 28, 1, bool> TrigManual;
+typedef Field<DSP_CTRL5, 29, 2, WaveMem> WaveMemMode;
+typedef Field<DSP_CTRL5, 31, 1, bool> WaveAddrClr;
+} // namespace DspCtrl5
+
+namespace SysIntSts {
+typedef Field<SYS_INTSTS, 0, 1, bool> PhsDone;
+typedef Field<SYS_INTSTS, 1, 1, bool> IntPdn;
+typedef Field<SYS_INTSTS, 2, 1, bool> AvgPwrUpd;
+typedef Field<SYS_INTSTS, 3, 1, bool> CurPwrUpd;
+typedef Field<SYS_INTSTS, 4, 1, bool> AvgRmsUpd;
+typedef Field<SYS_INTSTS, 5, 1, bool> CurRmsUpd;
+typedef Field<SYS_INTSTS, 6, 1, bool> WaveUpd;
+typedef Field<SYS_INTSTS, 7, 1, bool> WaveStore;
+typedef Field<SYS_INTSTS, 8, 1, bool> WaveOv;
+typedef Field<SYS_INTSTS, 9, 1, bool> USign;
+typedef Field<SYS_INTSTS, 10, 1, bool> ISign;
+typedef Field<SYS_INTSTS, 11, 1, bool> BistErr;
+typedef Field<SYS_INTSTS, 12, 1, bool> RefErr;
+typedef Field<SYS_INTSTS, 13, 1, bool> HseFail;
+typedef Field<SYS_INTSTS, 14, 1, bool> CkErr;
+typedef Field<SYS_INTSTS, 15, 1, bool> DmaFinish;
+typedef Field<SYS_INTSTS, 16, 1, bool> UartErr;
+typedef Field<SYS_INTSTS, 19, 1, bool> SpiErr;
+typedef Field<SYS_INTSTS, 20, 1, bool> UaOv;
+typedef Field<SYS_INTSTS, 21, 1, bool> UaLv;
+typedef Field<SYS_INTSTS, 22, 1, bool> IaOc;
+typedef Field<SYS_INTSTS, 23, 1, bool> IaLc;
+typedef Field<SYS_INTSTS, 24, 1, bool> IbOc;
+typedef Field<SYS_INTSTS, 25, 1, bool> IbLc;
+typedef Field<SYS_INTSTS, 26, 1, bool> USwell;
+typedef Field<SYS_INTSTS, 27, 1, bool> UDip;
+} // namespace SysIntSts
+
+namespace SysSts {
+enum class ResetSource : uint8_t {
+    None = 0,
+    PowerOn = 1,
+    External = 2,
+    Rx = 3,
+    Software = 4,
+};
+
+typedef Field<SYS_STS, 0, 1, bool> CkErr;
+typedef Field<SYS_STS, 1, 1, bool> RefLk;
+typedef Field<SYS_STS, 2, 1, bool> Pd;
+typedef Field<SYS_STS, 4, 1, bool> RamInitial;
+typedef Field<SYS_STS, 5, 1, bool> BistErr;
+typedef Field<SYS_STS, 6, 1, bool> HseFail;
+typedef Field<SYS_STS, 20, 3, ResetSource> RstSource;
+typedef Field<SYS_STS, 23, 1, bool> UaOv;
+typedef Field<SYS_STS, 24, 1, bool> UaLv;
+typedef Field<SYS_STS, 25, 1, bool> IaOc;
+typedef Field<SYS_STS, 26, 1, bool> IaLc;
+typedef Field<SYS_STS, 27, 1, bool> IbOc;
+typedef Field<SYS_STS, 28, 1, bool> IbLc;
+typedef Field<SYS_STS, 29, 1, bool> USwell;
+typedef Field<SYS_STS, 30, 1, bool> UDip;
+} // namespace SysSts
+
+namespace SysMisc {
+typedef Field<SYS_MISC, 0, 1, bool> UartAutoEn;
+typedef Field<SYS_MISC, 1, 1, bool> UartBurstEn;
+typedef Field<SYS_MISC, 2, 1, bool> IntPol;
+typedef Field<SYS_MISC, 3, 1, bool> CkEgyEn;
+typedef Field<SYS_MISC, 16, 9, uint16_t> WaveStoreCnt;
+} // namespace SysMisc
+
+namespace SysRomCs {
+typedef Field<SYS_ROMCS, 31, 1, bool> CsMode;
+} // namespace SysRomCs
+
+namespace SysRamAddr {
+typedef Field<SYS_RAMADDR, 0, 11, uint16_t> Addr;
+typedef Field<SYS_RAMADDR, 14, 1, bool> Wr;
+typedef Field<SYS_RAMADDR, 15, 1, bool> Req;
+} // namespace SysRamAddr
+
+// ---------------------------------------------------------------------------
+// Compile-time consistency checks
+// ---------------------------------------------------------------------------
+
+constexpr bool TableIsIndexedByAddress() {
+    for (uint8_t i = 0; i < kRegisterCount; i++) {
+        if (kRegisters[i].address != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr uint8_t ChecksumSetSize() {
+    uint8_t size = 0;
+    for (uint8_t i = 0; i < kRegisterCount; i++) {
+        size += kRegisters[i].checksummed ? 1 : 0;
+    }
+    return size;
+}
+
+static_assert(TableIsIndexedByAddress(), "kRegisters must list every address in order");
+static_assert(Describe(0x80).address == kUnknownRegister.address && Describe(0xFF).address == kUnknownRegister.address,
+              "addresses past the register file must not alias a table entry");
+static_assert(!IsReadIdempotent(DAT_WAVE) && !IsReadIdempotent(SYS_RAMDATA) && IsReadIdempotent(SYS_INTSTS) &&
+                  !IsWritable(DAT_WAVE) && IsWritable(SYS_RAMDATA),
+              "reads with side effects must not be retried");
+static_assert(IsConfigurationBlock(DSP_ANA0, 8) && IsConfigurationBlock(DSP_CFG_CALI_PA, 22) &&
+                  IsConfigurationBlock(DSP_OV_THL, 12) && ChecksumSetSize() == 8 + 22 + 12,
+              "checksum set must be {0x00-0x07, 0x25-0x3A, 0x55-0x60}");
+
+static_assert(FieldsDisjoint<DspCtrl1::CalcEn1, DspCtrl1::CalcEn2, DspCtrl1::EgyLcEn, DspCtrl1::SlpMode>(),
+              "DSP_CTRL1 fields overlap");
+static_assert(FieldsDisjoint<DspCtrl2::InMode1, DspCtrl2::InMode2, DspCtrl2::InMode3, DspCtrl2::InMode4>(),
+              "DSP_CTRL2 fields overlap");
+static_assert(FieldsDisjoint<DspCtrl3::InMode5, DspCtrl3::InMode6, DspCtrl3::InMode7, DspCtrl3::InMode8>(),
+              "DSP_CTRL3 fields overlap");
+static_assert(FieldsDisjoint<DspCtrl5::DmaMode, DspCtrl5::DmaEn, DspCtrl5::SpiPha, DspCtrl5::SpiPol,
+                             DspCtrl5::SpCheck, DspCtrl5::WaveIb, DspCtrl5::WaveIa, DspCtrl5::WaveU,
+                             DspCtrl5::WaveLen, DspCtrl5::TrigUOv, DspCtrl5::TrigULv, DspCtrl5::TrigIaOc,
+                             DspCtrl5::TrigIaLc, DspCtrl5::TrigIbOc, DspCtrl5::TrigIbLc, DspCtrl5::TrigUSwell,
+                             DspCtrl5::TrigUDip, DspCtrl5::TrigManual, DspCtrl5::WaveMemMode,
+                             DspCtrl5::WaveAddrClr>(),
+              "DSP_CTRL5 fields overlap");
+static_assert(FieldsDisjoint<SysIntSts::PhsDone, SysIntSts::IntPdn, SysIntSts::AvgPwrUpd, SysIntSts::CurPwrUpd,
+                             SysIntSts::AvgRmsUpd, SysIntSts::CurRmsUpd, SysIntSts::WaveUpd, SysIntSts::WaveStore,
+                             SysIntSts::WaveOv, SysIntSts::USign, SysIntSts::ISign, SysIntSts::BistErr,
+                             SysIntSts::RefErr, SysIntSts::HseFail, SysIntSts::CkErr, SysIntSts::DmaFinish,
+                             SysIntSts::UartErr, SysIntSts::SpiErr, SysIntSts::UaOv, SysIntSts::UaLv,
+                             SysIntSts::IaOc, SysIntSts::IaLc, SysIntSts::IbOc, SysIntSts::IbLc, SysIntSts::USwell,
+                             SysIntSts::UDip>(),
+              "SYS_INTSTS fields overlap");
+static_assert(FieldsDisjoint<SysSts::CkErr, SysSts::RefLk, SysSts::Pd, SysSts::RamInitial, SysSts::BistErr,
+                             SysSts::HseFail, SysSts::RstSource, SysSts::UaOv, SysSts::UaLv, SysSts::IaOc,
+                             SysSts::IaLc, SysSts::IbOc, SysSts::IbLc, SysSts::USwell, SysSts::UDip>(),
+              "SYS_STS fields overlap");
+static_assert(FieldsDisjoint<SysMisc::UartAutoEn, SysMisc::UartBurstEn, SysMisc::IntPol, SysMisc::CkEgyEn,
+                             SysMisc::WaveStoreCnt>(),
+              "SYS_MISC fields overlap");
+static_assert(FieldsDisjoint<SysRamAddr::Addr, SysRamAddr::Wr, SysRamAddr::Req>(), "SYS_RAMADDR fields overlap");
+
+// The legacy macros must describe the same bits as the table.
+static_assert(DspCtrl5::DmaMode::mask == (uint32_t)DSP_CTRL5_DMAMODE_Msk, "DSP_CTRL5_DMAMODE_Msk");
+static_assert(Encode<DspCtrl5::DmaMode>(7) == (uint32_t)DSP_CTRL5_DMAMODE_7, "DSP_CTRL5_DMAMODE_7");
+static_assert(DspCtrl5::DmaEn::mask == (uint32_t)DSP_CTRL5_DMAEN, "DSP_CTRL5_DMAEN");
+static_assert(DspCtrl5::WaveLen::mask == (uint32_t)DSP_CTRL5_WAVE_LEN_Msk, "DSP_CTRL5_WAVE_LEN_Msk");
+static_assert(DspCtrl5::WaveMemMode::mask == (uint32_t)DSP_CTRL5_WAVEMEM_MODE_Msk, "DSP_CTRL5_WAVEMEM_MODE_Msk");
+static_assert(DspCtrl5::WaveAddrClr::mask == (uint32_t)DSP_CTRL5_WAVE_ADDR_CLR, "DSP_CTRL5_WAVE_ADDR_CLR");
+static_assert(DspCtrl5::TrigManual::mask == (uint32_t)DSP_CTRL5_TRIG_MANUAL, "DSP_CTRL5_TRIG_MANUAL");
+static_assert(DspCtrl2::InMode4::mask == (uint32_t)DSP_CTRL2_INMODE4_Msk, "DSP_CTRL2_INMODE4_Msk");
+static_assert(DspCtrl3::InMode8::mask == (uint32_t)DSP_CTRL3_INMODE8_Msk, "DSP_CTRL3_INMODE8_Msk");
+static_assert(SysIntSts::CkErr::mask == (uint32_t)SYS_INTSTS_CKERR, "SYS_INTSTS_CKERR");
+static_assert(SysIntSts::UDip::mask == (uint32_t)SYS_INTSTS_UDIP, "SYS_INTSTS_UDIP");
+static_assert(SysSts::RstSource::mask == (uint32_t)SYS_STS_RSTSOURCE, "SYS_STS_RSTSOURCE");
+static_assert(SysMisc::WaveStoreCnt::mask == (uint32_t)SYS_MISC_WAVESTORE_CNT_Msk, "SYS_MISC_WAVESTORE_CNT_Msk");
+static_assert(SysRamAddr::Addr::mask == (uint32_t)SYS_RAMADDR_ADDR, "SYS_RAMADDR_ADDR");
+
+} // namespace V93XX_RegisterMap
+
+#endif
@@ -168,8 +168,8 @@ enum V93XX_REG {
 ///
 /// DSP_CTRL2
 ///
-#define DSP_CTRL2_INMODE4_Msk   (3 << 30)
-#define DSP_CTRL2_INMODE4_CONST (2 << 30)
+#define DSP_CTRL2_INMODE4_Msk   (3U << 30)
+#define DSP_CTRL2_INMODE4_CONST (2U << 30)
 #define DSP_CTRL2_INMODE3_Msk   (3 << 22)
 #define DSP_CTRL2_INMODE3_CONST (2 << 22)
 #define DSP_CTRL2_INMODE2_Msk   (3 << 14)
@@ -179,8 +179,8 @@ enum V93XX_REG {
 ///
 /// DSP_CTRL3
 ///
-#define DSP_CTRL3_INMODE8_Msk   (uint32_t)(3 << 30)
-#define DSP_CTRL3_INMODE8_CONST (uint32_t)(2 << 30)
+#define DSP_CTRL3_INMODE8_Msk   (3U << 30)
+#define DSP_CTRL3_INMODE8_CONST (2U << 30)
 #define DSP_CTRL3_INMODE7_Msk   (3 << 22)
 #define DSP_CTRL3_INMODE7_CONST (2 << 22)
 #define DSP_CTRL3_INMODE6_Msk   (3 << 14)
@@ -197,15 +197,17 @@ enum V93XX_REG {
 #define DSP_CTRL5_DMAMODE_2                   (2 << DSP_CTRL5_DMAMODE_Pos)
 #define DSP_CTRL5_DMAMODE_3                   (3 << DSP_CTRL5_DMAMODE_Pos)
 #define DSP_CTRL5_DMAMODE_4                   (4 << DSP_CTRL5_DMAMODE_Pos)
-#define DSP_CTRL5_DMAMODE_5                   (4 << DSP_CTRL5_DMAMODE_Pos)
-#define DSP_CTRL5_DMAMODE_6                   (4 << DSP_CTRL5_DMAMODE_Pos)
-#define DSP_CTRL5_DMAMODE_7                   (4 << DSP_CTRL5_DMAMODE_Pos)
+#define DSP_CTRL5_DMAMODE_5                   (5 << DSP_CTRL5_DMAMODE_Pos)
+#define DSP_CTRL5_DMAMODE_6                   (6 << DSP_CTRL5_DMAMODE_Pos)
+#define DSP_CTRL5_DMAMODE_7                   (7 << DSP_CTRL5_DMAMODE_Pos)
+// Deprecated: DMA_CTRL is not a separate field, these alias DMAMODE[1:0] (DMA_CTRL_ENABLE == DMAMODE_1).
+// Values are kept so existing DSP_CTRL5 images and their checksums do not change; use DSP_CTRL5_DMAEN
+// to enable SPI DMA and DSP_CTRL5_DMAMODE_n to select the mode.
 #define DSP_CTRL5_DMA_CTRL_Pos                0
 #define DSP_CTRL5_DMA_CTRL_Msk                (3 << DSP_CTRL5_DMA_CTRL_Pos)
 #define DSP_CTRL5_DMA_CTRL_DISABLE            (0 << DSP_CTRL5_DMA_CTRL_Pos)
 #define DSP_CTRL5_DMA_CTRL_ENABLE             (1 << DSP_CTRL5_DMA_CTRL_Pos)
 #define DSP_CTRL5_DMA_CTRL_STOP               (2 << DSP_CTRL5_DMA_CTRL_Pos)
-#define DSP_CTRL5_DMAMODE_Msk                 (7 << DSP_CTRL5_DMAMODE_Pos)
 #define DSP_CTRL5_DMAEN                       (1 << 3)
 #define DSP_CTRL5_SPI_PHA                     (1 << 5)
 #define DSP_CTRL5_SPI_POL                     (1 << 6)
@@ -230,7 +232,7 @@ enum V93XX_REG {
 #define DSP_CTRL5_WAVEMEM_MODE_CYCLIC         (1 << DSP_CTRL5_WAVEMEM_MODE_Pos)
 #define DSP_CTRL5_WAVEMEM_MODE_TRIGGER_SINGLE (2 << DSP_CTRL5_WAVEMEM_MODE_Pos)
 #define DSP_CTRL5_WAVEMEM_MODE_DISABLE        (3 << DSP_CTRL5_WAVEMEM_MODE_Pos)
-#define DSP_CTRL5_WAVE_ADDR_CLR               (1 << 31)
+#define DSP_CTRL5_WAVE_ADDR_CLR               (1U << 31)
 ///
 /// SYS_INTSTS
 ///
@@ -299,7 +301,7 @@ enum V93XX_REG {
 ///
 /// SYS_ROMCS
 ///
-#define SYS_ROMCS_CSMODE ((uint32_t)(1 << 31))
+#define SYS_ROMCS_CSMODE (1U << 31)
 ///
 /// SYS_RAMADDR
 ///
@@ -1,53 +1,18 @@
 
 #include "V93XX_SPI.h"
 
-const uint8_t ControlAddresses[] = {
-    DSP_ANA0,  // Analog Control 0
-    DSP_ANA1,  // Analog Control 1
-    DSP_CTRL0, // Digital Control 0
-    DSP_CTRL1, // Digital Control 1
-    DSP_CTRL2, // Digital Control 2
-    DSP_CTRL3, // Digital Control 3
-    DSP_CTRL4, // Digital Control 4
-    DSP_CTRL5, // Digital Control 5
-};
-
-const uint8_t CalibrationAddresses[] = {
-    DSP_CFG_CALI_PA,    // Active power A ratio difference correction
-    DSP_CFG_DC_PA,      //  Active power A small signal correction
-    DSP_CFG_CALI_QA,    //	Reactive power A ratio difference correction
-    DSP_CFG_DC_QA,      //	Reactive power A small signal correction
-    DSP_CFG_CALI_PB,    //	Active power B ratio difference correction
-    DSP_CFG_DC_PB,      //	Active power B small signal correction
-    DSP_CFG_CALI_QB,    //	Reactive power B ratio difference correction
-    DSP_CFG_DC_QB,      //	Reactive power B small signal correction
-    DSP_CFG_CALI_RMSUA, //	Voltage RMS ratio correction
-    DSP_CFG_RMS_DCUA,   //	Voltage RMS small signal correction
-    DSP_CFG_CALI_RMSIA, //	Current A effective value ratio correction
-    DSP_CFG_RMS_DCIA,   //	Current A RMS small signal correction
-    DSP_CFG_CALI_RMSIB, //	Current B effective value ratio difference correction
-    DSP_CFG_RMS_DCIB,   //	Current B RMS small signal correction
-    DSP_CFG_PHC,        //	Angular error correction register
-    DSP_CFG_DCUA,       //	Voltage channel DC correction value
-    DSP_CFG_DCIA,       //	Current A channel DC correction value
-    DSP_CFG_DCIB,       //	Current B channel DC correction value
-    DSP_CFG_BPF,        //	Bandpass filter coefficients
-    DSP_CFG_CKSUM,      //	Checksum Configuration Registers
-    EGY_PROCTH,         //	Energy register anti-submarine threshold (less than it will not accumulate)
-    EGY_PWRTH,          //	Energy register accumulation threshold. Since the energy register is 46 bits
-};
-
-V93XX_SPI::V93XX_SPI(int cs_pin, SPIClass &spi_bus, uint32_t spi_freq)
+V93XX_SpiTransport::V93XX_SpiTransport(int cs_pin, SPIClass &spi_bus, uint32_t spi_freq)
     : spi_bus(spi_bus), cs_pin(cs_pin), spi_freq(spi_freq), spi_settings(spi_freq, MSBFIRST, SPI_MODE0) {}
 
-void V93XX_SPI::Init(WireMode wire_mode, bool initialize_interface, ChecksumMode checksum_mode) {
+void V93XX_SpiTransport::Init(WireMode wire_mode, bool initialize_interface, ChecksumMode checksum_mode) {
     Init(wire_mode, initialize_interface, checksum_mode, -1, -1, -1);
 }
 
-void V93XX_SPI::Init(WireMode wire_mode, bool initialize_interface, ChecksumMode checksum_mode, int8_t sck_pin,
-                     int8_t miso_pin, int8_t mosi_pin) {
+void V93XX_SpiTransport::Init(WireMode wire_mode, bool initialize_interface, ChecksumMode checksum_mode, int8_t sck_pin,
+                              int8_t miso_pin, int8_t mosi_pin) {
     this->wire_mode = wire_mode;
     this->checksum_mode = checksum_mode;
+    this->block_addr_valid = 0;
 
     pinMode(this->cs_pin, OUTPUT);
     digitalWrite(this->cs_pin, HIGH);
@@ -78,7 +43,7 @@ void V93XX_SPI::Init(WireMode wire_mode, bool initialize_interface, ChecksumMode
     }
 }
 
-inline void V93XX_SPI::BeginTransaction(uint8_t address) {
+inline void V93XX_SpiTransport::BeginTransaction(uint8_t address) {
     EnforceInterOpTiming();
 
     if (this->wire_mode == WireMode::ThreeWire) {
@@ -96,9 +61,12 @@ inline void V93XX_SPI::BeginTransaction(uint8_t address) {
         // 3-wire: CS is always low; ensure required SCK-low time before operation.
         digitalWrite(this->cs_pin, LOW);
     }
+    if (this->link_trace) {
+        this->link_trace->Select();
+    }
 }
 
-inline void V93XX_SPI::EndTransaction() {
+inline void V93XX_SpiTransport::EndTransaction() {
     this->spi_bus.endTransaction();
 
     if (this->wire_mode == WireMode::FourWire) {
@@ -109,32 +77,43 @@ inline void V93XX_SPI::EndTransaction() {
         digitalWrite(this->cs_pin, LOW);
     }
 
+    if (this->link_trace) {
+        this->link_trace->Deselect();
+    }
     this->last_op_end_us = micros();
 }
 
-uint8_t V93XX_SPI::CalculateCRC8(const uint8_t *data, size_t length) {
+inline uint8_t V93XX_SpiTransport::Transfer(uint8_t tx) {
+    uint8_t rx = this->spi_bus.transfer(tx);
+    if (this->link_trace) {
+        this->link_trace->Exchange(tx, rx);
+    }
+    return rx;
+}
+
+uint8_t V93XX_SpiTransport::CalculateCRC8(const uint8_t *data, size_t length) {
     // Datasheet "checksum": 0x33 + ~sum (8-bit arithmetic)
-    uint8_t checksum = 0;
+    V93XX_Frames::RunningChecksum checksum;
     for (size_t i = 0; i < length; i++) {
-        checksum += data[i];
+        checksum.Add(data[i]);
     }
-    return 0x33 + ~checksum;
+    return checksum.Expected();
 }
 
-uint8_t V93XX_SPI::BuildCmdByte(uint8_t address7, bool is_read) const {
+uint8_t V93XX_SpiTransport::BuildCmdByte(uint8_t address7, bool is_read) const {
     // CMD = (ADDR[6:0] << 1) | R/W
     // Example from datasheet: write to 0x7F => CMD = 0xFE
-    return (uint8_t)(((address7 & 0x7F) << 1) | (is_read ? 1 : 0));
+    return V93XX_Frames::SpiCmd(address7, is_read);
 }
 
-inline void V93XX_SPI::WriteLe32(uint8_t *dst, uint32_t value) {
+inline void V93XX_SpiTransport::WriteLe32(uint8_t *dst, uint32_t value) {
     dst[0] = (uint8_t)(value & 0xFF);
     dst[1] = (uint8_t)((value >> 8) & 0xFF);
     dst[2] = (uint8_t)((value >> 16) & 0xFF);
     dst[3] = (uint8_t)((value >> 24) & 0xFF);
 }
 
-void V93XX_SPI::EnforceInterOpTiming() {
+void V93XX_SpiTransport::EnforceInterOpTiming() {
     if (this->wire_mode == WireMode::FourWire) {
         // Datasheet: must be >=50us between any two operations.
         // Use end-of-last-operation timestamp.
@@ -146,7 +125,7 @@ void V93XX_SPI::EnforceInterOpTiming() {
     }
 }
 
-void V93XX_SPI::ApplyAddressOffsetModeIfNeeded(uint8_t address) {
+void V93XX_SpiTransport::ApplyAddressOffsetModeIfNeeded(uint8_t address) {
     // Datasheet: to access >=0x80, write magic to 0x7F to enable +0x80 offset.
     // For convenience, automatically enable offset when a high address is used.
     bool needs_high = (address & 0x80) != 0;
@@ -157,9 +136,9 @@ void V93XX_SPI::ApplyAddressOffsetModeIfNeeded(uint8_t address) {
     }
 }
 
-void V93XX_SPI::SetChecksumMode(ChecksumMode mode) { this->checksum_mode = mode; }
+void V93XX_SpiTransport::SetChecksumMode(ChecksumMode mode) { this->checksum_mode = mode; }
 
-bool V93XX_SPI::InitializeInterface() {
+bool V93XX_SpiTransport::InitializeInterface() {
     // Write 0x5A7896B4 to address 0x7F.
     // CMD for write to 0x7F => 0xFE.
     uint8_t frame[6];
@@ -170,7 +149,7 @@ bool V93XX_SPI::InitializeInterface() {
     for (int attempt = 0; attempt < 2; attempt++) {
         BeginTransaction(0x7F);
         for (size_t i = 0; i < sizeof(frame); i++) {
-            (void)this->spi_bus.transfer(frame[i]);
+            (void)Transfer(frame[i]);
         }
         EndTransaction();
 
@@ -199,7 +178,7 @@ bool V93XX_SPI::InitializeInterface() {
     return false;
 }
 
-bool V93XX_SPI::EnsureReady() {
+bool V93XX_SpiTransport::EnsureReady() {
     if (this->spi_ready) {
         return true;
     }
@@ -207,7 +186,7 @@ bool V93XX_SPI::EnsureReady() {
     return false;
 }
 
-void V93XX_SPI::SetHighAddressOffsetEnabled(bool enabled) {
+void V93XX_SpiTransport::SetHighAddressOffsetEnabled(bool enabled) {
     // Write magic values to 0x7F to enable/disable +0x80 offset mode.
     // Enable:  0x4A985B67
     // Disable: 0x76B589A4
@@ -218,18 +197,21 @@ void V93XX_SPI::SetHighAddressOffsetEnabled(bool enabled) {
     WriteLe32(&frame[1], magic);
     frame[5] = CalculateCRC8(frame, 5);
 
+    uint32_t start = this->link_stats.Begin();
     BeginTransaction(0x7F);
     for (size_t i = 0; i < sizeof(frame); i++) {
-        (void)this->spi_bus.transfer(frame[i]);
+        (void)Transfer(frame[i]);
     }
     EndTransaction();
+    this->link_stats.End(V93XX_Op::Write, start, V93XX_Status::Ok, sizeof(frame), 0);
+    this->link_stats.CountOffsetSwitch();
 
     this->high_address_offset_enabled = enabled;
 }
 
-void V93XX_SPI::RegisterWrite(uint8_t address, uint32_t data) { (void)RegisterWriteChecked(address, data); }
+void V93XX_SpiTransport::RegisterWrite(uint8_t address, uint32_t data) { (void)RegisterWriteChecked(address, data); }
 
-bool V93XX_SPI::RegisterWriteChecked(uint8_t address, uint32_t data) {
+bool V93XX_SpiTransport::RegisterWriteChecked(uint8_t address, uint32_t data) {
     ApplyAddressOffsetModeIfNeeded(address);
 
     uint8_t addr7 = (uint8_t)(address & 0x7F);
@@ -238,17 +220,19 @@ bool V93XX_SPI::RegisterWriteChecked(uint8_t address, uint32_t data) {
     WriteLe32(&frame[1], data);
     frame[5] = CalculateCRC8(frame, 5);
 
+    uint32_t start = this->link_stats.Begin();
     BeginTransaction(address);
     for (size_t i = 0; i < sizeof(frame); i++) {
-        (void)this->spi_bus.transfer(frame[i]);
+        (void)Transfer(frame[i]);
     }
     EndTransaction();
+    this->link_stats.End(V93XX_Op::Write, start, V93XX_Status::Ok, sizeof(frame), 0);
 
     // Datasheet: write operation does not return a valid response.
     return true;
 }
 
-uint32_t V93XX_SPI::RegisterRead(uint8_t address) {
+uint32_t V93XX_SpiTransport::RegisterRead(uint8_t address) {
     uint32_t value = 0;
     if (!EnsureReady()) {
         return 0;
@@ -257,7 +241,7 @@ uint32_t V93XX_SPI::RegisterRead(uint8_t address) {
     return value;
 }
 
-bool V93XX_SPI::RegisterReadChecked(uint8_t address, uint32_t &out_value) {
+bool V93XX_SpiTransport::RegisterReadChecked(uint8_t address, uint32_t &out_value) {
     if (!EnsureReady()) {
         out_value = 0;
         return false;
@@ -265,20 +249,30 @@ bool V93XX_SPI::RegisterReadChecked(uint8_t address, uint32_t &out_value) {
     return RegisterReadCheckedInternal(address, out_value);
 }
 
-bool V93XX_SPI::RegisterReadCheckedInternal(uint8_t address, uint32_t &out_value) {
+bool V93XX_SpiTransport::RegisterReadStrict(uint8_t address, uint32_t &out_value) {
+    uint8_t data_bytes[4] = {0};
+    uint8_t checksum_rx = 0;
+    bool checksum_ok = RegisterReadRawInternal(address, data_bytes, checksum_rx);
+    out_value = (uint32_t)data_bytes[0] | ((uint32_t)data_bytes[1] << 8) | ((uint32_t)data_bytes[2] << 16) |
+                ((uint32_t)data_bytes[3] << 24);
+    return checksum_ok;
+}
+
+bool V93XX_SpiTransport::RegisterReadCheckedInternal(uint8_t address, uint32_t &out_value) {
     uint8_t data_bytes[4] = {0};
     uint8_t checksum_rx = 0;
     bool checksum_ok = RegisterReadRawInternal(address, data_bytes, checksum_rx);
     bool ok = (this->checksum_mode == ChecksumMode::Dirty) ? true : checksum_ok;
     if (!ok) {
-        uint8_t expected = 0;
-        expected += BuildCmdByte((uint8_t)(address & 0x7F), true);
-        expected += data_bytes[0];
-        expected += data_bytes[1];
-        expected += data_bytes[2];
-        expected += data_bytes[3];
-        expected = 0x33 + (uint8_t)(~expected);
-        Serial.printf("RegisterRead(): Checksum invalid (expected: 0x%02X, received: 0x%02X)\n", expected, checksum_rx);
+        V93XX_Frames::RunningChecksum expected(V93XX_Frames::SpiCmd(address, true));
+        for (size_t i = 0; i < 4; i++) {
+            expected.Add(data_bytes[i]);
+        }
+        Serial.printf("RegisterRead(): Checksum invalid (expected: 0x%02X, received: 0x%02X)\n", expected.Expected(),
+                      checksum_rx);
+        // Clean mode never hands out data from a corrupt frame.
+        out_value = 0;
+        return false;
     }
 
     out_value = (uint32_t)data_bytes[0] | ((uint32_t)data_bytes[1] << 8) | ((uint32_t)data_bytes[2] << 16) |
@@ -286,46 +280,32 @@ bool V93XX_SPI::RegisterReadCheckedInternal(uint8_t address, uint32_t &out_value
     return ok;
 }
 
-bool V93XX_SPI::RegisterReadRawInternal(uint8_t address, uint8_t (&data_bytes)[4], uint8_t &checksum_rx) {
+bool V93XX_SpiTransport::RegisterReadRawInternal(uint8_t address, uint8_t (&data_bytes)[4], uint8_t &checksum_rx) {
     ApplyAddressOffsetModeIfNeeded(address);
 
-    uint8_t addr7 = (uint8_t)(address & 0x7F);
-    uint8_t tx[6] = {0};
-    uint8_t rx[6] = {0};
-    tx[0] = BuildCmdByte(addr7, true);
+    // The checksum covers CMD and the data bytes; it is accumulated while the data shifts in.
+    const uint8_t cmd = V93XX_Frames::SpiCmd(address, true);
+    V93XX_Frames::RunningChecksum checksum(cmd);
 
+    uint32_t start = this->link_stats.Begin();
     BeginTransaction(address);
-    for (size_t i = 0; i < sizeof(tx); i++) {
-        rx[i] = this->spi_bus.transfer(tx[i]);
+    (void)Transfer(cmd); // rx[0] is don't care
+    for (size_t i = 0; i < 4; i++) {
+        data_bytes[i] = Transfer(0x00);
+        checksum.Add(data_bytes[i]);
     }
+    checksum_rx = Transfer(0x00);
     EndTransaction();
 
-    // rx[0] is don't care. Data comes in rx[1..4], checksum in rx[5].
-    data_bytes[0] = rx[1];
-    data_bytes[1] = rx[2];
-    data_bytes[2] = rx[3];
-    data_bytes[3] = rx[4];
-    checksum_rx = rx[5];
-
-    uint8_t expected = 0;
-    expected += tx[0];
-    expected += data_bytes[0];
-    expected += data_bytes[1];
-    expected += data_bytes[2];
-    expected += data_bytes[3];
-    expected = 0x33 + (uint8_t)(~expected);
-
-    return (expected == checksum_rx);
+    bool checksum_ok = checksum.Matches(checksum_rx);
+    this->link_stats.End(V93XX_Op::Read, start, checksum_ok ? V93XX_Status::Ok : V93XX_Status::BadChecksum, 1, 5);
+    return checksum_ok;
 }
 
-void V93XX_SPI::ConfigureBlockRead(const uint8_t addresses[], uint8_t num_addresses) {
+void V93XX_SpiTransport::SetBlockReadView(const uint8_t addresses[], uint8_t num_addresses) {
     // NOTE: The chip's datasheet documents "block reading" as a UART feature (address mapping).
-    // The SPI section does not define a dedicated block-read command/frame. We keep the mapping
-    // registers configuration because it's useful documentation-wise and may be used by UART,
-    // but RegisterBlockRead() in this SPI driver is an emulation (sequential reads).
-
-    this->configured_block_addr_count = 0;
-
+    // The SPI section does not define a dedicated block-read command/frame. V93XX<> still programs
+    // the mapping registers, but RegisterBlockRead() in this SPI driver is an emulation (sequential reads).
     uint8_t copy_count = num_addresses;
     if (copy_count > 16) {
         copy_count = 16;
@@ -334,20 +314,9 @@ void V93XX_SPI::ConfigureBlockRead(const uint8_t addresses[], uint8_t num_addres
         this->configured_block_addrs[i] = addresses[i];
     }
     this->configured_block_addr_count = copy_count;
-
-    // Configure block read addresses in system registers (0x61-0x64)
-    uint8_t const *address_ptr = addresses;
-    for (int blk = 0; blk < 4; blk++) {
-        uint32_t combined_address = 0;
-        for (int i = 0; (i < 4) && (num_addresses); i++) {
-            combined_address |= (*address_ptr++ << (8 * i));
-            num_addresses--;
-        }
-        RegisterWrite(SYS_BLK_ADDR0 + blk, combined_address);
-    }
 }
 
-void V93XX_SPI::RegisterBlockRead(uint32_t (&values)[], uint8_t num_values) {
+void V93XX_SpiTransport::RegisterBlockRead(uint32_t (&values)[], uint8_t num_values) {
     if (!EnsureReady()) {
         for (uint8_t i = 0; i < num_values; i++) {
             values[i] = 0;
@@ -373,90 +342,54 @@ void V93XX_SPI::RegisterBlockRead(uint32_t (&values)[], uint8_t num_values) {
     }
 }
 
-bool V93XX_SPI::CaptureWaveform(uint32_t *buffer, size_t word_count, uint32_t ctrl5, uint32_t timeout_ms,
-                                uint8_t block_words) {
-    if (!EnsureReady()) {
-        return false;
-    }
-    if (!buffer || word_count == 0) {
-        return false;
-    }
-
-    RegisterWrite(SYS_INTSTS, SYS_INTSTS_WAVEOV | SYS_INTSTS_WAVESTORE | SYS_INTSTS_WAVEUPD);
-
-    uint32_t ctrl5_value = ctrl5 | DSP_CTRL5_WAVE_ADDR_CLR | DSP_CTRL5_TRIG_MANUAL;
-    RegisterWrite(DSP_CTRL5, ctrl5_value);
-
-    uint32_t start = millis();
-    bool overflow = false;
-    bool complete = false;
-    while ((millis() - start) < timeout_ms) {
-        uint32_t sys_intsts = RegisterRead(SYS_INTSTS);
-        if (sys_intsts & SYS_INTSTS_WAVEOV) {
-            overflow = true;
-            complete = true;
-            break;
-        }
-        if (sys_intsts & SYS_INTSTS_WAVESTORE) {
-            complete = true;
-            break;
-        }
-        delay(1);
-    }
-
-    if (!complete) {
-        return false;
-    }
-
-    uint16_t wavestore_cnt = (RegisterRead(SYS_MISC) & SYS_MISC_WAVESTORE_CNT_Msk) >> SYS_MISC_WAVESTORE_CNT_Pos;
-    if (wavestore_cnt > 0 && wavestore_cnt < word_count) {
-        word_count = wavestore_cnt;
-    }
-
-    uint8_t block_read_addrs[16];
-    for (size_t i = 0; i < 16; i++) {
-        block_read_addrs[i] = DAT_WAVE;
+V93XX_Status V93XX_SpiTransport::RegisterReadStatus(uint8_t address, uint32_t &out_value) {
+    if (!this->spi_ready) {
+        out_value = 0;
+        return V93XX_Status::NotReady;
     }
-    ConfigureBlockRead(block_read_addrs, 16);
-
-    uint8_t per_read = block_words;
-    if (per_read == 0 || per_read > 16) {
-        per_read = 16;
+    uint8_t data_bytes[4] = {0};
+    uint8_t checksum_rx = 0;
+    bool checksum_ok = RegisterReadRawInternal(address, data_bytes, checksum_rx);
+    if (!checksum_ok && this->checksum_mode == ChecksumMode::Clean) {
+        out_value = 0;
+    } else {
+        out_value = (uint32_t)data_bytes[0] | ((uint32_t)data_bytes[1] << 8) | ((uint32_t)data_bytes[2] << 16) |
+                    ((uint32_t)data_bytes[3] << 24);
     }
+    return checksum_ok ? V93XX_Status::Ok : V93XX_Status::BadChecksum;
+}
 
-    size_t index = 0;
-    size_t remaining = word_count;
-    while (remaining > 0) {
-        uint8_t read_size = (remaining < per_read) ? (uint8_t)remaining : per_read;
-        uint32_t data[16] = {0};
-        RegisterBlockRead(data, read_size);
-        for (uint8_t i = 0; i < read_size; i++) {
-            buffer[index++] = data[i];
-        }
-        remaining -= read_size;
+V93XX_Status V93XX_SpiTransport::RegisterWriteStatus(uint8_t address, uint32_t data) {
+    if (!this->spi_ready) {
+        return V93XX_Status::NotReady;
     }
-
-    return !overflow;
+    (void)RegisterWriteChecked(address, data);
+    return V93XX_Status::Ok;
 }
 
-void V93XX_SPI::LoadConfiguration(const V93XX_SPI::ControlRegisters &ctrl,
-                                  const V93XX_SPI::CalibrationRegisters &calibrations) {
-    uint32_t checksum = 0;
-
-    // Load control values [0x00 - 0x07]
-    for (int i = 0; i < sizeof(V93XX_SPI::ControlRegisters) / sizeof(uint32_t); i++) {
-        this->RegisterWrite(ControlAddresses[i], ctrl._array[i]);
-        checksum += ctrl._array[i];
+V93XX_Status V93XX_SpiTransport::RegisterBlockReadStatus(uint32_t (&values)[], uint8_t num_values) {
+    // Sequential reads of the configured view (see RegisterBlockRead()); the first failed read fails the block.
+    uint32_t start = this->link_stats.Begin();
+    V93XX_Status status = this->spi_ready ? V93XX_Status::Ok : V93XX_Status::NotReady;
+    uint8_t to_read = (num_values < this->configured_block_addr_count) ? num_values : this->configured_block_addr_count;
+    uint8_t filled = 0;
+    while (filled < to_read && status == V93XX_Status::Ok) {
+        status = RegisterReadStatus(this->configured_block_addrs[filled], values[filled]);
+        filled++;
+    }
+    if (status != V93XX_Status::Ok &&
+        !(status == V93XX_Status::BadChecksum && this->checksum_mode == ChecksumMode::Dirty)) {
+        filled = 0;
+    }
+    for (uint8_t i = filled; i < num_values; i++) {
+        values[i] = 0;
     }
+    this->link_stats.EndComposite(V93XX_Op::BlockRead, start);
+    return status;
+}
 
-    // Load calibration values [0x25 - 0x3a]
-    for (int i = 0; i < sizeof(V93XX_SPI::CalibrationRegisters) / sizeof(uint32_t); i++) {
-        this->RegisterWrite(CalibrationAddresses[i], calibrations._array[i]);
-        checksum += calibrations._array[i];
+void V93XX_SpiTransport::Recover() {
+    if (!this->spi_ready) {
+        (void)InitializeInterface();
     }
-
-    // The sum of {0x00-0x07, 0x25-0x3a, 0x55-0x60} Needs to equal 0xFFFFFFFF to pass self-check.
-    // Calculate DSP_CFG_CKSUM (0x38) to ensure this is the case
-    checksum = 0xFFFFFFFF - checksum;
-    this->RegisterWrite(DSP_CFG_CKSUM, checksum);
 }
@@ -1,17 +1,21 @@
 #ifndef V93XX_SPI_H__
 #define V93XX_SPI_H__
 
+#include "V93XX.h"
+#include "V93XX_Frames.h"
+#include "V93XX_LinkTrace.h"
+#include "V93XX_Stats.h"
 #include "V93XX_Registers.h"
 #include <Arduino.h>
 #include <SPI.h>
 
 /**
- * @brief Driver class for V9381 SPI interface
+ * @brief SPI transport policy for V93XX<>
  *
  * This class provides an SPI interface to communicate with the V9381 energy monitoring ASIC.
  * The V9381 supports SPI communication with configurable clock speeds and standard SPI modes.
  */
-class V93XX_SPI {
+class V93XX_SpiTransport {
   public:
     enum class WireMode : uint8_t {
         FourWire = 0,
@@ -23,52 +27,9 @@ class V93XX_SPI {
         Clean = 1,
     };
 
-    // Reuse register structures from UART version for compatibility
-    struct __attribute__((packed)) ControlRegisters {
-        union {
-            uint32_t _array[8];
-            struct {
-                uint32_t DSP_ANA0;
-                uint32_t DSP_ANA1;
-                uint32_t DSP_CTRL0;
-                uint32_t DSP_CTRL1;
-                uint32_t DSP_CTRL2;
-                uint32_t DSP_CTRL3;
-                uint32_t DSP_CTRL4;
-                uint32_t DSP_CTRL5;
-            };
-        };
-    };
-
-    struct __attribute__((packed)) CalibrationRegisters {
-        union {
-            uint32_t _array[22];
-            struct {
-                uint32_t DSP_CFG_CALI_PA;
-                uint32_t DSP_CFG_DC_PA;
-                uint32_t DSP_CFG_CALI_QA;
-                uint32_t DSP_CFG_DC_QA;
-                uint32_t DSP_CFG_CALI_PB;
-                uint32_t DSP_CFG_DC_PB;
-                uint32_t DSP_CFG_CALI_QB;
-                uint32_t DSP_CFG_DC_QB;
-                uint32_t DSP_CFG_CALI_RMSUA;
-                uint32_t DSP_CFG_RMS_DCUA;
-                uint32_t DSP_CFG_CALI_RMSIA;
-                uint32_t DSP_CFG_RMS_DCIA;
-                uint32_t DSP_CFG_CALI_RMSIB;
-                uint32_t DSP_CFG_RMS_DCIB;
-                uint32_t DSP_CFG_PHC;
-                uint32_t DSP_CFG_DCUA;
-                uint32_t DSP_CFG_DCIA;
-                uint32_t DSP_CFG_DCIB;
-                uint32_t DSP_CFG_BPF;
-                uint32_t DSP_CFG_CKSUM;
-                uint32_t EGY_PROCTH;
-                uint32_t EGY_PWRTH;
-            };
-        };
-    };
+    // The chip's mapped block read is a UART feature; RegisterBlockRead() issues sequential reads.
+    static constexpr bool kNativeBlockRead = false;
+    static constexpr uint32_t kInterBlockDelayMs = 0;
 
     /**
      * @brief Constructor for V9381 SPI driver
@@ -76,7 +37,7 @@ class V93XX_SPI {
      * @param spi_bus Reference to SPI bus (default SPIClass)
      * @param spi_freq SPI clock frequency in Hz (default 400kHz)
      */
-    V93XX_SPI(int cs_pin, SPIClass &spi_bus = SPI, uint32_t spi_freq = 400000);
+    V93XX_SpiTransport(int cs_pin, SPIClass &spi_bus = SPI, uint32_t spi_freq = 400000);
 
     /**
      * @brief Initialize SPI bus + chip-select behavior.
@@ -142,18 +103,12 @@ class V93XX_SPI {
     bool RegisterReadChecked(uint8_t address, uint32_t &out_value);
 
     /**
-     * @brief Configure registers for block read operation
-     * @param addresses Array of register addresses to read
-     * @param num_addresses Number of addresses in the array
-     *
-     * Note: The datasheet's "block reading" protocol is documented under UART.
-     * The SPI section does not define a dedicated block-read command/frame.
-     * This library keeps this API for convenience/compatibility; see RegisterBlockRead().
+     * @brief Read a register, requiring a valid frame checksum regardless of ChecksumMode.
      */
-    void ConfigureBlockRead(const uint8_t addresses[], uint8_t num_addresses);
+    bool RegisterReadStrict(uint8_t address, uint32_t &out_value);
 
     /**
-     * @brief Perform a block read of configured registers
+     * @brief Perform a block read of the registers given to ConfigureBlockRead()
      * @param values Array to store read values
      * @param num_values Number of values to read
      *
@@ -163,15 +118,44 @@ class V93XX_SPI {
      */
     void RegisterBlockRead(uint32_t (&values)[], uint8_t num_values);
 
-    bool CaptureWaveform(uint32_t *buffer, size_t word_count, uint32_t ctrl5, uint32_t timeout_ms = 1000,
-                         uint8_t block_words = 16);
+    /**
+     * @brief Single attempt with a V93XX_Status result; a failed frame yields 0 in Clean mode.
+     *
+     * SPI writes have no response: RegisterWriteStatus() reports Ok once the frame is sent
+     * (use V93XX_RetryPolicy::verify_writes for a read-back check).
+     */
+    V93XX_Status RegisterReadStatus(uint8_t address, uint32_t &out_value);
+    V93XX_Status RegisterWriteStatus(uint8_t address, uint32_t data);
+    V93XX_Status RegisterBlockReadStatus(uint32_t (&values)[], uint8_t num_values);
+
+    /**
+     * @brief Duration of one byte at the configured SCLK.
+     */
+    uint32_t ByteTimeUs() const { return (8000000UL + this->spi_freq - 1) / this->spi_freq; }
 
     /**
-     * @brief Load complete configuration (control and calibration registers)
-     * @param ctrl Control register values
-     * @param calibrations Calibration register values
+     * @brief Log every transferred byte pair and transaction boundary to a V93XX_LinkTrace (nullptr to stop).
      */
-    void LoadConfiguration(const ControlRegisters &ctrl, const CalibrationRegisters &calibrations);
+    void SetLinkTrace(V93XX_LinkTrace *trace) { this->link_trace = trace; }
+
+  protected:
+    // Last values written to SYS_BLK_ADDR0..3; bit n of block_addr_valid marks word n as known.
+    uint32_t block_addr_shadow[4] = {0};
+    uint8_t block_addr_valid = 0;
+
+    V93XX_StatsRecorder link_stats;
+
+    bool LinkReady() const { return this->spi_ready; }
+
+    /**
+     * @brief The chip may have fallen back to UART after a reset: redo the interface init if needed.
+     */
+    void Recover();
+
+    /**
+     * @brief Remember the mapped addresses so RegisterBlockRead() can read them one by one.
+     */
+    void SetBlockReadView(const uint8_t addresses[], uint8_t num_addresses);
 
   private:
     SPIClass &spi_bus;
@@ -184,6 +168,7 @@ class V93XX_SPI {
     bool high_address_offset_enabled = false;
     uint32_t last_op_end_us = 0;
     bool spi_ready = false;
+    V93XX_LinkTrace *link_trace = nullptr;
 
     uint8_t configured_block_addrs[16] = {0};
     uint8_t configured_block_addr_count = 0;
@@ -204,6 +189,11 @@ class V93XX_SPI {
     bool RegisterReadCheckedInternal(uint8_t address, uint32_t &out_value);
     bool RegisterReadRawInternal(uint8_t address, uint8_t (&data_bytes)[4], uint8_t &checksum_rx);
 
+    /**
+     * @brief One byte on the bus (traced when a V93XX_LinkTrace is attached)
+     */
+    inline uint8_t Transfer(uint8_t tx);
+
     /**
      * @brief Begin SPI transaction with chip select
      */
@@ -215,4 +205,6 @@ class V93XX_SPI {
     inline void EndTransaction();
 };
 
+typedef V93XX<V93XX_SpiTransport> V93XX_SPI;
+
 #endif
@@ -0,0 +1,364 @@
+#ifndef V93XX_SCHEDULER_H__
+#define V93XX_SCHEDULER_H__
+
+#include "V93XX_Registers.h"
+#include "V93XX_Status.h"
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Cooperative bus scheduler: periodic register reads by priority class, plus a waveform
+ * dump that is split into resumable DAT_WAVE chunks.
+ *
+ * Each Step() performs one short bus operation: the most urgent due read (Metering before Normal
+ * before Bulk, oldest first within a class), otherwise the next step of the waveform dump. A
+ * waveform chunk is sized so that it ends no later than the max metering latency after the next
+ * Metering read falls due, so a 300-word capture over UART no longer holds off energy and RMS
+ * polls for more than a second; it just completes over more Step() calls.
+ *
+ * Chunk durations start from the transport's frame timing (ByteTimeUs()) and are corrected
+ * upwards from measured chunks. The guarantee covers bulk work only: Metering reads due at the
+ * same time still run one after another.
+ *
+ * Works with V93XX_UART and V93XX_SPI.
+ */
+template <typename Device> class V93XX_Scheduler {
+  public:
+    static constexpr uint8_t kMaxReads = 8;
+
+    enum class Priority : uint8_t {
+        Metering = 0, // Energy, RMS, power: bounded latency
+        Normal,
+        Bulk, // Runs only when nothing else is due (interleaved with waveform chunks)
+    };
+    static constexpr size_t kPriorityCount = (size_t)Priority::Bulk + 1;
+
+    enum class WaveformState : uint8_t {
+        Idle = 0,
+        Waiting,  // Armed, polling SYS_INTSTS for WAVESTORE
+        Reading,  // Reading DAT_WAVE in chunks
+        Done,     // All words read
+        Overflow, // All words read, but the chip reported WAVEOV
+        TimedOut, // WAVESTORE did not arrive within the timeout
+        Failed,   // All chunks attempted, WaveformFailedChunks() of them failed (their words are not valid)
+    };
+
+    /**
+     * @brief Result of one periodic read.
+     * @param values Registers first_address..first_address + count - 1 (kept from the last good read on failure)
+     */
+    typedef void (*ReadHandler)(uint8_t first_address, const uint32_t *values, uint8_t count, V93XX_Status status,
+                                void *context);
+
+    /**
+     * @brief Called once when a waveform dump finishes (Done, Overflow, TimedOut or Failed).
+     */
+    typedef void (*WaveformHandler)(WaveformState state, size_t words, void *context);
+
+    explicit V93XX_Scheduler(Device &device) : device(device) {}
+
+    /**
+     * @brief Longest a due Metering read may wait behind bulk work (default 50 ms).
+     */
+    void SetMaxMeteringLatencyMs(uint32_t latency_ms) { this->max_metering_latency_ms = latency_ms; }
+    uint32_t MaxMeteringLatencyMs() const { return this->max_metering_latency_ms; }
+
+    /**
+     * @brief Read @p count (1-16) registers from @p first_address every @p period_ms.
+     * @return Read index, or -1 if the table is full or the range is invalid
+     */
+    int8_t AddRead(uint8_t first_address, uint8_t count, uint32_t period_ms, Priority priority, ReadHandler handler,
+                   void *context = nullptr) {
+        if (this->read_count >= kMaxReads || !handler || count == 0 || count > 16 || first_address + count > 0x80) {
+            return -1;
+        }
+        Read &read = this->reads[this->read_count];
+        read.first = first_address;
+        read.count = count;
+        read.priority = priority;
+        read.period_ms = period_ms;
+        read.next_due_ms = millis();
+        read.handler = handler;
+        read.context = context;
+        return (int8_t)this->read_count++;
+    }
+
+    /**
+     * @brief Arm a manual capture (see CaptureWaveform()) and dump it over the following Step() calls.
+     * @param buffer Must stay valid until the dump finishes or is cancelled
+     * @return false if a dump is already in progress, the arguments are invalid or arming failed
+     */
+    bool StartWaveform(uint32_t *buffer, size_t word_count, uint32_t ctrl5, uint32_t timeout_ms = 1000,
+                       WaveformHandler handler = nullptr, void *context = nullptr) {
+        if (WaveformBusy() || !buffer || word_count == 0) {
+            return false;
+        }
+        this->wave.buffer = buffer;
+        this->wave.total = word_count;
+        this->wave.index = 0;
+        this->wave.timeout_ms = timeout_ms;
+        this->wave.handler = handler;
+        this->wave.context = context;
+        this->wave.overflow = false;
+        this->wave.counted = false;
+        this->wave.mapped = false;
+        this->wave.failed_chunks = 0;
+
+        const uint32_t byte_us = this->device.ByteTimeUs();
+        if constexpr (Device::kNativeBlockRead) {
+            // Request (4 bytes) + checksum, then marker + 4 data bytes per word.
+            this->chunk_fixed_us = 5 * byte_us;
+            this->chunk_word_us = 5 * byte_us;
+        } else {
+            // One 6-byte read frame per word.
+            this->chunk_fixed_us = 0;
+            this->chunk_word_us = 6 * byte_us;
+        }
+        this->chunk_fixed_us += Device::kInterBlockDelayMs * 1000UL;
+
+        if (this->device.ArmWaveformCapture(ctrl5) != V93XX_Status::Ok) {
+            return false;
+        }
+        this->wave.start_ms = millis();
+        this->wave.last_poll_ms = this->wave.start_ms;
+        this->wave_state = WaveformState::Waiting;
+        return true;
+    }
+
+    /**
+     * @brief Abandon the dump in progress (the handler is not called).
+     */
+    void CancelWaveform() {
+        if (WaveformBusy()) {
+            this->wave_state = WaveformState::Idle;
+        }
+    }
+
+    WaveformState Waveform() const { return this->wave_state; }
+    bool WaveformBusy() const {
+        return this->wave_state == WaveformState::Waiting || this->wave_state == WaveformState::Reading;
+    }
+
+    /**
+     * @brief Words of the current (or last) dump read so far.
+     */
+    size_t WaveformWords() const { return this->wave.index; }
+
+    /**
+     * @brief DAT_WAVE chunks of the current (or last) dump whose read failed. Each DAT_WAVE read
+     * advances the chip's pointer, so a failed chunk cannot be read again; the dump goes on and
+     * ends as Failed.
+     */
+    uint16_t WaveformFailedChunks() const { return this->wave.failed_chunks; }
+
+    /**
+     * @brief Perform the next bus operation, if any is due.
+     * @return false if there was nothing to do
+     */
+    bool Step() {
+        uint32_t now = millis();
+        int8_t due = NextDueRead(now);
+        if (due >= 0) {
+            RunRead((uint8_t)due, now);
+            return true;
+        }
+        if (WaveformBusy()) {
+            return WaveformStep(now);
+        }
+        return false;
+    }
+
+    /**
+     * @brief Longest observed wait between a read falling due and starting, per priority class.
+     */
+    uint32_t MaxLatencyMs(Priority priority) const { return this->max_latency_ms[(size_t)priority]; }
+    void ResetLatency() {
+        for (uint32_t &latency : this->max_latency_ms) {
+            latency = 0;
+        }
+    }
+
+  private:
+    struct Read {
+        uint8_t first;
+        uint8_t count;
+        Priority priority;
+        uint32_t period_ms;
+        uint32_t next_due_ms;
+        ReadHandler handler;
+        void *context;
+        uint32_t values[16];
+    };
+
+    struct WaveformJob {
+        uint32_t *buffer = nullptr;
+        size_t total = 0;
+        size_t index = 0;
+        uint32_t start_ms = 0;
+        uint32_t last_poll_ms = 0;
+        uint32_t timeout_ms = 0;
+        WaveformHandler handler = nullptr;
+        void *context = nullptr;
+        bool overflow = false;
+        bool counted = false; // SYS_MISC.WAVESTORE_CNT has been read
+        bool mapped = false;  // Block-read window holds DAT_WAVE
+        uint16_t failed_chunks = 0;
+    };
+
+    Device &device;
+    Read reads[kMaxReads] = {};
+    uint8_t read_count = 0;
+    uint32_t max_metering_latency_ms = 50;
+    uint32_t max_latency_ms[kPriorityCount] = {0};
+
+    WaveformJob wave;
+    WaveformState wave_state = WaveformState::Idle;
+    uint32_t chunk_fixed_us = 0; // Per-chunk cost (request, checksum, inter-block delay)
+    uint32_t chunk_word_us = 0;  // Per-word cost, raised when a chunk takes longer than estimated
+
+    int8_t NextDueRead(uint32_t now) const {
+        int8_t best = -1;
+        for (uint8_t i = 0; i < this->read_count; i++) {
+            const Read &read = this->reads[i];
+            if ((int32_t)(now - read.next_due_ms) < 0) {
+                continue;
+            }
+            if (best < 0 || read.priority < this->reads[best].priority ||
+                (read.priority == this->reads[best].priority &&
+                 (int32_t)(read.next_due_ms - this->reads[best].next_due_ms) < 0)) {
+                best = (int8_t)i;
+            }
+        }
+        return best;
+    }
+
+    void RunRead(uint8_t index, uint32_t now) {
+        Read &read = this->reads[index];
+        uint32_t &worst = this->max_latency_ms[(size_t)read.priority];
+        worst = (now - read.next_due_ms > worst) ? now - read.next_due_ms : worst;
+
+        V93XX_Status status;
+        if (read.count == 1) {
+            V93XX_Result<uint32_t> result = this->device.RegisterReadWithRetry(read.first);
+            status = result.status;
+            if (result.Ok()) {
+                read.values[0] = result.value;
+            }
+        } else {
+            uint8_t addresses[16];
+            uint32_t values[16] = {0};
+            for (uint8_t i = 0; i < read.count; i++) {
+                addresses[i] = (uint8_t)(read.first + i);
+            }
+            status = this->device.ConfigureBlockRead(addresses, read.count);
+            this->wave.mapped = false;
+            if (status == V93XX_Status::Ok) {
+                status = this->device.RegisterBlockReadWithRetry(values, read.count);
+            }
+            if (status == V93XX_Status::Ok) {
+                for (uint8_t i = 0; i < read.count; i++) {
+                    read.values[i] = values[i];
+                }
+            }
+        }
+
+        read.next_due_ms += read.period_ms;
+        if ((int32_t)(now - read.next_due_ms) >= 0) {
+            // Overran a whole period: skip the missed reads rather than bursting.
+            read.next_due_ms = now + read.period_ms;
+        }
+        read.handler(read.first, read.values, read.count, status, read.context);
+    }
+
+    bool WaveformStep(uint32_t now) {
+        if (this->wave_state == WaveformState::Waiting) {
+            if (now == this->wave.last_poll_ms) {
+                return false; // Poll SYS_INTSTS at most once per millisecond, like CaptureWaveform()
+            }
+            this->wave.last_poll_ms = now;
+            uint32_t sys_intsts = 0;
+            (void)this->device.ReadInterruptStatus(sys_intsts); // 0 if the read failed
+            if (sys_intsts & (SYS_INTSTS_WAVEOV | SYS_INTSTS_WAVESTORE)) {
+                this->wave.overflow = (sys_intsts & SYS_INTSTS_WAVEOV) != 0;
+                this->wave_state = WaveformState::Reading;
+            } else if (now - this->wave.start_ms >= this->wave.timeout_ms) {
+                FinishWaveform(WaveformState::TimedOut);
+            }
+            return true;
+        }
+
+        if (!this->wave.counted) {
+            this->wave.total = this->device.StoredWaveformWords(this->wave.total);
+            this->wave.counted = true;
+            return true;
+        }
+        if (!this->wave.mapped) {
+            // Separate step: restoring the mapping after a block read costs up to four register writes.
+            // A failed mapping write is repeated on the next step.
+            this->wave.mapped = this->device.MapWaveformBlock() == V93XX_Status::Ok;
+            return true;
+        }
+
+        uint8_t words = ChunkWords(now);
+        uint32_t start_us = micros();
+        V93XX_Status status = this->device.ReadWaveformBlock(this->wave.buffer + this->wave.index, words);
+        uint32_t elapsed_us = micros() - start_us;
+        if (status != V93XX_Status::Ok && this->wave.failed_chunks < UINT16_MAX) {
+            this->wave.failed_chunks++;
+        }
+        if (elapsed_us > ChunkUs(words)) {
+            this->chunk_word_us = (elapsed_us - this->chunk_fixed_us + words - 1) / words;
+        }
+
+        this->wave.index += words;
+        if (this->wave.index >= this->wave.total) {
+            if (this->wave.failed_chunks > 0) {
+                FinishWaveform(WaveformState::Failed);
+            } else {
+                FinishWaveform(this->wave.overflow ? WaveformState::Overflow : WaveformState::Done);
+            }
+        }
+        return true;
+    }
+
+    uint32_t ChunkUs(uint8_t words) const { return this->chunk_fixed_us + (uint32_t)words * this->chunk_word_us; }
+
+    /**
+     * @brief Largest chunk that ends within the metering latency budget (at least one word).
+     */
+    uint8_t ChunkWords(uint32_t now) const {
+        size_t remaining = this->wave.total - this->wave.index;
+        uint8_t words = (remaining < 16) ? (uint8_t)remaining : 16;
+
+        bool metering = false;
+        uint32_t until_due_ms = UINT32_MAX;
+        for (uint8_t i = 0; i < this->read_count; i++) {
+            const Read &read = this->reads[i];
+            if (read.priority != Priority::Metering) {
+                continue;
+            }
+            metering = true;
+            uint32_t until = ((int32_t)(read.next_due_ms - now) > 0) ? read.next_due_ms - now : 0;
+            until_due_ms = (until < until_due_ms) ? until : until_due_ms;
+        }
+        if (!metering) {
+            return words;
+        }
+
+        uint64_t budget_us = ((uint64_t)until_due_ms + this->max_metering_latency_ms) * 1000ULL;
+        while (words > 1 && ChunkUs(words) > budget_us) {
+            words--;
+        }
+        return words;
+    }
+
+    void FinishWaveform(WaveformState state) {
+        this->wave_state = state;
+        if (this->wave.handler) {
+            this->wave.handler(state, this->wave.index, this->wave.context);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,123 @@
+#include "V93XX_Stats.h"
+
+#include <stdio.h>
+
+static const char *const kOpNames[kV93XX_OpCount] = {"read", "write", "block"};
+
+uint8_t V93XX_LatencyHistogram::BucketOf(uint32_t duration_us) {
+    uint8_t bucket = 0;
+    while (duration_us > 1 && bucket < kBuckets - 1) {
+        duration_us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void V93XX_LatencyHistogram::Record(uint32_t duration_us) {
+    this->counts[BucketOf(duration_us)]++;
+    if (this->samples == 0 || duration_us < this->min_us) {
+        this->min_us = duration_us;
+    }
+    if (duration_us > this->max_us) {
+        this->max_us = duration_us;
+    }
+    this->samples++;
+    this->total_us += duration_us;
+}
+
+uint32_t V93XX_LatencyHistogram::PercentileUs(uint8_t percent) const {
+    if (this->samples == 0) {
+        return 0;
+    }
+    if (percent > 100) {
+        percent = 100;
+    }
+    // Rank of the requested sample, rounded up (at least the first sample).
+    uint64_t rank = ((uint64_t)this->samples * percent + 99) / 100;
+    if (rank == 0) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (uint8_t bucket = 0; bucket < kBuckets; bucket++) {
+        seen += this->counts[bucket];
+        if (seen >= rank) {
+            uint32_t upper = (bucket == kBuckets - 1) ? this->max_us : ((2UL << bucket) - 1);
+            return (upper < this->max_us) ? upper : this->max_us;
+        }
+    }
+    return this->max_us;
+}
+
+static uint8_t *PutLe32(uint8_t *dst, uint32_t value) {
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+    dst[2] = (uint8_t)(value >> 16);
+    dst[3] = (uint8_t)(value >> 24);
+    return dst + 4;
+}
+
+static uint8_t *PutLe64(uint8_t *dst, uint64_t value) {
+    dst = PutLe32(dst, (uint32_t)value);
+    return PutLe32(dst, (uint32_t)(value >> 32));
+}
+
+size_t V93XX_LinkStats::Serialize(uint8_t *buffer, size_t capacity) const {
+    if (!buffer || capacity < kSerializedSize) {
+        return 0;
+    }
+    uint8_t *cursor = PutLe32(buffer, kMagic);
+    *cursor++ = kFormatVersion;
+    *cursor++ = (uint8_t)kV93XX_OpCount;
+    *cursor++ = V93XX_LatencyHistogram::kBuckets;
+    *cursor++ = 0;
+
+    const uint32_t counters[] = {this->timeouts,        this->crc_errors, this->framing_errors, this->retries,
+                                 this->offset_switches, this->bytes_tx,   this->bytes_rx};
+    for (uint32_t counter : counters) {
+        cursor = PutLe32(cursor, counter);
+    }
+    cursor = PutLe64(cursor, this->busy_us);
+
+    for (const V93XX_LatencyHistogram &histogram : this->latency) {
+        cursor = PutLe32(cursor, histogram.samples);
+        cursor = PutLe32(cursor, histogram.min_us);
+        cursor = PutLe32(cursor, histogram.max_us);
+        cursor = PutLe64(cursor, histogram.total_us);
+        for (uint32_t count : histogram.counts) {
+            cursor = PutLe32(cursor, count);
+        }
+    }
+    return (size_t)(cursor - buffer);
+}
+
+size_t V93XX_LinkStats::Format(char *buffer, size_t capacity) const {
+    if (!buffer || capacity == 0) {
+        return 0;
+    }
+    size_t used = 0;
+    for (size_t op = 0; op < kV93XX_OpCount && used < capacity; op++) {
+        const V93XX_LatencyHistogram &histogram = this->latency[op];
+        int written = snprintf(buffer + used, capacity - used,
+                               "%-5s n=%lu min=%lu p50<=%lu p99<=%lu max=%lu mean=%lu us\n", kOpNames[op],
+                               (unsigned long)histogram.samples, (unsigned long)histogram.min_us,
+                               (unsigned long)histogram.PercentileUs(50), (unsigned long)histogram.PercentileUs(99),
+                               (unsigned long)histogram.max_us, (unsigned long)histogram.MeanUs());
+        if (written < 0) {
+            break;
+        }
+        used += (size_t)written;
+    }
+    if (used < capacity) {
+        int written = snprintf(buffer + used, capacity - used,
+                               "timeouts=%lu crc=%lu framing=%lu retries=%lu offset_switches=%lu tx=%lu rx=%lu "
+                               "throughput=%.0f B/s\n",
+                               (unsigned long)this->timeouts, (unsigned long)this->crc_errors,
+                               (unsigned long)this->framing_errors, (unsigned long)this->retries,
+                               (unsigned long)this->offset_switches, (unsigned long)this->bytes_tx,
+                               (unsigned long)this->bytes_rx, (double)ThroughputBytesPerSecond());
+        if (written > 0) {
+            used += (size_t)written;
+        }
+    }
+    return (used < capacity) ? used : capacity - 1;
+}
@@ -0,0 +1,154 @@
+#ifndef V93XX_STATS_H__
+#define V93XX_STATS_H__
+
+#include "V93XX_Status.h"
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Define as 1 (e.g. -DV93XX_ENABLE_STATS=1 in build_flags) to record link statistics.
+// With 0 the recorder is an empty class whose calls inline away.
+#ifndef V93XX_ENABLE_STATS
+#define V93XX_ENABLE_STATS 0
+#endif
+
+enum class V93XX_Op : uint8_t {
+    Read = 0,
+    Write,
+    BlockRead,
+};
+
+constexpr size_t kV93XX_OpCount = (size_t)V93XX_Op::BlockRead + 1;
+
+/**
+ * @brief Fixed-size log2 latency histogram: bucket b counts durations in [2^b, 2^(b+1)) µs.
+ *
+ * Bucket 0 also holds 0 µs; the last bucket holds everything from 2^19 µs (~0.5 s) up.
+ */
+struct V93XX_LatencyHistogram {
+    static constexpr uint8_t kBuckets = 20;
+
+    uint32_t counts[kBuckets] = {0};
+    uint32_t samples = 0;
+    uint32_t min_us = 0;
+    uint32_t max_us = 0;
+    uint64_t total_us = 0;
+
+    void Record(uint32_t duration_us);
+
+    /**
+     * @brief Upper bound of the bucket holding the @p percent-th sample (clamped to max_us).
+     */
+    uint32_t PercentileUs(uint8_t percent) const;
+
+    uint32_t MeanUs() const { return this->samples ? (uint32_t)(this->total_us / this->samples) : 0; }
+
+    static uint8_t BucketOf(uint32_t duration_us);
+};
+
+/**
+ * @brief Link health counters and per-operation latency of one driver instance.
+ *
+ * Serialize() writes a compact little-endian dump:
+ *   uint32 magic "V93S" (0x53333956), uint8 version (1), uint8 op_count, uint8 bucket_count, uint8 reserved
+ *   uint32 timeouts, crc_errors, framing_errors, retries, offset_switches, bytes_tx, bytes_rx
+ *   uint64 busy_us
+ *   per op (Read, Write, BlockRead): uint32 samples, min_us, max_us, uint64 total_us, uint32 counts[bucket_count]
+ */
+struct V93XX_LinkStats {
+    static constexpr uint32_t kMagic = 0x53333956UL;
+    static constexpr uint8_t kFormatVersion = 1;
+    static constexpr size_t kSerializedSize =
+        8 + 7 * 4 + 8 + kV93XX_OpCount * (3 * 4 + 8 + V93XX_LatencyHistogram::kBuckets * 4);
+
+    V93XX_LatencyHistogram latency[kV93XX_OpCount];
+    uint32_t timeouts = 0;        // NoResponse or Truncated frames
+    uint32_t crc_errors = 0;      // BadChecksum frames
+    uint32_t framing_errors = 0;  // BadMarker or Overrun frames (UART)
+    uint32_t retries = 0;         // Attempts repeated by the *WithRetry() operations
+    uint32_t offset_switches = 0; // SPI +0x80 address offset mode changes
+    uint32_t bytes_tx = 0;
+    uint32_t bytes_rx = 0;
+    uint64_t busy_us = 0; // Time spent inside recorded operations
+
+    /**
+     * @brief Bytes moved per second of bus time.
+     */
+    float ThroughputBytesPerSecond() const {
+        return this->busy_us ? (float)(this->bytes_tx + this->bytes_rx) * 1e6f / (float)this->busy_us : 0.0f;
+    }
+
+    /**
+     * @return Bytes written, or 0 if @p capacity is below kSerializedSize.
+     */
+    size_t Serialize(uint8_t *buffer, size_t capacity) const;
+
+    /**
+     * @brief One line per operation plus one line of counters, NUL-terminated.
+     * @return Characters written (excluding the terminator), truncated to @p capacity - 1.
+     */
+    size_t Format(char *buffer, size_t capacity) const;
+};
+
+#if V93XX_ENABLE_STATS
+/**
+ * @brief Recording side used by the transports and V93XX<>.
+ */
+class V93XX_StatsRecorder {
+  public:
+    uint32_t Begin() const { return micros(); }
+
+    void End(V93XX_Op op, uint32_t start_us, V93XX_Status status, size_t tx_bytes, size_t rx_bytes) {
+        uint32_t duration = micros() - start_us;
+        this->stats.latency[(size_t)op].Record(duration);
+        this->stats.busy_us += duration;
+        this->stats.bytes_tx += tx_bytes;
+        this->stats.bytes_rx += rx_bytes;
+        switch (status) {
+        case V93XX_Status::NoResponse:
+        case V93XX_Status::Truncated:
+            this->stats.timeouts++;
+            break;
+        case V93XX_Status::BadChecksum:
+            this->stats.crc_errors++;
+            break;
+        case V93XX_Status::BadMarker:
+        case V93XX_Status::Overrun:
+            this->stats.framing_errors++;
+            break;
+        default:
+            break;
+        }
+    }
+
+    /**
+     * @brief Latency only, for composite operations whose frames are recorded individually.
+     */
+    void EndComposite(V93XX_Op op, uint32_t start_us) { this->stats.latency[(size_t)op].Record(micros() - start_us); }
+
+    void CountRetry() { this->stats.retries++; }
+    void CountOffsetSwitch() { this->stats.offset_switches++; }
+
+    const V93XX_LinkStats &Stats() const { return this->stats; }
+    void Reset() { this->stats = V93XX_LinkStats(); }
+
+  private:
+    V93XX_LinkStats stats;
+};
+#else
+class V93XX_StatsRecorder {
+  public:
+    uint32_t Begin() const { return 0; }
+    void End(V93XX_Op, uint32_t, V93XX_Status, size_t, size_t) {}
+    void EndComposite(V93XX_Op, uint32_t) {}
+    void CountRetry() {}
+    void CountOffsetSwitch() {}
+    const V93XX_LinkStats &Stats() const {
+        static const V93XX_LinkStats empty;
+        return empty;
+    }
+    void Reset() {}
+};
+#endif
+
+#endif
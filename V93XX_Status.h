@@ -0,0 +1,55 @@
+#ifndef V93XX_STATUS_H__
+#define V93XX_STATUS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Outcome of one bus exchange, or of a retried operation.
+ */
+enum class V93XX_Status : uint8_t {
+    Ok = 0,
+    NoResponse,      // Nothing arrived before the deadline
+    Truncated,       // Fewer bytes than the request's response length arrived
+    BadMarker,       // A block-read word did not start with 0x7D (UART)
+    BadChecksum,     // Complete frame, checksum mismatch
+    Overrun,         // RX buffer overflowed while the response arrived (UART)
+    NotReady,        // Link not initialized (SPI interface init failed)
+    VerifyMismatch,  // Write read back a different value
+    InvalidArgument, // Rejected before any bus traffic (null buffer, range outside the chip)
+};
+
+constexpr size_t kV93XX_StatusCount = (size_t)V93XX_Status::InvalidArgument + 1;
+
+/**
+ * @brief Value plus the status it was obtained with.
+ *
+ * In ChecksumMode::Clean value is 0 unless status is Ok; in Dirty mode a BadChecksum result
+ * still carries the received data.
+ */
+template <typename T> struct V93XX_Result {
+    V93XX_Status status = V93XX_Status::NoResponse;
+    T value = T();
+    uint8_t attempts = 0;
+
+    bool Ok() const { return this->status == V93XX_Status::Ok; }
+};
+
+/**
+ * @brief Bounded retry for the *WithRetry() operations of V93XX<>.
+ */
+struct V93XX_RetryPolicy {
+    uint8_t max_attempts = 3;        // Total attempts including the first (1 = no retry)
+    uint16_t backoff_byte_times = 8; // Pause before retry n is n * backoff_byte_times byte times
+    bool verify_writes = false;      // Read back ReadWrite registers after writing them
+};
+
+struct V93XX_RetryCounters {
+    uint32_t operations = 0;                   // *WithRetry() calls
+    uint32_t retries = 0;                      // Attempts beyond the first
+    uint32_t recovered = 0;                    // Operations that succeeded after at least one retry
+    uint32_t failures = 0;                     // Operations that ran out of attempts (or were not retryable)
+    uint32_t errors[kV93XX_StatusCount] = {0}; // Failed attempts by status (errors[Ok] stays 0)
+};
+
+#endif
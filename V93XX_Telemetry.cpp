@@ -0,0 +1,160 @@
+#include "V93XX_Telemetry.h"
+
+static uint16_t Crc16Update(uint16_t crc, uint8_t byte) {
+    crc ^= (uint16_t)byte << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+void V93XX_Telemetry::Begin(Writer writer, void *context, uint32_t (*clock)()) {
+    this->writer = writer;
+    this->context = context;
+    this->clock = clock;
+    this->sequence = 0;
+    this->capture_id = 0;
+    this->bytes_written = 0;
+}
+
+void V93XX_Telemetry::BeginCapture(uint32_t ctrl5) {
+    this->capture_id++;
+    this->capture_ctrl5 = ctrl5;
+    if (this->encoder) {
+        this->encoder->Reset();
+    }
+}
+
+bool V93XX_Telemetry::SendWaveformChunk(const V93XX_WaveformChunk &chunk) {
+    if (!this->writer) {
+        return false;
+    }
+    uint8_t coded[V93XX_WaveCodec::kMaxBlockBytes];
+    size_t coded_length = 0;
+    if (this->encoder && chunk.word_count > 0) {
+        coded_length = this->encoder->EncodeWords(chunk.words, chunk.word_count, coded);
+        if (coded_length == 0) {
+            return false;
+        }
+    }
+    FrameBegin(coded_length ? Type::WaveformCoded : Type::Waveform);
+    PutLe16(this->capture_id);
+    PutLe32(this->capture_ctrl5);
+    PutLe16((uint16_t)chunk.first_word);
+    Put(chunk.word_count);
+    Put((uint8_t)((chunk.overflow ? 0x01 : 0) | (chunk.last ? 0x02 : 0) | ((uint8_t)chunk.status << 4)));
+    if (coded_length) {
+        for (size_t i = 0; i < coded_length; i++) {
+            Put(coded[i]);
+        }
+    } else {
+        for (uint8_t i = 0; i < chunk.word_count; i++) {
+            PutLe32(chunk.words[i]);
+        }
+    }
+    FrameEnd();
+    return true;
+}
+
+bool V93XX_Telemetry::WaveformSink(const V93XX_WaveformChunk &chunk, void *context) {
+    return static_cast<V93XX_Telemetry *>(context)->SendWaveformChunk(chunk);
+}
+
+bool V93XX_Telemetry::SendRegisters(uint8_t first_address, const uint32_t *values, uint8_t count,
+                                    V93XX_Status status) {
+    if (!this->writer || (!values && count)) {
+        return false;
+    }
+    FrameBegin(Type::Registers);
+    Put(first_address);
+    Put(count);
+    Put((uint8_t)status);
+    Put(0);
+    for (uint8_t i = 0; i < count; i++) {
+        PutLe32(values[i]);
+    }
+    FrameEnd();
+    return true;
+}
+
+bool V93XX_Telemetry::SendEvent(uint32_t sys_intsts) {
+    if (!this->writer) {
+        return false;
+    }
+    FrameBegin(Type::Event);
+    PutLe32(sys_intsts);
+    FrameEnd();
+    return true;
+}
+
+bool V93XX_Telemetry::Send(Type type, const uint8_t *payload, size_t length) {
+    if (!this->writer || (!payload && length)) {
+        return false;
+    }
+    FrameBegin(type);
+    for (size_t i = 0; i < length; i++) {
+        Put(payload[i]);
+    }
+    FrameEnd();
+    return true;
+}
+
+void V93XX_Telemetry::FrameBegin(Type type) {
+    // Leading delimiter: whatever was written since the last frame ends here.
+    const uint8_t delimiter = 0x00;
+    Write(&delimiter, 1);
+    this->block_length = 1; // block[0] is the COBS code byte, filled in on flush
+    this->crc = 0xFFFF;
+
+    Put(kVersion);
+    Put((uint8_t)type);
+    PutLe16(this->sequence++);
+    PutLe32(this->clock ? this->clock() : 0);
+}
+
+void V93XX_Telemetry::FrameEnd() {
+    uint16_t crc = this->crc;
+    CobsPut((uint8_t)crc);
+    CobsPut((uint8_t)(crc >> 8));
+    CobsFlush();
+    const uint8_t delimiter = 0x00;
+    Write(&delimiter, 1);
+}
+
+void V93XX_Telemetry::Put(uint8_t byte) {
+    this->crc = Crc16Update(this->crc, byte);
+    CobsPut(byte);
+}
+
+void V93XX_Telemetry::PutLe16(uint16_t value) {
+    Put((uint8_t)value);
+    Put((uint8_t)(value >> 8));
+}
+
+void V93XX_Telemetry::PutLe32(uint32_t value) {
+    PutLe16((uint16_t)value);
+    PutLe16((uint16_t)(value >> 16));
+}
+
+void V93XX_Telemetry::CobsPut(uint8_t byte) {
+    if (byte == 0) {
+        CobsFlush();
+        return;
+    }
+    this->block[this->block_length++] = byte;
+    if (this->block_length == 0xFF) {
+        // 254 data bytes: a full block implies no zero after it.
+        CobsFlush();
+    }
+}
+
+void V93XX_Telemetry::CobsFlush() {
+    this->block[0] = this->block_length;
+    Write(this->block, this->block_length);
+    this->block_length = 1;
+}
+
+void V93XX_Telemetry::Write(const uint8_t *data, size_t length) {
+    this->writer(data, length, this->context);
+    this->bytes_written += (uint32_t)length;
+}
@@ -0,0 +1,113 @@
+#ifndef V93XX_TELEMETRY_H__
+#define V93XX_TELEMETRY_H__
+
+#include "V93XX_Status.h"
+#include "V93XX_WaveCodec.h"
+#include "V93XX_Waveform.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Compact binary telemetry for the PC link: waveform chunks, register values and events.
+ *
+ * Every record is framed as
+ *   0x00, COBS( header | payload | crc16 ), 0x00
+ * so any 0x00 on the wire is a frame boundary and text printed between frames (driver debug
+ * output) is discarded by the decoder as its own bad frame instead of corrupting the next one.
+ *
+ *   header  uint8 version (1), uint8 type, uint16 sequence, uint32 timestamp_ms
+ *   crc16   CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) over header and payload
+ *
+ * Payloads (all multi-byte fields little-endian):
+ *   Waveform   uint16 capture_id, uint32 ctrl5, uint16 first_word, uint8 word_count,
+ *              uint8 flags (bit 0 overflow, bit 1 last, bits 7:4 V93XX_Status), uint32 words[word_count]
+ *   Registers  uint8 first_address, uint8 count, uint8 V93XX_Status, uint8 reserved, uint32 values[count]
+ *   Event      uint32 SYS_INTSTS bits
+ *   WaveformCoded  as Waveform, with words[] replaced by one V93XX_WaveCodec block of the chunk's samples
+ *   LinkTrace  the next bytes of a V93XX_LinkTrace stream (see V93XX_LinkTrace.h)
+ *
+ * COBS adds one byte per 254, so a 16-word waveform chunk costs 87 bytes on the wire against
+ * about 225 characters as formatted text. The frame is encoded on the fly: no frame buffer
+ * beyond one 255-byte COBS block. tools/telemetry_decode.py is the matching decoder.
+ */
+class V93XX_Telemetry {
+  public:
+    static constexpr uint8_t kVersion = 1;
+    static constexpr size_t kHeaderSize = 8;
+
+    enum class Type : uint8_t {
+        Waveform = 1,
+        Registers = 2,
+        Event = 3,
+        WaveformCoded = 4,
+        LinkTrace = 5,
+    };
+
+    /**
+     * @brief Byte sink, e.g. a wrapper around Serial.write().
+     */
+    typedef void (*Writer)(const uint8_t *data, size_t length, void *context);
+
+    /**
+     * @param clock Timestamp source for the header (millis on Arduino); 0 if null
+     */
+    void Begin(Writer writer, void *context, uint32_t (*clock)() = nullptr);
+
+    /**
+     * @brief Start a new waveform capture: following chunks carry a new capture_id and @p ctrl5.
+     */
+    void BeginCapture(uint32_t ctrl5);
+
+    /**
+     * @brief Compress waveform chunks losslessly (Type::WaveformCoded); null sends raw words again.
+     *
+     * The encoder is reset by BeginCapture(), so the decoder must see every chunk of a capture in order.
+     */
+    void SetWaveformEncoder(V93XX_WaveEncoder *encoder) { this->encoder = encoder; }
+
+    bool SendWaveformChunk(const V93XX_WaveformChunk &chunk);
+
+    /**
+     * @brief V93XX_WaveformSink adapter: CaptureWaveform(V93XX_Telemetry::WaveformSink, &telemetry, ...).
+     */
+    static bool WaveformSink(const V93XX_WaveformChunk &chunk, void *context);
+
+    bool SendRegisters(uint8_t first_address, const uint32_t *values, uint8_t count,
+                       V93XX_Status status = V93XX_Status::Ok);
+    bool SendEvent(uint32_t sys_intsts);
+
+    /**
+     * @brief Send any record type; @p payload is written as given.
+     */
+    bool Send(Type type, const uint8_t *payload, size_t length);
+
+    uint16_t Sequence() const { return this->sequence; }
+    uint16_t CaptureId() const { return this->capture_id; }
+    uint32_t BytesWritten() const { return this->bytes_written; }
+
+  private:
+    Writer writer = nullptr;
+    void *context = nullptr;
+    uint32_t (*clock)() = nullptr;
+    uint16_t sequence = 0;
+    uint16_t capture_id = 0;
+    uint32_t capture_ctrl5 = 0;
+    uint32_t bytes_written = 0;
+    V93XX_WaveEncoder *encoder = nullptr;
+
+    // Streaming COBS state for the frame being written.
+    uint8_t block[255] = {0};
+    uint8_t block_length = 0;
+    uint16_t crc = 0;
+
+    void FrameBegin(Type type);
+    void FrameEnd();
+    void Put(uint8_t byte);
+    void PutLe16(uint16_t value);
+    void PutLe32(uint32_t value);
+    void CobsPut(uint8_t byte);
+    void CobsFlush();
+    void Write(const uint8_t *data, size_t length);
+};
+
+#endif
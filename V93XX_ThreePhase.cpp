@@ -0,0 +1,338 @@
+#include "V93XX_ThreePhase.h"
+
+#include <math.h>
+
+static constexpr float kPi = 3.14159265358979f;
+static constexpr float kDegPerRad = 180.0f / kPi;
+// Tolerance around +/-120 degrees for recognizing the phase rotation.
+static constexpr float kRotationToleranceDeg = 30.0f;
+
+static float WrapDegrees(float degrees) {
+    degrees = fmodf(degrees, 360.0f);
+    if (degrees > 180.0f) {
+        degrees -= 360.0f;
+    } else if (degrees <= -180.0f) {
+        degrees += 360.0f;
+    }
+    return degrees;
+}
+
+/**
+ * @brief Sum of three phasors rotated by 0, @p step and 2 * @p step degrees, divided by 3.
+ *
+ * With step = +120 this is the positive-sequence component of an ABC system, with -120 the
+ * negative-sequence one.
+ */
+static float SequenceMagnitude(const float (&magnitude)[3], const float (&angle_deg)[3], float step_deg) {
+    float re = 0.0f;
+    float im = 0.0f;
+    for (uint8_t i = 0; i < 3; i++) {
+        float angle = (angle_deg[i] + step_deg * i) / kDegPerRad;
+        re += magnitude[i] * cosf(angle);
+        im += magnitude[i] * sinf(angle);
+    }
+    return sqrtf(re * re + im * im) / 3.0f;
+}
+
+static float Unbalance(const float (&magnitude)[3], const float (&angle_deg)[3], V93XX_PhaseRotation rotation) {
+    float positive = SequenceMagnitude(magnitude, angle_deg, 120.0f);
+    float negative = SequenceMagnitude(magnitude, angle_deg, -120.0f);
+    if (rotation == V93XX_PhaseRotation::Acb) {
+        float swap = positive;
+        positive = negative;
+        negative = swap;
+    }
+    return (positive > 0.0f) ? 100.0f * negative / positive : 0.0f;
+}
+
+V93XX_ThreePhase::Config V93XX_ThreePhase::DefaultConfig() {
+    Config config;
+    config.sample_rate_hz = 6400.0f;
+    config.line_frequency_hz = 50.0f;
+    for (uint8_t i = 0; i < kPhases; i++) {
+        config.voltage_scale[i] = 1.0f;
+        config.current_scale[i] = 1.0f;
+        config.power_scale[i] = 1.0f;
+    }
+    config.current_channel_b = false;
+    config.max_reading_skew_ms = 2000;
+    config.max_capture_span_us = 2000000UL;
+    config.min_capture_cycles = 2;
+    return config;
+}
+
+V93XX_ThreePhase::V93XX_ThreePhase() : config(DefaultConfig()) { Reset(); }
+
+void V93XX_ThreePhase::Begin(const Config &config) {
+    this->config = config;
+    if (this->config.min_capture_cycles == 0) {
+        this->config.min_capture_cycles = 1;
+    }
+    Reset();
+}
+
+void V93XX_ThreePhase::Reset() {
+    for (uint8_t phase = 0; phase < kPhases; phase++) {
+        for (uint8_t quantity = 0; quantity < 2; quantity++) {
+            this->channels[phase][quantity] = Channel{};
+        }
+    }
+    this->snapshot = V93XX_ThreePhaseSnapshot{};
+}
+
+void V93XX_ThreePhase::SetLineFrequency(float hz) {
+    if (hz > 0.0f) {
+        this->config.line_frequency_hz = hz;
+    }
+}
+
+void V93XX_ThreePhase::SetReading(uint8_t phase, const V93XX_PhaseReading &reading) {
+    if (phase >= kPhases) {
+        return;
+    }
+    this->snapshot.phases[phase] = reading;
+    Recompute();
+}
+
+void V93XX_ThreePhase::SetReading(uint8_t phase, const V93XX_AcquisitionSnapshot &snapshot) {
+    if (phase >= kPhases) {
+        return;
+    }
+    StoreReading(phase, snapshot);
+    Recompute();
+}
+
+bool V93XX_ThreePhase::SetReadings(const V93XX_MultiBus::Frame &frame) {
+    bool complete = true;
+    for (uint8_t phase = 0; phase < kPhases; phase++) {
+        if (phase >= frame.bus_count || !(frame.valid_mask & (1 << phase))) {
+            complete = false;
+            continue;
+        }
+        StoreReading(phase, frame.buses[phase]);
+    }
+    Recompute();
+    return complete;
+}
+
+void V93XX_ThreePhase::StoreReading(uint8_t phase, const V93XX_AcquisitionSnapshot &snapshot) {
+    const uint32_t *values = snapshot.values;
+    const bool b = this->config.current_channel_b;
+    const float power_scale = this->config.power_scale[phase];
+    V93XX_PhaseReading &reading = this->snapshot.phases[phase];
+    // Power registers are two's complement, RMS registers unsigned.
+    reading.active_power = (float)(int32_t)values[b ? DSP_DAT_PB1 : DSP_DAT_PA1] * power_scale;
+    reading.reactive_power = (float)(int32_t)values[b ? DSP_DAT_QB1 : DSP_DAT_QA1] * power_scale;
+    reading.apparent_power = (float)(int32_t)values[b ? DSP_DAT_SB1 : DSP_DAT_SA1] * power_scale;
+    reading.voltage_rms = (float)values[DSP_DAT_RMS1UA] * this->config.voltage_scale[phase];
+    reading.current_rms = (float)values[b ? DSP_DAT_RMS1IB : DSP_DAT_RMS1IA] * this->config.current_scale[phase];
+    reading.timestamp_ms = snapshot.timestamp_ms;
+    reading.valid = snapshot.sequence > 0;
+}
+
+V93XX_ThreePhase::Capture V93XX_ThreePhase::BeginCapture(uint8_t phase, Quantity quantity, uint32_t start_us) {
+    if (phase >= kPhases) {
+        return Capture{nullptr, phase, quantity};
+    }
+    Channel &channel = ChannelFor(phase, quantity);
+    channel.start_us = start_us;
+    channel.count = 0;
+    channel.rotation_re = 1.0f;
+    channel.rotation_im = 0.0f;
+    channel.sum_re = 0.0f;
+    channel.sum_im = 0.0f;
+    channel.committed_re = 0.0f;
+    channel.committed_im = 0.0f;
+    channel.cycles = 0;
+    channel.next_cycle_end = SamplesPerCycle();
+    channel.active = SamplesPerCycle() > 0.0f;
+    return Capture{this, phase, quantity};
+}
+
+void V93XX_ThreePhase::PushSamples(uint8_t phase, Quantity quantity, const int16_t *samples, size_t count) {
+    if (phase >= kPhases || !samples) {
+        return;
+    }
+    Channel &channel = ChannelFor(phase, quantity);
+    if (!channel.active) {
+        return;
+    }
+    const float samples_per_cycle = SamplesPerCycle();
+    const float step = -2.0f * kPi / samples_per_cycle;
+    const float step_re = cosf(step);
+    const float step_im = sinf(step);
+    for (size_t i = 0; i < count; i++) {
+        // sum += x[n] * e^(-j w n); the rotation is advanced by complex multiplication.
+        channel.sum_re += samples[i] * channel.rotation_re;
+        channel.sum_im += samples[i] * channel.rotation_im;
+        float re = channel.rotation_re * step_re - channel.rotation_im * step_im;
+        channel.rotation_im = channel.rotation_re * step_im + channel.rotation_im * step_re;
+        channel.rotation_re = re;
+        channel.count++;
+        if ((float)channel.count >= channel.next_cycle_end) {
+            // Keep the sums of whole cycles only, so the DFT does not leak DC and harmonics.
+            channel.committed_re = channel.sum_re;
+            channel.committed_im = channel.sum_im;
+            channel.cycles++;
+            channel.next_cycle_end += samples_per_cycle;
+            float magnitude = sqrtf(channel.rotation_re * channel.rotation_re +
+                                    channel.rotation_im * channel.rotation_im);
+            channel.rotation_re /= magnitude;
+            channel.rotation_im /= magnitude;
+        }
+    }
+}
+
+bool V93XX_ThreePhase::EndCapture(uint8_t phase, Quantity quantity) {
+    if (phase >= kPhases) {
+        return false;
+    }
+    Channel &channel = ChannelFor(phase, quantity);
+    if (!channel.active) {
+        return false;
+    }
+    channel.active = false;
+    if (channel.cycles < this->config.min_capture_cycles ||
+        (channel.committed_re == 0.0f && channel.committed_im == 0.0f)) {
+        return false;
+    }
+    // For x[n] = A cos(w n + a), the whole-cycle sum is (N A / 2) e^(j a).
+    channel.angle_rad = atan2f(channel.committed_im, channel.committed_re);
+    channel.phasor_start_us = channel.start_us;
+    channel.has_phasor = true;
+    Recompute();
+    return true;
+}
+
+bool V93XX_ThreePhase::Sink(const V93XX_WaveformChunk &chunk, void *context) {
+    Capture *capture = static_cast<Capture *>(context);
+    if (!capture || !capture->owner) {
+        return false;
+    }
+    V93XX_ThreePhase &owner = *capture->owner;
+    if (chunk.status != V93XX_Status::Ok || chunk.overflow) {
+        // A lost block shifts every later sample; the capture cannot be timed any more.
+        owner.ChannelFor(capture->phase, capture->quantity).active = false;
+        return false;
+    }
+    owner.PushSamples(capture->phase, capture->quantity, chunk.samples, chunk.sample_count);
+    if (chunk.last) {
+        owner.EndCapture(capture->phase, capture->quantity);
+    }
+    return true;
+}
+
+float V93XX_ThreePhase::SamplesPerCycle() const {
+    return (this->config.line_frequency_hz > 0.0f) ? this->config.sample_rate_hz / this->config.line_frequency_hz
+                                                   : 0.0f;
+}
+
+bool V93XX_ThreePhase::MeasuredAngles(float (&voltage_deg)[kPhases], float (&current_deg)[kPhases],
+                                      uint32_t &span_us) const {
+    const Channel &reference = this->channels[0][(uint8_t)Quantity::Voltage];
+    int32_t earliest = 0;
+    int32_t latest = 0;
+    for (uint8_t phase = 0; phase < kPhases; phase++) {
+        for (uint8_t quantity = 0; quantity < 2; quantity++) {
+            const Channel &channel = this->channels[phase][quantity];
+            if (!channel.has_phasor) {
+                return false;
+            }
+            int32_t offset = (int32_t)(channel.phasor_start_us - reference.phasor_start_us);
+            earliest = (offset < earliest) ? offset : earliest;
+            latest = (offset > latest) ? offset : latest;
+        }
+    }
+    span_us = (uint32_t)(latest - earliest);
+    if (span_us > this->config.max_capture_span_us) {
+        return false;
+    }
+
+    // The angle at a capture's start, moved back to the reference start at the line frequency.
+    const float radians_per_us = 2.0f * kPi * this->config.line_frequency_hz * 1e-6f;
+    for (uint8_t phase = 0; phase < kPhases; phase++) {
+        for (uint8_t quantity = 0; quantity < 2; quantity++) {
+            const Channel &channel = this->channels[phase][quantity];
+            int32_t offset = (int32_t)(channel.phasor_start_us - reference.phasor_start_us);
+            float delta = channel.angle_rad - reference.angle_rad - radians_per_us * (float)offset;
+            float degrees = WrapDegrees(fmodf(delta, 2.0f * kPi) * kDegPerRad);
+            (quantity == (uint8_t)Quantity::Voltage ? voltage_deg : current_deg)[phase] = degrees;
+        }
+    }
+    return true;
+}
+
+void V93XX_ThreePhase::Recompute() {
+    V93XX_ThreePhaseSnapshot next = this->snapshot;
+    next.sequence++;
+
+    next.active_power = 0.0f;
+    next.reactive_power = 0.0f;
+    next.apparent_power = 0.0f;
+    bool all_valid = true;
+    bool any_valid = false;
+    uint32_t oldest = 0;
+    uint32_t newest = 0;
+    for (uint8_t phase = 0; phase < kPhases; phase++) {
+        const V93XX_PhaseReading &reading = next.phases[phase];
+        if (!reading.valid) {
+            all_valid = false;
+            continue;
+        }
+        next.active_power += reading.active_power;
+        next.reactive_power += reading.reactive_power;
+        next.apparent_power += reading.apparent_power;
+        // Seed from the first valid phase: an invalid phase A must not pin the skew to timestamp 0.
+        if (!any_valid || (int32_t)(reading.timestamp_ms - oldest) < 0) {
+            oldest = reading.timestamp_ms;
+        }
+        if (!any_valid || (int32_t)(reading.timestamp_ms - newest) > 0) {
+            newest = reading.timestamp_ms;
+        }
+        any_valid = true;
+    }
+    next.apparent_power_vector =
+        sqrtf(next.active_power * next.active_power + next.reactive_power * next.reactive_power);
+    next.power_factor = (next.apparent_power > 0.0f) ? next.active_power / next.apparent_power : 0.0f;
+    next.reading_skew_ms = newest - oldest;
+    next.aligned = all_valid && next.reading_skew_ms <= this->config.max_reading_skew_ms;
+
+    uint32_t span_us = 0;
+    next.angles_measured = MeasuredAngles(next.voltage_angle_deg, next.current_angle_deg, span_us);
+    next.capture_span_us = span_us;
+    next.rotation = V93XX_PhaseRotation::Unknown;
+    if (next.angles_measured) {
+        float b = next.voltage_angle_deg[1];
+        float c = next.voltage_angle_deg[2];
+        if (fabsf(b + 120.0f) < kRotationToleranceDeg && fabsf(c - 120.0f) < kRotationToleranceDeg) {
+            next.rotation = V93XX_PhaseRotation::Abc;
+        } else if (fabsf(b - 120.0f) < kRotationToleranceDeg && fabsf(c + 120.0f) < kRotationToleranceDeg) {
+            next.rotation = V93XX_PhaseRotation::Acb;
+        }
+    } else {
+        // Nominal ABC voltages; each current lags its voltage by the power angle.
+        for (uint8_t phase = 0; phase < kPhases; phase++) {
+            const V93XX_PhaseReading &reading = next.phases[phase];
+            next.voltage_angle_deg[phase] = WrapDegrees(-120.0f * phase);
+            float power_angle = atan2f(reading.reactive_power, reading.active_power) * kDegPerRad;
+            next.current_angle_deg[phase] = WrapDegrees(next.voltage_angle_deg[phase] - power_angle);
+        }
+    }
+
+    float voltage[kPhases];
+    float current[kPhases];
+    float neutral_re = 0.0f;
+    float neutral_im = 0.0f;
+    for (uint8_t phase = 0; phase < kPhases; phase++) {
+        const V93XX_PhaseReading &reading = next.phases[phase];
+        voltage[phase] = reading.valid ? reading.voltage_rms : 0.0f;
+        current[phase] = reading.valid ? reading.current_rms : 0.0f;
+        neutral_re += current[phase] * cosf(next.current_angle_deg[phase] / kDegPerRad);
+        neutral_im += current[phase] * sinf(next.current_angle_deg[phase] / kDegPerRad);
+    }
+    next.neutral_current = sqrtf(neutral_re * neutral_re + neutral_im * neutral_im);
+    next.voltage_unbalance = Unbalance(voltage, next.voltage_angle_deg, next.rotation);
+    next.current_unbalance = Unbalance(current, next.current_angle_deg, next.rotation);
+
+    this->snapshot = next;
+}
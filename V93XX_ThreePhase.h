@@ -0,0 +1,182 @@
+#ifndef V93XX_THREEPHASE_H__
+#define V93XX_THREEPHASE_H__
+
+#include "V93XX_MultiBus.h"
+#include "V93XX_Waveform.h"
+#include <stddef.h>
+#include <stdint.h>
+
+enum class V93XX_PhaseRotation : uint8_t {
+    Unknown = 0, // No voltage phasors, or angles not near 120 degrees apart
+    Abc,         // B lags A by 120 degrees (positive sequence)
+    Acb,         // B leads A by 120 degrees
+};
+
+/**
+ * @brief One phase's measurements in engineering units (after the per-phase scales of V93XX_ThreePhase::Config).
+ */
+struct V93XX_PhaseReading {
+    float voltage_rms;
+    float current_rms;
+    float active_power;
+    float reactive_power;
+    float apparent_power;
+    uint32_t timestamp_ms; // When the registers were read (V93XX_AcquisitionNowMs() base)
+    bool valid;
+};
+
+/**
+ * @brief Combined three-phase state; every field comes from the same set of readings and captures.
+ */
+struct V93XX_ThreePhaseSnapshot {
+    uint32_t sequence;            // Recomputations since Begin()/Reset()
+    V93XX_PhaseReading phases[3]; // A, B, C
+    float voltage_angle_deg[3];   // Relative to phase A voltage
+    float current_angle_deg[3];   // Relative to phase A voltage
+    float active_power;           // Sum of P
+    float reactive_power;         // Sum of Q
+    float apparent_power;         // Sum of S (arithmetic)
+    float apparent_power_vector;  // sqrt(P^2 + Q^2) of the totals
+    float power_factor;           // active_power / apparent_power
+    float neutral_current;        // |Ia + Ib + Ic| as phasors
+    float voltage_unbalance;      // |V2| / |V1| in percent (negative / positive sequence)
+    float current_unbalance;      // |I2| / |I1| in percent
+    V93XX_PhaseRotation rotation; // From the measured voltage phasors (Unknown without captures)
+    bool angles_measured;         // Angles from waveform captures (else nominal 120 degrees and atan2(Q, P))
+    uint32_t reading_skew_ms;     // Newest minus oldest reading timestamp
+    uint32_t capture_span_us;     // Latest minus earliest capture start in the phasor set
+    bool aligned;                 // All readings valid and within max_reading_skew_ms
+};
+
+/**
+ * @brief Three-phase metrics from three single-phase chips (one V93XX driver per phase).
+ *
+ * Readings (RMS, P, Q, S) come from each chip's registers, either as V93XX_Acquisition snapshots
+ * (one per bus in a V93XX_MultiBus frame) or filled in by the caller. Phase angles come from
+ * waveform captures: each capture is streamed into a single-bin DFT at the line frequency, O(1)
+ * state per channel, and its phasor is referred to a common time base through the capture's start
+ * timestamp, so voltages and currents captured one after another on different chips line up.
+ * Every update recomputes the combined snapshot in constant time.
+ *
+ * Magnitudes are always the scaled RMS registers; the captures only supply angles, so the chips'
+ * raw waveform scales do not have to match. Without captures the voltages are assumed 120 degrees
+ * apart (ABC) and each current sits at atan2(Q, P) behind its voltage, which still gives a neutral
+ * current and unbalance figures but no rotation.
+ *
+ * Angle accuracy depends on the timestamps and the line frequency: take the start time with
+ * micros() immediately before the capture is triggered (a trigger latency common to all chips
+ * cancels out), and keep line_frequency_hz tracked (SetLineFrequency()), since a frequency error
+ * of df rotates captures taken t apart by 360 * df * t degrees.
+ */
+class V93XX_ThreePhase {
+  public:
+    static constexpr uint8_t kPhases = 3;
+
+    enum class Quantity : uint8_t {
+        Voltage = 0,
+        Current,
+    };
+
+    struct Config {
+        float sample_rate_hz;         // Waveform sample rate
+        float line_frequency_hz;      // Nominal or tracked line frequency
+        float voltage_scale[kPhases]; // Volts per RMS count (DSP_DAT_RMS1UA)
+        float current_scale[kPhases]; // Amperes per RMS count (DSP_DAT_RMS1IA/IB)
+        float power_scale[kPhases];   // Watts (var, VA) per power count (DSP_DAT_PA1/QA1/SA1)
+        bool current_channel_b;       // Use channel B (IB, PB1, QB1, SB1) instead of A
+        uint32_t max_reading_skew_ms; // Readings further apart are reported as not aligned
+        uint32_t max_capture_span_us; // Phasors from captures further apart are not combined
+        uint16_t min_capture_cycles;  // Whole cycles a capture needs to yield a phasor
+    };
+
+    /**
+     * @brief Sink context for CaptureWaveform(): see BeginCapture().
+     */
+    struct Capture {
+        V93XX_ThreePhase *owner;
+        uint8_t phase;
+        Quantity quantity;
+    };
+
+    static Config DefaultConfig();
+
+    V93XX_ThreePhase();
+
+    void Begin(const Config &config);
+    void Reset();
+
+    void SetLineFrequency(float hz);
+
+    /**
+     * @brief Replace one phase's reading and recompute.
+     */
+    void SetReading(uint8_t phase, const V93XX_PhaseReading &reading);
+
+    /**
+     * @brief Take one phase's reading from an acquisition snapshot (its groups must cover 0x13-0x1B).
+     */
+    void SetReading(uint8_t phase, const V93XX_AcquisitionSnapshot &snapshot);
+
+    /**
+     * @brief Take buses 0, 1 and 2 of a V93XX_MultiBus frame as phases A, B and C.
+     * @return true if all three buses had published
+     */
+    bool SetReadings(const V93XX_MultiBus::Frame &frame);
+
+    /**
+     * @brief Start a capture of @p quantity on @p phase that began at @p start_us (micros()).
+     * @return Context for Sink(), e.g. device.CaptureWaveform(V93XX_ThreePhase::Sink, &capture, words, ctrl5)
+     */
+    Capture BeginCapture(uint8_t phase, Quantity quantity, uint32_t start_us);
+
+    /**
+     * @brief Feed samples of the capture started by BeginCapture(), in order, in spans of any length.
+     */
+    void PushSamples(uint8_t phase, Quantity quantity, const int16_t *samples, size_t count);
+
+    /**
+     * @brief Close the capture; its phasor replaces the previous one if it covered enough cycles.
+     * @return true if a phasor was produced
+     */
+    bool EndCapture(uint8_t phase, Quantity quantity);
+
+    /**
+     * @brief V93XX_WaveformSink for a Capture; a failed block read or WAVEOV discards the capture.
+     */
+    static bool Sink(const V93XX_WaveformChunk &chunk, void *context);
+
+    const V93XX_ThreePhaseSnapshot &Latest() const { return this->snapshot; }
+
+  private:
+    struct Channel {
+        // Capture in progress
+        uint32_t start_us;
+        uint32_t count;
+        float rotation_re;
+        float rotation_im;
+        float sum_re;
+        float sum_im;
+        float committed_re;
+        float committed_im;   // Sums at the last whole cycle
+        float next_cycle_end; // Sample count that completes the next cycle
+        uint16_t cycles;
+        bool active;
+
+        // Last completed capture
+        float angle_rad; // Phase of the fundamental at start_us
+        uint32_t phasor_start_us;
+        bool has_phasor;
+    };
+
+    Config config;
+    Channel channels[kPhases][2];
+    V93XX_ThreePhaseSnapshot snapshot;
+
+    Channel &ChannelFor(uint8_t phase, Quantity quantity) { return this->channels[phase][(uint8_t)quantity]; }
+    void StoreReading(uint8_t phase, const V93XX_AcquisitionSnapshot &snapshot);
+    float SamplesPerCycle() const;
+    bool MeasuredAngles(float (&voltage_deg)[kPhases], float (&current_deg)[kPhases], uint32_t &span_us) const;
+    void Recompute();
+};
+
+#endif
@@ -1,55 +1,19 @@
 
 #include "V93XX_UART.h"
 
-const uint8_t ControlAddresses[] = {
-    DSP_ANA0,  // Analog Control 0
-    DSP_ANA1,  // Analog Control 1
-    DSP_CTRL0, // Digital Control 0
-    DSP_CTRL1, // Digital Control 1
-    DSP_CTRL2, // Digital Control 2
-    DSP_CTRL3, // Digital Control 3
-    DSP_CTRL4, // Digital Control 4
-    DSP_CTRL5, // Digital Control 5
-};
-
-const uint8_t CalibrationAddresses[] = {
-    DSP_CFG_CALI_PA,    // Active power A ratio difference correction
-    DSP_CFG_DC_PA,      //  Active power A small signal correction
-    DSP_CFG_CALI_QA,    //	Reactive power A ratio difference correction
-    DSP_CFG_DC_QA,      //	Reactive power A small signal correction
-    DSP_CFG_CALI_PB,    //	Active power B ratio difference correction
-    DSP_CFG_DC_PB,      //	Active power B small signal correction
-    DSP_CFG_CALI_QB,    //	Reactive power B ratio difference correction
-    DSP_CFG_DC_QB,      //	Reactive power B small signal correction
-    DSP_CFG_CALI_RMSUA, //	Voltage RMS ratio correction
-    DSP_CFG_RMS_DCUA,   //	Voltage RMS small signal correction
-    DSP_CFG_CALI_RMSIA, //	Current A effective value ratio correction
-    DSP_CFG_RMS_DCIA,   //	Current A RMS small signal correction
-    DSP_CFG_CALI_RMSIB, //	Current B effective value ratio difference correction
-    DSP_CFG_RMS_DCIB,   //	Current B RMS small signal correction
-    DSP_CFG_PHC,        //	Angular error correction register
-    DSP_CFG_DCUA,       //	Voltage channel DC correction value
-    DSP_CFG_DCIA,       //	Current A channel DC correction value
-    DSP_CFG_DCIB,       //	Current B channel DC correction value
-    DSP_CFG_BPF,        //	Bandpass filter coefficients
-    DSP_CFG_CKSUM,      //	Checksum Configuration Registers
-    EGY_PROCTH,         //	Energy register anti-submarine threshold (less than it will not accumulate)
-    EGY_PWRTH,          //	Energy register accumulation threshold. Since the energy register is 46 bits
-};
-
-V93XX_UART::V93XX_UART(int rx_pin, int tx_pin, HardwareSerial &serial, int device_address)
-    : serial(serial), serial_rx_buffer(std::list<uint8_t>(65)) // 65bytes = 16x u32 (block read) + u8 (CRC)
-{
+V93XX_UartTransport::V93XX_UartTransport(int rx_pin, int tx_pin, HardwareSerial &serial, int device_address)
+    : serial(serial) {
     this->device_address = device_address;
+    this->read_requests = V93XX_Frames::UartReadRequests((uint8_t)device_address);
+    this->block_requests = V93XX_Frames::UartBlockRequests((uint8_t)device_address);
     this->tx_pin = tx_pin;
     this->rx_pin = rx_pin;
-
-    while (this->serial_rx_buffer.size()) {
-        this->serial_rx_buffer.pop();
-    }
 }
 
-void V93XX_UART::RxReset() {
+void V93XX_UartTransport::RxReset() {
+    // RX reset restores the block-read mapping registers to their defaults.
+    this->block_addr_valid = 0;
+
     pinMode(this->tx_pin, OUTPUT);
 
     // TX pin for UART , RX pin for ASIC need to be held low
@@ -62,66 +26,144 @@ void V93XX_UART::RxReset() {
     delayMicroseconds(2150);
 }
 
-void V93XX_UART::Init(SerialConfig config, ChecksumMode checksum_mode) {
+void V93XX_UartTransport::Init(SerialConfig config, ChecksumMode checksum_mode) {
+    this->serial_config = config;
     this->checksum_mode = checksum_mode;
+    this->block_addr_valid = 0;
 
     pinMode(this->rx_pin, INPUT_PULLUP);
     this->serial.begin(19200, config, this->rx_pin, this->tx_pin);
     noInterrupts();
-    this->serial.onReceive(std::bind(&V93XX_UART::RxReceive, this));
-    while (this->serial_rx_buffer.size()) {
-        this->serial_rx_buffer.pop();
-    }
+    this->serial.onReceive(std::bind(&V93XX_UartTransport::RxReceive, this));
+    this->rx_head = 0;
+    this->rx_tail = 0;
+    this->rx_overrun = false;
     interrupts();
 }
 
-bool V93XX_UART::WaitForRx(size_t count, uint32_t timeout_ms) {
-    uint32_t start = millis();
-    while (this->RxBufferCount() < count) {
-        if ((millis() - start) >= timeout_ms) {
-            return false;
-        }
-        delay(1);
-    }
-    return true;
-}
-
-void V93XX_UART::RxReceive() {
+void V93XX_UartTransport::RxReceive() {
     while (this->serial.available() > 0) {
         uint8_t data = this->serial.read();
         noInterrupts();
-        if ((this->serial_rx_buffer.size() < 65)) {
-            this->serial_rx_buffer.push(data);
+        size_t next = (this->rx_head + 1) % kRxBufferSize;
+        if (next != this->rx_tail) {
+            this->rx_buffer[this->rx_head] = data;
+            this->rx_head = next;
+        } else {
+            this->rx_overrun = true;
         }
         interrupts();
     }
 }
 
-unsigned int V93XX_UART::RxBufferCount() {
-    unsigned int count = 0;
+bool V93XX_UartTransport::RxBufferPop(uint8_t &data) {
+    bool available = false;
     noInterrupts();
-    count = this->serial_rx_buffer.size();
+    if (this->rx_tail != this->rx_head) {
+        data = this->rx_buffer[this->rx_tail];
+        this->rx_tail = (this->rx_tail + 1) % kRxBufferSize;
+        available = true;
+    }
     interrupts();
-    return count;
+    if (available && this->link_trace) {
+        this->link_trace->Rx(data);
+    }
+    return available;
 }
 
-uint8_t V93XX_UART::RxBufferPop() {
-    uint8_t data = 0;
+void V93XX_UartTransport::RxFlush() {
+    // Anything still buffered belongs to an earlier, abandoned frame.
+    size_t stale = 0;
+    uint8_t data;
+    if (this->link_trace) {
+        // Popped one by one so the trace sees the discarded bytes too.
+        while (this->RxBufferPop(data)) {
+            stale++;
+        }
+    }
     noInterrupts();
-    data = this->serial_rx_buffer.front();
-    this->serial_rx_buffer.pop();
+    stale += (this->rx_head + kRxBufferSize - this->rx_tail) % kRxBufferSize;
+    this->rx_tail = this->rx_head;
+    this->rx_overrun = false;
     interrupts();
-    return data;
+    while (this->serial.available() > 0) {
+        data = this->serial.read();
+        if (this->link_trace) {
+            this->link_trace->Rx(data);
+        }
+        stale++;
+    }
+    this->discarded_bytes += stale;
+}
+
+bool V93XX_UartTransport::RxPopWithin(uint8_t &data, uint32_t start_ms, uint32_t timeout_ms) {
+    if (this->response_received >= this->response_expected) {
+        return false;
+    }
+    while (!this->RxBufferPop(data)) {
+        if ((millis() - start_ms) >= timeout_ms) {
+            return false;
+        }
+        delay(1);
+    }
+    this->response_received++;
+    return true;
+}
+
+bool V93XX_UartTransport::RxSyncMarker(uint32_t start_ms, uint32_t timeout_ms) {
+    // Skip line noise until the response marker; it is never counted as part of the frame.
+    uint8_t data = 0;
+    while (this->RxPopWithin(data, start_ms, timeout_ms)) {
+        if (data == V93XX_Frames::kMarker) {
+            return true;
+        }
+        this->response_received--;
+        this->discarded_bytes++;
+    }
+    return false;
+}
+
+void V93XX_UartTransport::Transmit(const uint8_t *frame, size_t length, size_t response_length) {
+    this->RxFlush();
+    this->response_expected = response_length;
+    this->response_received = 0;
+    this->serial.write(frame, length);
+    if (this->link_trace) {
+        this->link_trace->Tx(frame, length);
+    }
+    this->serial.flush();
+}
+
+V93XX_UartTransport::FrameStatus V93XX_UartTransport::EndFrame() {
+    FrameStatus status = FrameStatus::Ok;
+    if (this->rx_overrun) {
+        status = FrameStatus::Overrun;
+    } else if (this->response_received == 0) {
+        status = FrameStatus::NoResponse;
+    } else if (this->response_received < this->response_expected) {
+        status = FrameStatus::Truncated;
+    }
+    this->response_expected = 0;
+    return status;
 }
 
-void V93XX_UART::RegisterWrite(uint8_t address, uint32_t data) {
+void V93XX_UartTransport::RegisterWrite(uint8_t address, uint32_t data) { (void)RegisterWriteStatus(address, data); }
+
+V93XX_UartTransport::FrameStatus V93XX_UartTransport::RegisterWriteStatus(uint8_t address, uint32_t data) {
+    uint32_t start = this->link_stats.Begin();
+    FrameStatus status = WriteFrame(address, data);
+    this->link_stats.End(V93XX_Op::Write, start, status, 8, this->response_received);
+    return status;
+}
+
+V93XX_UartTransport::FrameStatus V93XX_UartTransport::WriteFrame(uint8_t address, uint32_t data) {
     const int num_registers = 1;
     // Described in Section 7.4 of Datasheet
     uint8_t payload[8] = {// Header
-                          0x7d,
+                          V93XX_Frames::kMarker,
 
                           // CMD1 (Payload length, addr, operation)
-                          (uint8_t)(((num_registers - 1) << 4) | ((this->device_address) << 2) | CmdOperation::WRITE),
+                          V93XX_Frames::UartCmd1(num_registers, (uint8_t)this->device_address, V93XX_Frames::Write),
                           // CMD2 (7b Address)
                           (uint8_t)(address & 0x7f),
 
@@ -134,27 +176,27 @@ void V93XX_UART::RegisterWrite(uint8_t address, uint32_t data) {
 
     uint8_t checksum = 0;
     // Calculate Checksum, Sum of payload &0xFF
-    for (int idx = 1; idx < sizeof(payload) / sizeof(uint8_t) - 1; idx++) {
+    for (size_t idx = 1; idx < sizeof(payload) / sizeof(uint8_t) - 1; idx++) {
         checksum += payload[idx];
     }
-    checksum = 0x33 + ~checksum;
+    checksum = V93XX_Frames::Checksum(checksum);
     payload[7] = checksum;
 
-    // Transmit payload
-    this->serial.write(payload, sizeof(payload) / sizeof(uint8_t));
-    this->serial.flush();
+    // Transmit payload; the chip answers with the checksum byte alone
+    this->Transmit(payload, sizeof(payload) / sizeof(uint8_t), 1);
 
-    // wait for response
-    if (!this->WaitForRx(1, 50)) {
-        Serial.println("RegisterWrite(): timeout waiting for checksum response");
-        return;
+    uint8_t checksum_response = 0;
+    (void)this->RxPopWithin(checksum_response, millis(), 50);
+    FrameStatus status = this->EndFrame();
+    if (status != FrameStatus::Ok) {
+        this->last_frame_status = status;
+        Serial.printf("RegisterWrite(0x%02X): no valid response (status %u)\n", address, (unsigned)status);
+        return status;
     }
 
-    // Read response
-    uint8_t checksum_response = this->RxBufferPop();
-
     // Check and report CRC
     bool checksum_valid = checksum_response == checksum;
+    this->last_frame_status = checksum_valid ? FrameStatus::Ok : FrameStatus::BadChecksum;
     Serial.printf("RegisterWrite(0x%02X): CRC expected=0x%02X received=0x%02X %s", address, checksum, checksum_response,
                   checksum_valid ? "✓" : "✗");
 
@@ -165,57 +207,69 @@ void V93XX_UART::RegisterWrite(uint8_t address, uint32_t data) {
     } else {
         Serial.println();
     }
+    return this->last_frame_status;
 }
 
-uint32_t V93XX_UART::RegisterRead(uint8_t address) {
-    const int num_registers = 1;
-    // Described in Section 7.3 of Datasheet
-    uint8_t request[4] = {// Header
-                          0x7d,
-
-                          // CMD1 (request length, addr, operation)
-                          (uint8_t)(((num_registers - 1) << 4) | ((this->device_address) << 2) | CmdOperation::READ),
-                          // CMD2 (7b Address)
-                          (uint8_t)(address & 0x7f),
+uint32_t V93XX_UartTransport::RegisterRead(uint8_t address) {
+    uint32_t value = 0;
+    (void)RegisterReadChecked(address, value);
+    return value;
+}
 
-                          // Checksum
-                          0x00};
+bool V93XX_UartTransport::RegisterReadChecked(uint8_t address, uint32_t &out_value) {
+    FrameStatus status = RegisterReadStatus(address, out_value);
+    return status == FrameStatus::Ok ||
+           (status == FrameStatus::BadChecksum && this->checksum_mode == ChecksumMode::Dirty);
+}
 
-    // Calculate Checksum, Sum of request &0xFF
-    request[3] = 0x33 + ~(request[1] + request[2]);
+bool V93XX_UartTransport::RegisterReadStrict(uint8_t address, uint32_t &out_value) {
+    return RegisterReadStatus(address, out_value) == FrameStatus::Ok;
+}
 
-    // Transmit request
-    this->serial.write(request, sizeof(request) / sizeof(uint8_t));
-    this->serial.flush();
+V93XX_UartTransport::FrameStatus V93XX_UartTransport::RegisterReadStatus(uint8_t address, uint32_t &out_value) {
+    uint32_t start = this->link_stats.Begin();
+    FrameStatus status = ReadFrame(address, out_value);
+    this->link_stats.End(V93XX_Op::Read, start, status, V93XX_Frames::kUartRequestSize, this->response_received);
+    return status;
+}
 
-    // wait for response (6 bytes: marker + 4 data + checksum)
-    if (!this->WaitForRx(6, 100)) {
-        Serial.println("RegisterRead(): timeout waiting for response");
-        return 0;
-    }
+V93XX_UartTransport::FrameStatus V93XX_UartTransport::ReadFrame(uint8_t address, uint32_t &out_value) {
+    // Described in Section 7.3 of Datasheet; the request is sent straight from the constexpr table
+    const V93XX_Frames::UartRequest &request = this->read_requests[address & 0x7f];
+    this->Transmit(request.bytes, sizeof(request.bytes), 6);
 
-    // Read response: marker + 4 data bytes + 1 checksum byte
-    uint8_t marker = this->RxBufferPop(); // Skip marker byte (0x7D)
-    uint8_t response[4];
+    // Response: marker + 4 data bytes + checksum, consumed as it arrives.
     // Per datasheet: CKSUM = 0x33 + ~(CMD1 + CMD2 + sum of all data bytes)
-    uint8_t checksum = request[1] + request[2]; // Start with CMD1 + CMD2
-    uint32_t result = 0;
-    for (int i = 0; i < 4; i++) {
-        uint8_t data = this->RxBufferPop();
-        checksum += data;
-        result |= data << (8 * i);
-        response[i] = data;
+    V93XX_Frames::RunningChecksum checksum = request.ResponseChecksum();
+    uint32_t start = millis();
+    uint8_t response[4] = {0};
+    uint8_t checksum_response = 0;
+    bool complete = this->RxSyncMarker(start, 100);
+    for (int i = 0; complete && i < 4; i++) {
+        complete = this->RxPopWithin(response[i], start, 100);
+        checksum.Add(response[i]);
+    }
+    if (complete) {
+        (void)this->RxPopWithin(checksum_response, start, 100);
+    }
+    FrameStatus status = this->EndFrame();
+    if (status != FrameStatus::Ok) {
+        this->last_frame_status = status;
+        Serial.printf("RegisterRead(0x%02X): no valid response (status %u)\n", address, (unsigned)status);
+        out_value = 0;
+        return status;
     }
-    // V9381 checksum per datasheet: 0x33 + ~(CMD1 + CMD2 + data bytes)
-    checksum = 0x33 + ~(checksum);
-    uint8_t checksum_response = this->RxBufferPop();
+    uint32_t result = (uint32_t)response[0] | ((uint32_t)response[1] << 8) | ((uint32_t)response[2] << 16) |
+                      ((uint32_t)response[3] << 24);
 
     // Debug output
-    bool checksum_valid = checksum == checksum_response;
+    bool checksum_valid = checksum.Matches(checksum_response);
+    status = checksum_valid ? FrameStatus::Ok : FrameStatus::BadChecksum;
+    this->last_frame_status = status;
     Serial.printf(
         "RegisterRead(0x%02X): marker=0x%02X data=[0x%02X 0x%02X 0x%02X 0x%02X] CRC expected=0x%02X received=0x%02X %s",
-        address, marker, response[0], response[1], response[2], response[3], checksum, checksum_response,
-        checksum_valid ? "✓" : "✗");
+        address, V93XX_Frames::kMarker, response[0], response[1], response[2], response[3], checksum.Expected(),
+        checksum_response, checksum_valid ? "✓" : "✗");
 
     if (!checksum_valid && this->checksum_mode == ChecksumMode::Clean) {
         Serial.println(" - ERROR: CRC mismatch! (Clean mode)");
@@ -225,68 +279,74 @@ uint32_t V93XX_UART::RegisterRead(uint8_t address) {
         Serial.println();
     }
 
-    return result;
+    // Clean mode never hands out data from a corrupt frame.
+    out_value = (checksum_valid || this->checksum_mode == ChecksumMode::Dirty) ? result : 0;
+    return status;
 }
 
-void V93XX_UART::ConfigureBlockRead(const uint8_t addresses[], uint8_t num_addresses) {
-    uint8_t const *address_ptr = addresses;
-    for (int blk = 0; blk < 4; blk++) {
-        uint32_t combined_address = 0;
-        for (int i = 0; (i < 4) && (num_addresses); i++) {
-            combined_address |= (*address_ptr++ << (8 * i));
-            num_addresses--;
-        }
-        RegisterWrite(SYS_BLK_ADDR0 + blk, combined_address);
-    }
+void V93XX_UartTransport::RegisterBlockRead(uint32_t (&values)[], uint8_t num_values) {
+    (void)RegisterBlockReadStatus(values, num_values);
 }
 
-void V93XX_UART::RegisterBlockRead(uint32_t (&values)[], uint8_t num_values) {
-    // Described in Section 7.5 of Datasheet
-    uint8_t request[4] = {// Header
-                          0x7d,
-
-                          // CMD1 (request length, addr, operation)
-                          (uint8_t)(((num_values - 1) << 4) | ((this->device_address) << 2) | CmdOperation::BLOCK),
-                          // CMD2 (Start address)
-                          0x00,
-
-                          // Checksum
-                          0x00};
-
-    // Calculate Checksum, Sum of request &0xFF
-    request[3] = 0x33 + ~(request[1] + request[2]);
-
-    // Transmit request
-    this->serial.write(request, sizeof(request) / sizeof(uint8_t));
-    this->serial.flush();
+V93XX_UartTransport::FrameStatus V93XX_UartTransport::RegisterBlockReadStatus(uint32_t (&values)[],
+                                                                              uint8_t num_values) {
+    uint32_t start = this->link_stats.Begin();
+    FrameStatus status = BlockReadFrame(values, num_values);
+    this->link_stats.End(V93XX_Op::BlockRead, start, status, V93XX_Frames::kUartRequestSize, this->response_received);
+    return status;
+}
 
-    // wait for response (6 bytes per value: marker + 4 data + checksum)
-    if (!this->WaitForRx((6 * num_values) + 1, 200)) {
-        Serial.println("RegisterBlockRead(): timeout waiting for response");
-        return;
+V93XX_UartTransport::FrameStatus V93XX_UartTransport::BlockReadFrame(uint32_t (&values)[], uint8_t num_values) {
+    if (num_values == 0 || num_values > V93XX_Frames::kMaxBlockWords) {
+        return FrameStatus::InvalidArgument;
     }
 
-    // Read response: for each value, skip marker then read 4 data bytes, then final checksum
+    // Described in Section 7.5 of Datasheet; the request is sent straight from the constexpr table
+    const V93XX_Frames::UartRequest &request = this->block_requests[num_values - 1];
+    this->Transmit(request.bytes, sizeof(request.bytes), (5 * num_values) + 1);
+
+    // Response: for each value a marker then 4 data bytes, then a final checksum, consumed as it arrives.
     // Per datasheet: CKSUM = 0x33 + ~(CMD1 + CMD2 + sum of all data bytes)
-    uint8_t checksum = request[1] + request[2]; // Start with CMD1 + CMD2
-    for (int i = 0; i < num_values; i++) {
-        (void)this->RxBufferPop(); // Skip marker byte
-        uint8_t response[4];
-        for (int j = 0; j < 4; j++) {
-            response[j] = this->RxBufferPop();
-            checksum += response[j];
+    V93XX_Frames::RunningChecksum checksum = request.ResponseChecksum();
+    uint32_t start = millis();
+    bool complete = this->RxSyncMarker(start, 200);
+    bool aligned = true;
+    for (int i = 0; complete && aligned && i < num_values; i++) {
+        uint8_t marker = V93XX_Frames::kMarker;
+        if (i > 0) {
+            // Within a frame the markers must line up; a mismatch means a byte was lost or inserted.
+            complete = this->RxPopWithin(marker, start, 200);
+            aligned = !complete || marker == V93XX_Frames::kMarker;
+        }
+        uint8_t response[4] = {0};
+        for (int j = 0; complete && aligned && j < 4; j++) {
+            complete = this->RxPopWithin(response[j], start, 200);
+            checksum.Add(response[j]);
         }
-        values[i] = response[0] | (response[1] << 8) | (response[2] << 16) | (response[3] << 24);
+        values[i] = (uint32_t)response[0] | ((uint32_t)response[1] << 8) | ((uint32_t)response[2] << 16) |
+                    ((uint32_t)response[3] << 24);
     }
-    // V9381 checksum per datasheet: 0x33 + ~(CMD1 + CMD2 + data bytes)
-    checksum = 0x33 + ~(checksum);
-
-    // Validate checksum
-    uint8_t response_checksum = this->RxBufferPop();
-    bool checksum_valid = checksum == response_checksum;
+    uint8_t response_checksum = 0;
+    if (complete && aligned) {
+        (void)this->RxPopWithin(response_checksum, start, 200);
+    }
+    FrameStatus status = this->EndFrame();
+    if (!aligned && status != FrameStatus::Overrun) {
+        status = FrameStatus::BadMarker;
+    }
+    if (status != FrameStatus::Ok) {
+        this->last_frame_status = status;
+        Serial.printf("RegisterBlockRead(%d values): no valid response (status %u)\n", num_values, (unsigned)status);
+        for (uint8_t i = 0; i < num_values; i++) {
+            values[i] = 0;
+        }
+        return status;
+    }
+    bool checksum_valid = checksum.Matches(response_checksum);
+    this->last_frame_status = checksum_valid ? FrameStatus::Ok : FrameStatus::BadChecksum;
 
-    Serial.printf("RegisterBlockRead(%d values): CRC expected=0x%02X received=0x%02X %s", num_values, checksum,
-                  response_checksum, checksum_valid ? "✓" : "✗");
+    Serial.printf("RegisterBlockRead(%d values): CRC expected=0x%02X received=0x%02X %s", num_values,
+                  checksum.Expected(), response_checksum, checksum_valid ? "✓" : "✗");
 
     if (!checksum_valid && this->checksum_mode == ChecksumMode::Clean) {
         Serial.println(" - ERROR: CRC mismatch! (Clean mode)");
@@ -295,97 +355,22 @@ void V93XX_UART::RegisterBlockRead(uint32_t (&values)[], uint8_t num_values) {
     } else {
         Serial.println();
     }
-}
-
-bool V93XX_UART::CaptureWaveform(uint32_t *buffer, size_t word_count, uint32_t ctrl5, uint32_t timeout_ms,
-                                 uint8_t block_words) {
-    if (!buffer || word_count == 0) {
-        return false;
-    }
-
-    RegisterWrite(SYS_INTSTS, SYS_INTSTS_WAVEOV | SYS_INTSTS_WAVESTORE | SYS_INTSTS_WAVEUPD);
-
-    uint32_t ctrl5_value = ctrl5 | DSP_CTRL5_WAVE_ADDR_CLR | DSP_CTRL5_TRIG_MANUAL;
-    RegisterWrite(DSP_CTRL5, ctrl5_value);
-
-    uint32_t start = millis();
-    bool overflow = false;
-    bool complete = false;
-    while ((millis() - start) < timeout_ms) {
-        uint32_t sys_intsts = RegisterRead(SYS_INTSTS);
-        if (sys_intsts & SYS_INTSTS_WAVEOV) {
-            overflow = true;
-            complete = true;
-            break;
-        }
-        if (sys_intsts & SYS_INTSTS_WAVESTORE) {
-            complete = true;
-            break;
-        }
-        delay(1);
-    }
 
-    if (!complete) {
-        return false;
-    }
-
-    uint16_t wavestore_cnt = (RegisterRead(SYS_MISC) & SYS_MISC_WAVESTORE_CNT_Msk) >> SYS_MISC_WAVESTORE_CNT_Pos;
-    if (wavestore_cnt > 0 && wavestore_cnt < word_count) {
-        word_count = wavestore_cnt;
-    }
-
-    uint8_t block_read_addrs[16];
-    for (size_t i = 0; i < 16; i++) {
-        block_read_addrs[i] = DAT_WAVE;
-    }
-    ConfigureBlockRead(block_read_addrs, 16);
-
-    uint8_t per_read = block_words;
-    if (per_read == 0 || per_read > 16) {
-        per_read = 16;
-    }
-
-    size_t index = 0;
-    size_t remaining = word_count;
-    while (remaining > 0) {
-        uint8_t read_size = (remaining < per_read) ? (uint8_t)remaining : per_read;
-        uint32_t data[16] = {0};
-        RegisterBlockRead(data, read_size);
-        for (uint8_t i = 0; i < read_size; i++) {
-            buffer[index++] = data[i];
+    // Clean mode never hands out data from a corrupt frame.
+    if (!checksum_valid && this->checksum_mode == ChecksumMode::Clean) {
+        for (uint8_t i = 0; i < num_values; i++) {
+            values[i] = 0;
         }
-        remaining -= read_size;
-        delay(V93XX_INTERFRAME_DELAY_MS);
     }
-
-    return !overflow;
+    return this->last_frame_status;
 }
 
-void V93XX_UART::LoadConfiguration(const V93XX_UART::ControlRegisters &ctrl,
-                                   const V93XX_UART::CalibrationRegisters &calibrations) {
-    uint32_t checksum = 0;
-
-    // Load control values [0x00 - 0x07]
-    for (int i = 0; i < sizeof(V93XX_UART::ControlRegisters) / sizeof(uint32_t); i++) {
-        this->RegisterWrite(ControlAddresses[i], ctrl._array[i]);
-        checksum += ctrl._array[i];
-    }
-
-    // Load calibration values [0x25 - 0x3a]
-    for (int i = 0; i < sizeof(V93XX_UART::CalibrationRegisters) / sizeof(uint32_t); i++) {
-        this->RegisterWrite(CalibrationAddresses[i], calibrations._array[i]);
-        checksum += calibrations._array[i];
-    }
-
-    // TODO: Update checksum when configuring [0x55-0x60]
-
-    // The sum of {0x00-0x07, 0x25-0x3a, 0x55-0x60} Needs to equal 0xFFFF_FFFFF to pass self-check.
-    // Calculate DSP_CFG_CKSUM (0x28) to ensure this is the case
-    checksum = 0xFFFFFFFF - checksum;
-    this->RegisterWrite(DSP_CFG_CKSUM, checksum);
+void V93XX_UartTransport::Recover() {
+    RxReset();
+    Init(this->serial_config, this->checksum_mode);
 }
 
-void V93XX_UART::SetChecksumMode(ChecksumMode mode) {
+void V93XX_UartTransport::SetChecksumMode(ChecksumMode mode) {
     this->checksum_mode = mode;
     if (mode == ChecksumMode::Dirty) {
         Serial.println("Checksum Mode: Dirty (skip CRC validation, show expected vs received)");
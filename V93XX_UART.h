@@ -1,101 +1,109 @@
 #ifndef V93XX_UART_H__
 #define V93XX_UART_H__
 
+#include "V93XX.h"
+#include "V93XX_Frames.h"
+#include "V93XX_LinkTrace.h"
+#include "V93XX_Stats.h"
 #include "V93XX_Registers.h"
 #include <Arduino.h>
-#include <list>
-#include <queue>
 
-class V93XX_UART {
+/**
+ * @brief UART transport policy for V93XX<> (frames per datasheet section 7).
+ */
+class V93XX_UartTransport {
   public:
     enum class ChecksumMode : uint8_t {
         Dirty = 0,
         Clean = 1,
     };
 
-    struct __attribute__((packed)) ControlRegisters {
-        union {
-            uint32_t _array[8];
-            struct {
-                uint32_t DSP_ANA0;
-                uint32_t DSP_ANA1;
-                uint32_t DSP_CTRL0;
-                uint32_t DSP_CTRL1;
-                uint32_t DSP_CTRL2;
-                uint32_t DSP_CTRL3;
-                uint32_t DSP_CTRL4;
-                uint32_t DSP_CTRL5;
-            };
-        };
-    };
+    // Per-frame outcome (see V93XX_Status.h)
+    typedef V93XX_Status FrameStatus;
 
-    struct __attribute__((packed)) CalibrationRegisters {
-        union {
-            uint32_t _array[22];
-            struct {
-                uint32_t DSP_CFG_CALI_PA;
-                uint32_t DSP_CFG_DC_PA;
-                uint32_t DSP_CFG_CALI_QA;
-                uint32_t DSP_CFG_DC_QA;
-                uint32_t DSP_CFG_CALI_PB;
-                uint32_t DSP_CFG_DC_PB;
-                uint32_t DSP_CFG_CALI_QB;
-                uint32_t DSP_CFG_DC_QB;
-                uint32_t DSP_CFG_CALI_RMSUA;
-                uint32_t DSP_CFG_RMS_DCUA;
-                uint32_t DSP_CFG_CALI_RMSIA;
-                uint32_t DSP_CFG_RMS_DCIA;
-                uint32_t DSP_CFG_CALI_RMSIB;
-                uint32_t DSP_CFG_RMS_DCIB;
-                uint32_t DSP_CFG_PHC;
-                uint32_t DSP_CFG_DCUA;
-                uint32_t DSP_CFG_DCIA;
-                uint32_t DSP_CFG_DCIB;
-                uint32_t DSP_CFG_BPF;
-                uint32_t DSP_CFG_CKSUM;
-                uint32_t EGY_PROCTH;
-                uint32_t EGY_PWRTH;
-            };
-        };
-    };
+    static constexpr bool kNativeBlockRead = true;
+    static constexpr uint32_t kInterBlockDelayMs = V93XX_INTERFRAME_DELAY_MS;
+    // 19200 baud, 11 bits per character (start, 8 data, parity, stop)
+    static constexpr uint32_t kByteTimeUs = (11UL * 1000000UL + 19199UL) / 19200UL;
 
-    V93XX_UART(int rx_pin, int tx_pin, HardwareSerial &serial, int device_address);
+    V93XX_UartTransport(int rx_pin, int tx_pin, HardwareSerial &serial, int device_address);
     void RxReset();
     void Init(SerialConfig config = SerialConfig::SERIAL_8O1, ChecksumMode checksum_mode = ChecksumMode::Dirty);
 
     void RegisterWrite(uint8_t address, uint32_t data);
     uint32_t RegisterRead(uint8_t address);
+    bool RegisterReadChecked(uint8_t address, uint32_t &out_value);
+
+    // Checksum-valid frame required regardless of ChecksumMode.
+    bool RegisterReadStrict(uint8_t address, uint32_t &out_value);
 
-    void ConfigureBlockRead(const uint8_t addresses[], uint8_t num_addresses);
     void RegisterBlockRead(uint32_t (&values)[], uint8_t num_values);
 
-    bool CaptureWaveform(uint32_t *buffer, size_t word_count, uint32_t ctrl5, uint32_t timeout_ms = 1000,
-                         uint8_t block_words = 16);
+    // Single attempt with the frame status; a failed frame yields 0 in Clean mode.
+    FrameStatus RegisterReadStatus(uint8_t address, uint32_t &out_value);
+    FrameStatus RegisterWriteStatus(uint8_t address, uint32_t data);
+    FrameStatus RegisterBlockReadStatus(uint32_t (&values)[], uint8_t num_values);
 
-    void LoadConfiguration(const ControlRegisters &ctrl, const CalibrationRegisters &calibrations);
+    uint32_t ByteTimeUs() const { return kByteTimeUs; }
 
     void SetChecksumMode(ChecksumMode mode);
 
+    FrameStatus LastFrameStatus() const { return this->last_frame_status; }
+
+    // Stale bytes flushed before a request plus noise skipped while searching for the marker.
+    uint32_t DiscardedBytes() const { return this->discarded_bytes; }
+
+    // Log TX bytes and consumed RX bytes to a V93XX_LinkTrace (nullptr to stop).
+    void SetLinkTrace(V93XX_LinkTrace *trace) { this->link_trace = trace; }
+
+  protected:
+    // Last values written to SYS_BLK_ADDR0..3; bit n of block_addr_valid marks word n as known.
+    uint32_t block_addr_shadow[4] = {0};
+    uint8_t block_addr_valid = 0;
+
+    V93XX_StatsRecorder link_stats;
+
+    bool LinkReady() const { return true; }
+    void Recover();
+    void SetBlockReadView(const uint8_t[], uint8_t) {}
+
   private:
     HardwareSerial &serial;
     int device_address;
+    // Precomputed request rows for device_address (see V93XX_Frames.h)
+    const V93XX_Frames::UartRequest *read_requests;
+    const V93XX_Frames::UartRequest *block_requests;
     int tx_pin;
     int rx_pin;
+    SerialConfig serial_config = SerialConfig::SERIAL_8O1;
     ChecksumMode checksum_mode = ChecksumMode::Dirty;
 
-    std::queue<uint8_t, std::list<uint8_t>> serial_rx_buffer{std::queue<uint8_t, std::list<uint8_t>>()};
+    // RX ring filled by RxReceive(); sized above the largest response (16-word block read: 81 bytes).
+    static constexpr size_t kRxBufferSize = 128;
+    uint8_t rx_buffer[kRxBufferSize] = {0};
+    volatile size_t rx_head = 0;
+    volatile size_t rx_tail = 0;
+    volatile bool rx_overrun = false;
+
+    // Outstanding request: response bytes expected and consumed so far.
+    size_t response_expected = 0;
+    size_t response_received = 0;
+    FrameStatus last_frame_status = FrameStatus::Ok;
+    uint32_t discarded_bytes = 0;
+    V93XX_LinkTrace *link_trace = nullptr;
 
     void RxReceive();
-    uint8_t RxBufferPop();
-    unsigned int RxBufferCount();
-    bool WaitForRx(size_t count, uint32_t timeout_ms);
-
-    enum CmdOperation {
-        BROADCAST = 0,
-        READ = 1,
-        WRITE = 2,
-        BLOCK = 3,
-    };
+    void RxFlush();
+    bool RxBufferPop(uint8_t &data);
+    bool RxPopWithin(uint8_t &data, uint32_t start_ms, uint32_t timeout_ms);
+    bool RxSyncMarker(uint32_t start_ms, uint32_t timeout_ms);
+    void Transmit(const uint8_t *frame, size_t length, size_t response_length);
+    FrameStatus EndFrame();
+    FrameStatus ReadFrame(uint8_t address, uint32_t &out_value);
+    FrameStatus WriteFrame(uint8_t address, uint32_t data);
+    FrameStatus BlockReadFrame(uint32_t (&values)[], uint8_t num_values);
 };
 
+typedef V93XX<V93XX_UartTransport> V93XX_UART;
+
 #endif
@@ -0,0 +1,259 @@
+#include "V93XX_WaveCodec.h"
+
+using namespace V93XX_WaveCodec;
+
+namespace {
+
+// Oldest first: x[0..kMaxOrder-1] is the history, the block's samples follow.
+typedef int32_t Window[kMaxOrder + kMaxBlockSamples];
+
+int32_t Predict(const int32_t *x, uint8_t order) {
+    switch (order) {
+    case 1:
+        return x[-1];
+    case 2:
+        return 2 * x[-1] - x[-2];
+    case 3:
+        return 3 * x[-1] - 3 * x[-2] + x[-3];
+    default:
+        return 0;
+    }
+}
+
+uint32_t ZigZag(int32_t r) { return ((uint32_t)r << 1) ^ (uint32_t)(r >> 31); }
+int32_t UnZigZag(uint32_t u) { return (int32_t)(u >> 1) ^ -(int32_t)(u & 1); }
+
+uint32_t RiceBits(uint32_t u, uint8_t k) {
+    uint32_t q = u >> k;
+    return (q < kEscapeQuotient) ? q + 1 + k : kEscapeQuotient + kEscapeBits;
+}
+
+struct BitWriter {
+    uint8_t *out;
+    size_t length = 0;
+    uint32_t acc = 0;
+    uint8_t bits = 0;
+
+    explicit BitWriter(uint8_t *out) : out(out) {}
+
+    void Put(uint32_t value, uint8_t count) { // count <= 24
+        this->acc = (this->acc << count) | (value & ((1UL << count) - 1));
+        this->bits += count;
+        while (this->bits >= 8) {
+            this->bits -= 8;
+            this->out[this->length++] = (uint8_t)(this->acc >> this->bits);
+        }
+    }
+
+    void Flush() {
+        if (this->bits) {
+            this->out[this->length++] = (uint8_t)(this->acc << (8 - this->bits));
+            this->bits = 0;
+        }
+    }
+};
+
+struct BitReader {
+    const uint8_t *data;
+    size_t length;
+    size_t pos = 0;
+    uint32_t acc = 0;
+    uint8_t bits = 0;
+
+    BitReader(const uint8_t *data, size_t length) : data(data), length(length) {}
+
+    bool Get(uint8_t count, uint32_t &value) { // count <= 24
+        while (this->bits < count) {
+            if (this->pos >= this->length) {
+                return false;
+            }
+            this->acc = (this->acc << 8) | this->data[this->pos++];
+            this->bits += 8;
+        }
+        this->bits -= count;
+        value = (this->acc >> this->bits) & ((1UL << count) - 1);
+        return true;
+    }
+};
+
+void LoadWindow(Window x, const int32_t history[kMaxOrder], const int16_t *samples, uint8_t count) {
+    for (uint8_t i = 0; i < kMaxOrder; i++) {
+        x[i] = history[kMaxOrder - 1 - i];
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        x[kMaxOrder + i] = samples[i];
+    }
+}
+
+void StoreHistory(int32_t history[kMaxOrder], const Window x, uint8_t count) {
+    for (uint8_t i = 0; i < kMaxOrder; i++) {
+        history[i] = x[kMaxOrder + count - 1 - i];
+    }
+}
+
+uint8_t BitLength(uint32_t value) {
+    uint8_t n = 0;
+    while (value) {
+        n++;
+        value >>= 1;
+    }
+    return n;
+}
+
+} // namespace
+
+void V93XX_WaveEncoder::Reset() {
+    for (uint8_t i = 0; i < kMaxOrder; i++) {
+        this->history[i] = 0;
+    }
+}
+
+size_t V93XX_WaveEncoder::EncodeSamples(const int16_t *samples, uint8_t count, uint8_t *out) {
+    if (count == 0 || count > kMaxBlockSamples) {
+        return 0;
+    }
+    Window x;
+    LoadWindow(x, this->history, samples, count);
+    const int32_t *block = x + kMaxOrder;
+
+    // Pick order and k by exact bit count; k is searched around log2 of the mean residual.
+    uint32_t best_bits = 16UL * count;
+    uint8_t best_order = 0;
+    uint8_t best_k = kVerbatim;
+    for (uint8_t order = 0; order <= kMaxOrder; order++) {
+        uint32_t sum = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            sum += ZigZag(block[i] - Predict(block + i, order));
+        }
+        uint8_t estimate = BitLength(sum / count);
+        uint8_t k_first = (estimate > 2) ? (uint8_t)(estimate - 2) : 0;
+        for (uint8_t k = k_first; k <= estimate + 1 && k <= kMaxRiceK; k++) {
+            uint32_t bits = 0;
+            for (uint8_t i = 0; i < count && bits < best_bits; i++) {
+                bits += RiceBits(ZigZag(block[i] - Predict(block + i, order)), k);
+            }
+            if (bits < best_bits) {
+                best_bits = bits;
+                best_order = order;
+                best_k = k;
+            }
+        }
+    }
+
+    out[0] = count;
+    out[1] = (uint8_t)((best_order << 6) | best_k);
+    BitWriter writer(out + 2);
+    for (uint8_t i = 0; i < count; i++) {
+        if (best_k == kVerbatim) {
+            writer.Put((uint16_t)block[i], 16);
+            continue;
+        }
+        uint32_t u = ZigZag(block[i] - Predict(block + i, best_order));
+        uint32_t q = u >> best_k;
+        if (q < kEscapeQuotient) {
+            writer.Put(((1UL << q) - 1) << 1, (uint8_t)(q + 1));
+            writer.Put(u, best_k);
+        } else {
+            writer.Put((1UL << kEscapeQuotient) - 1, kEscapeQuotient);
+            writer.Put(u, kEscapeBits);
+        }
+    }
+    writer.Flush();
+    StoreHistory(this->history, x, count);
+    return 2 + writer.length;
+}
+
+size_t V93XX_WaveEncoder::EncodeWords(const uint32_t *words, uint8_t word_count, uint8_t *out) {
+    if (word_count == 0 || word_count > kMaxBlockSamples / 2) {
+        return 0;
+    }
+    int16_t samples[kMaxBlockSamples];
+    for (uint8_t i = 0; i < word_count; i++) {
+        samples[2 * i] = (int16_t)(words[i] & 0xFFFF);
+        samples[2 * i + 1] = (int16_t)(words[i] >> 16);
+    }
+    return EncodeSamples(samples, (uint8_t)(2 * word_count), out);
+}
+
+void V93XX_WaveDecoder::Reset() {
+    for (uint8_t i = 0; i < kMaxOrder; i++) {
+        this->history[i] = 0;
+    }
+}
+
+size_t V93XX_WaveDecoder::DecodeSamples(const uint8_t *data, size_t length, int16_t *samples, uint8_t &count) {
+    count = 0;
+    if (length < 2 || data[0] == 0 || data[0] > kMaxBlockSamples) {
+        return 0;
+    }
+    const uint8_t n = data[0];
+    const uint8_t order = data[1] >> 6;
+    const uint8_t k = data[1] & 0x1F;
+    if ((data[1] & 0x20) || (k > kMaxRiceK && k != kVerbatim)) {
+        return 0;
+    }
+
+    Window x;
+    LoadWindow(x, this->history, samples, 0);
+    int32_t *block = x + kMaxOrder;
+    BitReader reader(data + 2, length - 2);
+    for (uint8_t i = 0; i < n; i++) {
+        uint32_t value;
+        if (k == kVerbatim) {
+            if (!reader.Get(16, value)) {
+                return 0;
+            }
+            block[i] = (int16_t)value;
+            continue;
+        }
+        uint32_t q = 0;
+        uint32_t bit;
+        while (q < kEscapeQuotient) {
+            if (!reader.Get(1, bit)) {
+                return 0;
+            }
+            if (!bit) {
+                break;
+            }
+            q++;
+        }
+        uint32_t u;
+        if (q == kEscapeQuotient) {
+            if (!reader.Get(kEscapeBits, u)) {
+                return 0;
+            }
+        } else {
+            if (!reader.Get(k, value)) {
+                return 0;
+            }
+            u = (q << k) | value;
+        }
+        int32_t sample = Predict(block + i, order) + UnZigZag(u);
+        if (sample < INT16_MIN || sample > INT16_MAX) {
+            return 0;
+        }
+        block[i] = sample;
+    }
+
+    for (uint8_t i = 0; i < n; i++) {
+        samples[i] = (int16_t)block[i];
+    }
+    StoreHistory(this->history, x, n);
+    count = n;
+    return 2 + reader.pos;
+}
+
+size_t V93XX_WaveDecoder::DecodeWords(const uint8_t *data, size_t length, uint32_t *words, uint8_t &word_count) {
+    int16_t samples[kMaxBlockSamples];
+    uint8_t count = 0;
+    word_count = 0;
+    size_t used = DecodeSamples(data, length, samples, count);
+    if (used == 0 || (count & 1)) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < count / 2; i++) {
+        words[i] = (uint16_t)samples[2 * i] | ((uint32_t)(uint16_t)samples[2 * i + 1] << 16);
+    }
+    word_count = count / 2;
+    return used;
+}
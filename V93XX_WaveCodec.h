@@ -0,0 +1,82 @@
+#ifndef V93XX_WAVECODEC_H__
+#define V93XX_WAVECODEC_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Lossless block codec for 16-bit DAT_WAVE samples (fixed linear prediction + Rice codes).
+ *
+ * Each block is self-delimiting:
+ *   uint8 sample_count (1-64)
+ *   uint8 mode: bits 7:6 predictor order (0-3), bits 4:0 Rice parameter k, or kVerbatim
+ *   residual bit stream, MSB first, zero-padded to a whole byte
+ *
+ * The predictor of order p is the p-th order polynomial through the previous samples
+ * (0: 0, 1: x[n-1], 2: 2x[n-1] - x[n-2], 3: 3x[n-1] - 3x[n-2] + x[n-3]); the encoder picks the order
+ * and k that give the fewest bits for each block. A residual r is zigzag-mapped to u and written as
+ * u >> k in unary (ones, then a zero) followed by the low k bits of u; a quotient of kEscapeQuotient
+ * or more is written as kEscapeQuotient ones followed by u in kEscapeBits bits. Verbatim blocks store
+ * the samples as big-endian int16 and bound a block at 2 + 2 * sample_count bytes.
+ *
+ * History carries over between blocks, so a capture is coded as one stream: call Reset() on both ends
+ * at the start of every capture and decode blocks in order. Neither side allocates; both are
+ * Arduino-independent (tools/host/bench_wavecodec.cpp).
+ */
+namespace V93XX_WaveCodec {
+
+constexpr uint8_t kMaxBlockSamples = 64;
+constexpr size_t kMaxBlockBytes = 2 + 2 * (size_t)kMaxBlockSamples;
+constexpr uint8_t kMaxOrder = 3;
+constexpr uint8_t kMaxRiceK = 18;
+constexpr uint8_t kVerbatim = 0x1F;
+constexpr uint8_t kEscapeQuotient = 16;
+constexpr uint8_t kEscapeBits = 20; // Holds any zigzagged order-3 residual of 16-bit samples
+
+} // namespace V93XX_WaveCodec
+
+class V93XX_WaveEncoder {
+  public:
+    /**
+     * @brief Start a new capture (clears the prediction history).
+     */
+    void Reset();
+
+    /**
+     * @param out At least V93XX_WaveCodec::kMaxBlockBytes
+     * @return Bytes written; 0 if @p count is 0 or above kMaxBlockSamples
+     */
+    size_t EncodeSamples(const int16_t *samples, uint8_t count, uint8_t *out);
+
+    /**
+     * @brief Encode packed DAT_WAVE words (low half first, as in V93XX_WaveformChunk) as one block.
+     * @param word_count 1-32
+     */
+    size_t EncodeWords(const uint32_t *words, uint8_t word_count, uint8_t *out);
+
+  private:
+    int32_t history[V93XX_WaveCodec::kMaxOrder] = {0}; // history[0] is the newest sample
+};
+
+class V93XX_WaveDecoder {
+  public:
+    void Reset();
+
+    /**
+     * @param samples At least kMaxBlockSamples entries
+     * @param[out] count Samples decoded
+     * @return Bytes consumed, or 0 if the block is truncated or malformed
+     */
+    size_t DecodeSamples(const uint8_t *data, size_t length, int16_t *samples, uint8_t &count);
+
+    /**
+     * @brief Decode a block written by EncodeWords() back into packed words.
+     * @param words At least kMaxBlockSamples / 2 entries
+     */
+    size_t DecodeWords(const uint8_t *data, size_t length, uint32_t *words, uint8_t &word_count);
+
+  private:
+    int32_t history[V93XX_WaveCodec::kMaxOrder] = {0};
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef V93XX_WAVEFORM_H__
+#define V93XX_WAVEFORM_H__
+
+#include "V93XX_Status.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief One block read of a streamed waveform capture (CaptureWaveform() with a sink).
+ *
+ * Pointers are valid only during the sink call.
+ */
+struct V93XX_WaveformChunk {
+    size_t first_word;      // Index of words[0] in the capture (samples[0] is sample 2 * first_word)
+    const uint32_t *words;  // Raw DAT_WAVE words
+    uint8_t word_count;     // 1-16
+    const int16_t *samples; // Each word unpacked low half first (single-channel layout: sample 2n, 2n+1)
+    uint8_t sample_count;   // 2 * word_count
+    V93XX_Status status;    // Outcome of this block read
+    bool overflow;          // The chip reported WAVEOV for this capture
+    bool last;              // No further chunks follow
+};
+
+/**
+ * @brief Waveform chunk consumer.
+ * @return false to stop the capture early (the remaining words are not read)
+ */
+typedef bool (*V93XX_WaveformSink)(const V93XX_WaveformChunk &chunk, void *context);
+
+#endif
@@ -1,10 +1,33 @@
+#include "V93XX_Events.h"
+#include "V93XX_Telemetry.h"
 #include "V93XX_UART.h"
 
 const int V93XX_TX_PIN = 16;
 const int V93XX_RX_PIN = 15;
 const int V93XX_DEVICE_ADDRESS = 0x00;
+const uint32_t WAVE_STATUS_BITS = SYS_INTSTS_WAVEOV | SYS_INTSTS_WAVESTORE | SYS_INTSTS_WAVEUPD;
 
 V93XX_UART raccoon(V93XX_RX_PIN, V93XX_TX_PIN, Serial1, V93XX_DEVICE_ADDRESS);
+V93XX_Events<V93XX_UART> events(raccoon);
+V93XX_Telemetry telemetry;
+bool telemetry_started = false;
+
+static void WriteSerial(const uint8_t *data, size_t length, void *context) {
+    (void)context;
+    Serial.write(data, length);
+}
+
+// Every pending status bit is reported once, then cleared by the dispatcher.
+static void OnStatus(uint32_t bits, void *context) {
+    (void)context;
+    if (telemetry_started) {
+        telemetry.SendEvent(bits);
+    } else {
+        Serial.printf("Interrupt Register: %08X\n", bits);
+    }
+}
+
+static uint32_t Millis() { return millis(); }
 
 void setup() {
     Serial.begin(115200);
@@ -15,10 +38,10 @@ void setup() {
 
     uint32_t register_value;
 
-    // Read system status
-    raccoon.RegisterWrite(SYS_INTSTS, 0xFFFFFFFF);
-    register_value = raccoon.RegisterRead(SYS_INTSTS);
-    Serial.printf("Interrupt Register: %08X\n", register_value);
+    // Report and clear the system status left over from power-up. The wave bits belong to
+    // CaptureWaveform(), which clears them when it arms a capture.
+    events.On(SYS_INTSTS_Msk & ~WAVE_STATUS_BITS, OnStatus);
+    events.Poll();
 
     register_value = raccoon.RegisterRead(SYS_VERSION);
     Serial.printf("System Version: %08X\n", register_value);
@@ -59,18 +82,17 @@ void setup() {
     raccoon.RegisterWrite(SYS_IOCFG0, 0x00000000);
     raccoon.RegisterWrite(SYS_IOCFG1, 0x003C3A00);
 
-    // Clear checksum error, not that calibration is loaded
-    raccoon.RegisterWrite(SYS_INTSTS, SYS_INTSTS_CKERR);
+    // Report and clear the checksum error raised while the calibration was loading
+    events.Poll();
 
-    register_value = raccoon.RegisterRead(SYS_INTSTS);
-    Serial.printf("Interrupt Register: %08X\n", register_value);
+    // Captures go out as binary frames: decode with tools/telemetry_decode.py. From here on the
+    // capture's status polls go through the dispatcher, and status bits go out as event frames.
+    telemetry.Begin(WriteSerial, nullptr, Millis);
+    telemetry_started = true;
+    raccoon.SetInterruptStatusSource(V93XX_Events<V93XX_UART>::StatusSource, &events);
 }
 
 void loop() {
-    uint32_t waveform_buffer[309];
-
-    Serial.printf("Configure Waveform capture:\n");
-
     const uint32_t ctrl5 =
         // Transmit Starting by manual, stops on max cycle
         ((0 << DSP_CTRL5_DMAMODE_Pos) & DSP_CTRL5_DMAMODE_Msk)
@@ -83,30 +105,19 @@ void loop() {
         // Manual trigger mode
         | DSP_CTRL5_WAVEMEM_MODE_MANUAL_SINGLE;
 
-    const int waveform_size = sizeof(waveform_buffer) / sizeof(waveform_buffer[0]);
-    bool capture_ok = raccoon.CaptureWaveform(waveform_buffer, waveform_size, ctrl5, 1000, 16);
+    telemetry.BeginCapture(ctrl5);
+    bool capture_ok = raccoon.CaptureWaveform(V93XX_Telemetry::WaveformSink, &telemetry, 309, ctrl5, 1000, 16);
     if (!capture_ok) {
-        Serial.println("Waveform capture failed or overflowed");
+        // OnStatus() reports every other pending bit; add the wave bits that ended the capture.
+        uint32_t sys_intsts = 0;
+        if (events.Poll(&sys_intsts) == V93XX_Status::Ok) {
+            telemetry.SendEvent(sys_intsts & WAVE_STATUS_BITS);
+        }
     }
 
-    // Dump waveform data
-    Serial.printf("\nwave_data = [ \n");
-    for (int i = 0; i < waveform_size; i++) {
-        int16_t upper = (waveform_buffer[i] >> 16) & 0xFFFF;
-        int16_t lower = waveform_buffer[i] & 0xFFFF;
-        Serial.printf("%5d, %5d%s", lower, upper, (i != waveform_size - 1) ? (i % 8 == 7) ? ",\n" : ", " : "");
-    }
-    Serial.printf("]\n");
-
-    /* Data can be take from a serial terminal and plotted in Python
-        ```python
-        wave_data = [ ..... ]
-
-        # plot wave_data
-        import matplotlib.pyplot as plt
-        plt.plot(wave_data)
-        plt.show()
-        ```
+    /* Decode on the PC and plot the saved samples:
+        python tools/telemetry_decode.py --port /dev/ttyUSB0 --save captures/
+        python tools/plot_v9360_waveform.py --csv captures/capture_1.csv
     */
 
     /*
@@ -1,4 +1,5 @@
 #include "V93XX_SPI.h"
+#include "V93XX_Telemetry.h"
 
 // SPI pin definitions (ESP32-S3 VSPI/IOMUX defaults)
 #if defined(ARDUINO_ARCH_ESP32)
@@ -11,6 +12,14 @@ const int V93XX_CS_PIN = 5;
 #endif
 
 V93XX_SPI v9381(V93XX_CS_PIN);
+V93XX_Telemetry telemetry;
+
+static void WriteSerial(const uint8_t *data, size_t length, void *context) {
+    (void)context;
+    Serial.write(data, length);
+}
+
+static uint32_t Millis() { return millis(); }
 
 void setup() {
     Serial.begin(115200);
@@ -79,12 +88,12 @@ void setup() {
     v9381.RegisterWrite(SYS_INTSTS, SYS_INTSTS_CKERR);
 
     Serial.println("Configuration complete. Starting waveform capture...\n");
+
+    // From here on waveforms go out as binary frames: run tools/telemetry_decode.py on the port.
+    telemetry.Begin(WriteSerial, nullptr, Millis);
 }
 
 void loop() {
-    // Allocate waveform buffer (309 words = 618 samples)
-    uint32_t waveform_buffer[309] = {0};
-
     // Configure DSP_CTRL5 for waveform capture
     // - Manual single trigger mode
     // - Channel UA (Voltage A)
@@ -93,30 +102,17 @@ void loop() {
                            DSP_CTRL5_WAVE_U | ((0 << DSP_CTRL5_WAVE_LEN_Pos) & DSP_CTRL5_WAVE_LEN_Msk) |
                            DSP_CTRL5_WAVEMEM_MODE_MANUAL_SINGLE;
 
-    // Capture waveform using CaptureWaveform() API
+    // Capture 309 words (618 samples) with the sink overload: each 16-word block is sent as one
+    // binary frame (87 bytes) as soon as it is read, so no capture buffer is needed.
     // SPI is fast, so default timeout (1000ms) and block size (16) work well
-    bool capture_ok = v9381.CaptureWaveform(waveform_buffer, 309, ctrl5);
+    telemetry.BeginCapture(ctrl5);
+    bool capture_ok = v9381.CaptureWaveform(V93XX_Telemetry::WaveformSink, &telemetry, 309, ctrl5);
     if (!capture_ok) {
-        Serial.println("Waveform capture failed or timed out");
+        // Let the host see why (WAVEOV, CKERR, ...) next to the incomplete capture.
+        telemetry.SendEvent(v9381.RegisterRead(SYS_INTSTS));
         delay(1000);
         return;
     }
 
-    // Print waveform data as Python-compatible array
-    // Each 32-bit word contains two 16-bit signed samples (lower, upper)
-    Serial.println("\nWaveform Data (Python format):");
-    Serial.println("wave_data = [");
-    for (int i = 0; i < 309; i++) {
-        int16_t lower = (int16_t)(waveform_buffer[i] & 0xFFFF);
-        int16_t upper = (int16_t)((waveform_buffer[i] >> 16) & 0xFFFF);
-
-        // Format: 8 pairs per line, comma-separated
-        Serial.printf("%5d, %5d%s", lower, upper, (i != 308) ? ((i % 8 == 7) ? ",\n" : ", ") : "");
-    }
-    Serial.println("\n]");
-
-    Serial.printf("\nCaptured 309 words (618 samples)\n");
-    Serial.println("Copy data to Python for plotting with tools/plot_v9360_waveform.py\n");
-
     delay(2000); // 0.5 Hz capture rate
 }
@@ -1,3 +1,4 @@
+#include "V93XX_Telemetry.h"
 #include "V93XX_UART.h"
 
 #if defined(ARDUINO_ARCH_ESP32)
@@ -15,6 +16,50 @@ const int V93XX_ADDR1_PIN = 10;
 const int V93XX_DEVICE_ADDRESS = 0x00;
 
 V93XX_UART v9381(V93XX_UART_RX_PIN, V93XX_UART_TX_PIN, Serial1, V93XX_DEVICE_ADDRESS);
+V93XX_Telemetry telemetry;
+V93XX_WaveEncoder wave_encoder;
+
+// Lossless compression (V93XX_WaveCodec) cuts the bytes per capture on slow links.
+const bool kCompressWaveforms = true;
+
+const V93XX_UART::ControlRegisters kControl = {.DSP_ANA0 = 0x00100C00,
+                                               .DSP_ANA1 = 0x000C32C1,
+                                               .DSP_CTRL0 = 0x01000f07,
+                                               .DSP_CTRL1 = 0x000C32C1,
+                                               .DSP_CTRL2 = 0x00002723,
+                                               .DSP_CTRL3 = 0x00000000,
+                                               .DSP_CTRL4 = 0x00000000,
+                                               .DSP_CTRL5 = 0x00000000};
+
+const V93XX_UART::CalibrationRegisters kCalibration = {.DSP_CFG_CALI_PA = 0x00000000,
+                                                       .DSP_CFG_DC_PA = 0x00000000,
+                                                       .DSP_CFG_CALI_QA = 0x00000000,
+                                                       .DSP_CFG_DC_QA = 0x00000000,
+                                                       .DSP_CFG_CALI_PB = 0x00000000,
+                                                       .DSP_CFG_DC_PB = 0x00000000,
+                                                       .DSP_CFG_CALI_QB = 0x00000000,
+                                                       .DSP_CFG_DC_QB = 0x00000000,
+                                                       .DSP_CFG_CALI_RMSUA = 0x00000000,
+                                                       .DSP_CFG_RMS_DCUA = 0x00000000,
+                                                       .DSP_CFG_CALI_RMSIA = 0x00000000,
+                                                       .DSP_CFG_RMS_DCIA = 0x00000000,
+                                                       .DSP_CFG_CALI_RMSIB = 0x00000000,
+                                                       .DSP_CFG_RMS_DCIB = 0x00000000,
+                                                       .DSP_CFG_PHC = 0x00000000,
+                                                       .DSP_CFG_DCUA = 0x00000000,
+                                                       .DSP_CFG_DCIA = 0x00000000,
+                                                       .DSP_CFG_DCIB = 0x00000000,
+                                                       .DSP_CFG_BPF = 0x806764B6,
+                                                       .DSP_CFG_CKSUM = 0x00000000,
+                                                       .EGY_PROCTH = 0x00000000,
+                                                       .EGY_PWRTH = 0x00000000};
+
+static void WriteSerial(const uint8_t *data, size_t length, void *context) {
+    (void)context;
+    Serial.write(data, length);
+}
+
+static uint32_t Millis() { return millis(); }
 
 static void ConfigureUartAddressPins(int address) {
     pinMode(V93XX_ADDR0_PIN, OUTPUT);
@@ -30,8 +75,18 @@ void setup() {
 
     ConfigureUartAddressPins(V93XX_DEVICE_ADDRESS);
 
-    v9381.RxReset();
+    // Only reset and reload the chip if it lost the configuration (e.g. cold power-up);
+    // after an MCU-only reset the chip keeps metering and the reload is skipped.
     v9381.Init(SerialConfig::SERIAL_8O1, V93XX_UART::ChecksumMode::Dirty);
+    bool reloaded = false;
+    V93XX_Status warm = v9381.WarmStart(kControl, kCalibration, reloaded);
+    if (warm != V93XX_Status::Ok) {
+        Serial.printf("Configuration reload failed (status %d)\n", (int)warm);
+    } else if (reloaded) {
+        Serial.println("Cold start: chip reset and configuration loaded");
+    } else {
+        Serial.println("Warm start: configuration verified, reload skipped");
+    }
 
     uint32_t register_value = v9381.RegisterRead(SYS_INTSTS);
     Serial.printf("Interrupt Register: 0x%08X\n", register_value);
@@ -39,64 +94,28 @@ void setup() {
     register_value = v9381.RegisterRead(SYS_VERSION);
     Serial.printf("System Version: 0x%08X\n", register_value);
 
-    v9381.LoadConfiguration((const V93XX_UART::ControlRegisters &){.DSP_ANA0 = 0x00100C00,
-                                                                   .DSP_ANA1 = 0x000C32C1,
-                                                                   .DSP_CTRL0 = 0x01000f07,
-                                                                   .DSP_CTRL1 = 0x000C32C1,
-                                                                   .DSP_CTRL2 = 0x00002723,
-                                                                   .DSP_CTRL3 = 0x00000000,
-                                                                   .DSP_CTRL4 = 0x00000000,
-                                                                   .DSP_CTRL5 = 0x00000000},
-                            (const V93XX_UART::CalibrationRegisters &){.DSP_CFG_CALI_PA = 0x00000000,
-                                                                       .DSP_CFG_DC_PA = 0x00000000,
-                                                                       .DSP_CFG_CALI_QA = 0x00000000,
-                                                                       .DSP_CFG_DC_QA = 0x00000000,
-                                                                       .DSP_CFG_CALI_PB = 0x00000000,
-                                                                       .DSP_CFG_DC_PB = 0x00000000,
-                                                                       .DSP_CFG_CALI_QB = 0x00000000,
-                                                                       .DSP_CFG_DC_QB = 0x00000000,
-                                                                       .DSP_CFG_CALI_RMSUA = 0x00000000,
-                                                                       .DSP_CFG_RMS_DCUA = 0x00000000,
-                                                                       .DSP_CFG_CALI_RMSIA = 0x00000000,
-                                                                       .DSP_CFG_RMS_DCIA = 0x00000000,
-                                                                       .DSP_CFG_CALI_RMSIB = 0x00000000,
-                                                                       .DSP_CFG_RMS_DCIB = 0x00000000,
-                                                                       .DSP_CFG_PHC = 0x00000000,
-                                                                       .DSP_CFG_DCUA = 0x00000000,
-                                                                       .DSP_CFG_DCIA = 0x00000000,
-                                                                       .DSP_CFG_DCIB = 0x00000000,
-                                                                       .DSP_CFG_BPF = 0x806764B6,
-                                                                       .DSP_CFG_CKSUM = 0x00000000,
-                                                                       .EGY_PROCTH = 0x00000000,
-                                                                       .EGY_PWRTH = 0x00000000});
-
     v9381.RegisterWrite(SYS_IOCFG0, 0x00000000);
     v9381.RegisterWrite(SYS_IOCFG1, 0x003C3A00);
 
     v9381.RegisterWrite(SYS_INTSTS, SYS_INTSTS_CKERR);
+
+    // From here on waveforms go out as binary frames: run tools/telemetry_decode.py on the port.
+    telemetry.Begin(WriteSerial, nullptr, Millis);
+    if (kCompressWaveforms) {
+        telemetry.SetWaveformEncoder(&wave_encoder);
+    }
 }
 
 void loop() {
-    uint32_t waveform_buffer[309] = {0};
-
     const uint32_t ctrl5 = ((0 << DSP_CTRL5_DMAMODE_Pos) & DSP_CTRL5_DMAMODE_Msk) | DSP_CTRL5_DMA_CTRL_ENABLE |
                            DSP_CTRL5_WAVE_U | ((0 << DSP_CTRL5_WAVE_LEN_Pos) & DSP_CTRL5_WAVE_LEN_Msk) |
                            DSP_CTRL5_WAVEMEM_MODE_MANUAL_SINGLE;
 
-    bool capture_ok = v9381.CaptureWaveform(waveform_buffer, 309, ctrl5, 1000, 16);
+    // Each block read is framed and written as it arrives; the capture never needs a 309-word buffer.
+    telemetry.BeginCapture(ctrl5);
+    bool capture_ok = v9381.CaptureWaveform(V93XX_Telemetry::WaveformSink, &telemetry, 309, ctrl5, 1000, 16);
     if (!capture_ok) {
-        Serial.println("Waveform capture failed or overflowed");
-        delay(1000);
-        return;
+        telemetry.SendEvent(v9381.RegisterRead(SYS_INTSTS));
     }
-
-    Serial.printf("\nwave_data = [ \n");
-    for (int i = 0; i < 309; i++) {
-        int16_t upper = (int16_t)((waveform_buffer[i] >> 16) & 0xFFFF);
-        int16_t lower = (int16_t)(waveform_buffer[i] & 0xFFFF);
-        Serial.printf("%5d, %5d%s", lower, upper, (i != 308) ? (i % 8 == 7) ? ",\n" : ", " : "");
-    }
-    Serial.printf("]\n");
-
     delay(1000);
 }
@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+"""Create, inspect and diff V93XX binary configuration images (see V93XX_ConfigImage.h)."""
+
+from __future__ import annotations
+
+import argparse
+import json
+import re
+import struct
+import sys
+import zlib
+from pathlib import Path
+from typing import Dict, List, Tuple
+
+MAGIC = 0x43333956  # "V93C"
+FORMAT_VERSION = 1
+HEADER = struct.Struct("<IHHIHBB")
+RANGE = struct.Struct("<BBH")
+DSP_CFG_CKSUM = 0x38
+
+REGISTERS_H = Path(__file__).resolve().parent.parent / "V93XX_Registers.h"
+
+
+def load_register_names(path: Path = REGISTERS_H) -> Dict[str, int]:
+    """Map register names to addresses from the V93XX_REG enum."""
+    names: Dict[str, int] = {}
+    text = path.read_text(encoding="utf-8")
+    enum = re.search(r"enum V93XX_REG\s*{(.*?)};", text, re.S)
+    if enum is None:
+        return names
+    for name, value in re.findall(r"(\w+)\s*=\s*(0[xX][0-9a-fA-F]+)", enum.group(1)):
+        names[name] = int(value, 16)
+    return names
+
+
+def in_checksum_set(address: int) -> bool:
+    return address <= 0x07 or 0x25 <= address <= 0x3A or 0x55 <= address <= 0x60
+
+
+def config_checksum(registers: Dict[int, int]) -> int:
+    total = sum(v for a, v in registers.items() if a != DSP_CFG_CKSUM and in_checksum_set(a))
+    return (0xFFFFFFFF - total) & 0xFFFFFFFF
+
+
+def to_ranges(registers: Dict[int, int]) -> List[Tuple[int, List[int]]]:
+    ranges: List[Tuple[int, List[int]]] = []
+    for address in sorted(registers):
+        if ranges and ranges[-1][0] + len(ranges[-1][1]) == address and len(ranges[-1][1]) < 255:
+            ranges[-1][1].append(registers[address])
+        else:
+            ranges.append((address, [registers[address]]))
+    return ranges
+
+
+def build_image(registers: Dict[int, int], revision: int = 0) -> bytes:
+    registers = dict(registers)
+    checksum = config_checksum(registers)
+    if DSP_CFG_CKSUM in registers:
+        registers[DSP_CFG_CKSUM] = checksum
+    ranges = to_ranges(registers)
+    if len(ranges) > 255:
+        raise ValueError("too many register ranges")
+
+    body = bytearray(HEADER.pack(MAGIC, FORMAT_VERSION, revision, checksum, len(registers), len(ranges), 0))
+    for start, values in ranges:
+        body += RANGE.pack(start, len(values), 0)
+        body += struct.pack(f"<{len(values)}I", *values)
+    body += struct.pack("<I", zlib.crc32(bytes(body)) & 0xFFFFFFFF)
+    return bytes(body)
+
+
+def parse_image(data: bytes) -> Tuple[int, int, Dict[int, int]]:
+    """Return (revision, cfg_checksum, registers); raises ValueError on any inconsistency."""
+    if len(data) < HEADER.size + 4:
+        raise ValueError("image too short")
+    magic, version, revision, checksum, word_count, range_count, _ = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError(f"bad magic 0x{magic:08X}")
+    if version != FORMAT_VERSION:
+        raise ValueError(f"unsupported format version {version}")
+
+    registers: Dict[int, int] = {}
+    offset = HEADER.size
+    for _ in range(range_count):
+        if offset + RANGE.size > len(data) - 4:
+            raise ValueError("range header past end of image")
+        start, count, _ = RANGE.unpack_from(data, offset)
+        offset += RANGE.size
+        if count == 0 or start + count > 0x80 or offset + 4 * count > len(data) - 4:
+            raise ValueError(f"bad range at 0x{start:02X}")
+        for i, value in enumerate(struct.unpack_from(f"<{count}I", data, offset)):
+            registers[start + i] = value
+        offset += 4 * count
+    if offset + 4 != len(data) or len(registers) != word_count:
+        raise ValueError("layout does not match header")
+
+    (crc,) = struct.unpack_from("<I", data, offset)
+    if zlib.crc32(data[:offset]) & 0xFFFFFFFF != crc:
+        raise ValueError("CRC mismatch")
+    if config_checksum(registers) != checksum:
+        raise ValueError("DSP_CFG_CKSUM does not match register contents")
+    return revision, checksum, registers
+
+
+def parse_address(key: str, names: Dict[str, int]) -> int:
+    if key in names:
+        return names[key]
+    try:
+        address = int(key, 0)
+    except ValueError:
+        raise ValueError(f"unknown register {key!r}") from None
+    if not 0 <= address < 0x80:
+        raise ValueError(f"register address out of range: {key}")
+    return address
+
+
+def load_json(path: Path, names: Dict[str, int]) -> Tuple[int, Dict[int, int]]:
+    """JSON input: {"revision": 1, "registers": {"DSP_ANA0": "0x00100C00", "0x55": 0, ...}}."""
+    spec = json.loads(path.read_text(encoding="utf-8"))
+    registers: Dict[int, int] = {}
+    for key, value in spec.get("registers", {}).items():
+        word = int(value, 0) if isinstance(value, str) else int(value)
+        registers[parse_address(key, names)] = word & 0xFFFFFFFF
+    return int(spec.get("revision", 0)), registers
+
+
+def describe(address: int, by_address: Dict[int, str]) -> str:
+    name = by_address.get(address)
+    return f"0x{address:02X} {name}" if name else f"0x{address:02X}"
+
+
+def cmd_create(args, names: Dict[str, int]) -> int:
+    revision, registers = load_json(args.spec, names)
+    if args.revision is not None:
+        revision = args.revision
+    image = build_image(registers, revision)
+    args.output.write_bytes(image)
+    print(f"Wrote {args.output} ({len(image)} bytes, {len(registers)} registers, "
+          f"DSP_CFG_CKSUM=0x{config_checksum(registers):08X})")
+    return 0
+
+
+def cmd_show(args, names: Dict[str, int]) -> int:
+    revision, checksum, registers = parse_image(args.image.read_bytes())
+    by_address = {v: k for k, v in names.items()}
+    if args.json:
+        out = {
+            "revision": revision,
+            "registers": {by_address.get(a, f"0x{a:02X}"): f"0x{v:08X}" for a, v in sorted(registers.items())},
+        }
+        print(json.dumps(out, indent=2))
+        return 0
+    print(f"revision {revision}, {len(registers)} registers, DSP_CFG_CKSUM=0x{checksum:08X}")
+    for address, value in sorted(registers.items()):
+        print(f"  {describe(address, by_address):<28} 0x{value:08X}")
+    return 0
+
+
+def cmd_diff(args, names: Dict[str, int]) -> int:
+    rev_a, cks_a, regs_a = parse_image(args.a.read_bytes())
+    rev_b, cks_b, regs_b = parse_image(args.b.read_bytes())
+    by_address = {v: k for k, v in names.items()}
+    changes = 0
+    if rev_a != rev_b:
+        print(f"revision: {rev_a} -> {rev_b}")
+    for address in sorted(set(regs_a) | set(regs_b)):
+        if address == DSP_CFG_CKSUM:
+            continue
+        a = regs_a.get(address)
+        b = regs_b.get(address)
+        if a == b:
+            continue
+        changes += 1
+        left = "--" if a is None else f"0x{a:08X}"
+        right = "--" if b is None else f"0x{b:08X}"
+        print(f"  {describe(address, by_address):<28} {left} -> {right}")
+    if cks_a != cks_b:
+        print(f"DSP_CFG_CKSUM: 0x{cks_a:08X} -> 0x{cks_b:08X}")
+    print(f"{changes} register(s) differ")
+    return 1 if changes else 0
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Create, inspect and diff V93XX configuration images.")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    create = sub.add_parser("create", help="Build an image from a JSON register map.")
+    create.add_argument("spec", type=Path, help="JSON file with revision and registers.")
+    create.add_argument("-o", "--output", type=Path, required=True, help="Output .bin path.")
+    create.add_argument("--revision", type=int, help="Override the revision from the JSON file.")
+
+    show = sub.add_parser("show", help="Validate and print an image.")
+    show.add_argument("image", type=Path)
+    show.add_argument("--json", action="store_true", help="Print in the create input format.")
+
+    diff = sub.add_parser("diff", help="Compare two images register by register.")
+    diff.add_argument("a", type=Path)
+    diff.add_argument("b", type=Path)
+
+    args = parser.parse_args()
+    names = load_register_names()
+    handlers = {"create": cmd_create, "show": cmd_show, "diff": cmd_diff}
+    try:
+        return handlers[args.command](args, names)
+    except ValueError as exc:
+        print(f"error: {exc}", file=sys.stderr)
+        return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,79 @@
+#include "Arduino.h"
+#include "SPI.h"
+
+#include <stdarg.h>
+#include <string.h>
+
+namespace {
+
+uint64_t now_us = 0;
+void (*idle_hook)(void *) = nullptr;
+void *idle_context = nullptr;
+bool console = false;
+
+} // namespace
+
+namespace ArduinoHost {
+
+uint64_t NowUs() { return now_us; }
+
+void Advance(uint64_t us) {
+    now_us += us;
+    if (idle_hook) {
+        idle_hook(idle_context);
+    }
+}
+
+void SetIdleHook(void (*hook)(void *context), void *context) {
+    idle_hook = hook;
+    idle_context = context;
+}
+
+void SetConsole(bool enabled) { console = enabled; }
+bool ConsoleEnabled() { return console; }
+
+} // namespace ArduinoHost
+
+uint32_t millis() { return (uint32_t)(now_us / 1000); }
+uint32_t micros() { return (uint32_t)now_us; }
+void delay(uint32_t ms) { ArduinoHost::Advance(1000ULL * ms); }
+void delayMicroseconds(uint32_t us) { ArduinoHost::Advance(us); }
+void pinMode(int pin, int mode) {}
+void digitalWrite(int pin, int value) {}
+int digitalRead(int pin) { return HIGH; }
+void noInterrupts() {}
+void interrupts() {}
+void yield() {}
+
+size_t Print::write(const uint8_t *data, size_t length) {
+    if (console) {
+        fwrite(data, 1, length, stdout);
+    }
+    return length;
+}
+
+size_t Print::printf(const char *format, ...) {
+    char text[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (length < 0) {
+        return 0;
+    }
+    size_t used = ((size_t)length < sizeof(text)) ? (size_t)length : sizeof(text) - 1;
+    return write((const uint8_t *)text, used);
+}
+
+size_t Print::print(const char *text) { return write((const uint8_t *)text, strlen(text)); }
+
+size_t Print::print(int value) { return printf("%d", value); }
+
+size_t Print::println(const char *text) { return print(text) + print("\n"); }
+
+size_t Print::println(int value) { return printf("%d\n", value); }
+
+HardwareSerial Serial;
+HardwareSerial Serial1;
+HardwareSerial Serial2;
+SPIClass SPI;
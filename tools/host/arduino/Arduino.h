@@ -0,0 +1,82 @@
+// Minimal Arduino core for building the drivers on a Linux host (see tools/host/link_replay.cpp).
+//
+// Time is virtual: millis()/micros() read a clock that only delay() and delayMicroseconds() advance,
+// so timeouts cost nothing and runs are repeatable. After every delay the idle hook runs, which is
+// where a simulated peripheral delivers bytes that became due. HardwareSerial and SPIClass have
+// virtual methods so a host tool can put a recording or a chip model behind them. Serial writes to
+// stdout only when the console is enabled.
+
+#ifndef V93XX_HOST_ARDUINO_H__
+#define V93XX_HOST_ARDUINO_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <functional>
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+namespace ArduinoHost {
+uint64_t NowUs();
+void Advance(uint64_t us);
+void SetIdleHook(void (*hook)(void *context), void *context);
+void SetConsole(bool enabled);
+bool ConsoleEnabled();
+} // namespace ArduinoHost
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int digitalRead(int pin);
+void noInterrupts();
+void interrupts();
+void yield();
+
+enum SerialConfig {
+    SERIAL_8N1,
+    SERIAL_8E1,
+    SERIAL_8O1,
+};
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t byte) { return write(&byte, 1); }
+    virtual size_t write(const uint8_t *data, size_t length);
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+    size_t print(const char *text);
+    size_t print(int value);
+    size_t println(const char *text = "");
+    size_t println(int value);
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual void flush() {}
+};
+
+class HardwareSerial : public Stream {
+  public:
+    virtual void begin(unsigned long baud, SerialConfig config = SERIAL_8N1, int rx_pin = -1, int tx_pin = -1) {}
+    void onReceive(std::function<void()> callback) { this->rx_callback = callback; }
+
+  protected:
+    std::function<void()> rx_callback;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+
+#endif
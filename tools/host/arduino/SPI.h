@@ -0,0 +1,31 @@
+// SPI part of the host Arduino core (see Arduino.h in this directory).
+
+#ifndef V93XX_HOST_SPI_H__
+#define V93XX_HOST_SPI_H__
+
+#include "Arduino.h"
+
+#define MSBFIRST 1
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+
+struct SPISettings {
+    SPISettings() {}
+    SPISettings(uint32_t clock, uint8_t bit_order, uint8_t data_mode) {}
+};
+
+class SPIClass {
+  public:
+    virtual ~SPIClass() {}
+    virtual void begin() {}
+    virtual void begin(int8_t sck, int8_t miso, int8_t mosi, int8_t ss) { begin(); }
+    virtual void beginTransaction(SPISettings settings) {}
+    virtual void endTransaction() {}
+    virtual uint8_t transfer(uint8_t data) { return 0; }
+};
+
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,150 @@
+// Host benchmark for V93XX_MultiBus: polls 1..N simulated buses, each with its own worker thread,
+// and compares the aggregate poll rate with one thread polling the same buses in turn.
+//
+// A simulated bus holds the calling thread for the frame's time on the wire (19200 baud UART
+// timing by default), which is what the real drivers do while they wait for a response.
+//
+// Build from the repository root:
+//   g++ -O2 -std=c++17 -pthread -I. tools/host/bench_multibus.cpp -o bench_multibus
+//   ./bench_multibus [seconds_per_run] [max_buses] [byte_time_us]
+
+#include "V93XX_MultiBus.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint8_t kGroupWords = 16;
+
+// Stands in for V93XX_UART: the subset of the driver API V93XX_Acquisition uses.
+class SimulatedBus {
+  public:
+    explicit SimulatedBus(uint32_t byte_time_us) : byte_time_us(byte_time_us) {}
+
+    V93XX_Result<uint32_t> RegisterReadWithRetry(uint8_t address) {
+        Wire(4 + 6); // Request, then marker + 4 data bytes + checksum
+        V93XX_Result<uint32_t> result;
+        result.status = V93XX_Status::Ok;
+        result.value = address;
+        result.attempts = 1;
+        return result;
+    }
+
+    V93XX_Status ConfigureBlockRead(const uint8_t addresses[], uint8_t num_addresses) {
+        (void)addresses;
+        (void)num_addresses; // Mapping unchanged between polls: the driver's shadow skips the writes
+        return V93XX_Status::Ok;
+    }
+
+    V93XX_Status RegisterBlockReadWithRetry(uint32_t (&values)[], uint8_t num_values) {
+        Wire(4 + 5 * (size_t)num_values + 1);
+        for (uint8_t i = 0; i < num_values; i++) {
+            values[i] = ++this->counter;
+        }
+        return V93XX_Status::Ok;
+    }
+
+  private:
+    uint32_t byte_time_us;
+    uint32_t counter = 0;
+
+    void Wire(size_t bytes) const {
+        std::this_thread::sleep_for(std::chrono::microseconds(bytes * this->byte_time_us));
+    }
+};
+
+struct Run {
+    double polls_per_second = 0.0;
+    double mean_skew_ms = 0.0;
+};
+
+struct Buses {
+    std::vector<std::unique_ptr<SimulatedBus>> devices;
+    std::vector<std::unique_ptr<V93XX_Acquisition<SimulatedBus>>> services;
+
+    Buses(int count, uint32_t byte_time_us) {
+        for (int i = 0; i < count; i++) {
+            devices.emplace_back(new SimulatedBus(byte_time_us));
+            services.emplace_back(new V93XX_Acquisition<SimulatedBus>(*devices.back()));
+            services.back()->AddGroup(DSP_DAT_PA, kGroupWords, 0); // Poll back to back
+        }
+    }
+};
+
+Run Parallel(int bus_count, double seconds, uint32_t byte_time_us) {
+    Buses buses(bus_count, byte_time_us);
+    V93XX_MultiBus multibus;
+    for (auto &service : buses.services) {
+        multibus.Add(*service);
+    }
+
+    static V93XX_MultiBus::Frame frame;
+    uint64_t frames = 0;
+    double skew_total = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    multibus.Start(0);
+    while (std::chrono::steady_clock::now() - start < std::chrono::duration<double>(seconds)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        if (multibus.Collect(frame)) {
+            frames++;
+            skew_total += frame.skew_ms;
+        }
+    }
+    multibus.Stop();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Run run;
+    run.polls_per_second = multibus.Publishes() / elapsed;
+    run.mean_skew_ms = frames ? skew_total / frames : 0.0;
+    return run;
+}
+
+Run Sequential(int bus_count, double seconds, uint32_t byte_time_us) {
+    Buses buses(bus_count, byte_time_us);
+    uint64_t polls = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < std::chrono::duration<double>(seconds)) {
+        for (auto &service : buses.services) {
+            service->Poll();
+        }
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (auto &service : buses.services) {
+        polls += service->Publishes();
+    }
+
+    Run run;
+    run.polls_per_second = polls / elapsed;
+    return run;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    double seconds = (argc > 1) ? atof(argv[1]) : 2.0;
+    int max_buses = (argc > 2) ? atoi(argv[2]) : 5;
+    uint32_t byte_time_us = (argc > 3) ? (uint32_t)atoi(argv[3]) : 573;
+    if (max_buses < 1 || max_buses > V93XX_MultiBus::kMaxBuses) {
+        max_buses = 5;
+    }
+
+    printf("%u-word block polls, %u us per byte, %.1f s per run\n", kGroupWords, byte_time_us, seconds);
+    printf("buses  sequential polls/s  parallel polls/s  speedup  words/s  mean skew\n");
+    double single = 0.0;
+    for (int buses = 1; buses <= max_buses; buses++) {
+        Run sequential = Sequential(buses, seconds, byte_time_us);
+        Run parallel = Parallel(buses, seconds, byte_time_us);
+        if (buses == 1) {
+            single = parallel.polls_per_second;
+        }
+        printf("%5d  %18.1f  %16.1f  %6.2fx  %7.0f  %6.1f ms\n", buses, sequential.polls_per_second,
+               parallel.polls_per_second, single > 0.0 ? parallel.polls_per_second / single : 0.0,
+               parallel.polls_per_second * kGroupWords, parallel.mean_skew_ms);
+    }
+    return 0;
+}
@@ -0,0 +1,178 @@
+// Host benchmark for V93XX_WaveCodec: compresses waveform captures block by block, checks that every
+// block decodes back bit-exactly, and reports the compression ratio and encode/decode throughput.
+//
+// Inputs are sample files as saved by tools/telemetry_decode.py --save (one sample per line, commas
+// also accepted). Without files it generates synthetic captures: a 50 Hz fundamental with 3rd and
+// 5th harmonics and a few LSB of noise, 618 samples each, like a full V9381 waveform buffer.
+//
+// Build from the repository root:
+//   g++ -O2 -std=c++17 -I. tools/host/bench_wavecodec.cpp V93XX_WaveCodec.cpp -o bench_wavecodec
+//   ./bench_wavecodec [--block samples] [captures/capture_1.csv ...]
+
+#include "V93XX_WaveCodec.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+typedef std::vector<int16_t> Capture;
+
+constexpr size_t kSyntheticCaptures = 64;
+constexpr size_t kCaptureSamples = 618;
+constexpr double kSamplesPerCycle = 64.0;
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kMinSeconds = 0.5; // Repeat each timing loop at least this long
+
+std::vector<Capture> Synthesize() {
+    std::vector<Capture> captures;
+    uint32_t seed = 1;
+    for (size_t c = 0; c < kSyntheticCaptures; c++) {
+        Capture capture;
+        double phase = 2.0 * kPi * c / kSyntheticCaptures;
+        for (size_t n = 0; n < kCaptureSamples; n++) {
+            double t = 2.0 * kPi * n / kSamplesPerCycle + phase;
+            seed = seed * 1103515245u + 12345u;
+            int noise = (int)((seed >> 16) % 9) - 4;
+            double value = 20000.0 * sin(t) + 1500.0 * sin(3 * t + 0.3) + 600.0 * sin(5 * t + 1.1);
+            capture.push_back((int16_t)(lround(value) + noise));
+        }
+        captures.push_back(capture);
+    }
+    return captures;
+}
+
+bool ReadSamples(const char *path, Capture &capture) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        return false;
+    }
+    long value;
+    while (true) {
+        int matched = fscanf(file, " %ld ,", &value);
+        if (matched != 1) {
+            break;
+        }
+        capture.push_back((int16_t)value);
+    }
+    fclose(file);
+    return !capture.empty();
+}
+
+size_t EncodeCapture(const Capture &capture, uint8_t block_samples, std::vector<uint8_t> &out,
+                     uint32_t order_use[V93XX_WaveCodec::kMaxOrder + 2]) {
+    V93XX_WaveEncoder encoder;
+    encoder.Reset();
+    out.clear();
+    uint8_t block[V93XX_WaveCodec::kMaxBlockBytes];
+    for (size_t i = 0; i < capture.size(); i += block_samples) {
+        uint8_t count = (uint8_t)((capture.size() - i < block_samples) ? capture.size() - i : block_samples);
+        size_t length = encoder.EncodeSamples(&capture[i], count, block);
+        if (order_use) {
+            uint8_t k = block[1] & 0x1F;
+            order_use[(k == V93XX_WaveCodec::kVerbatim) ? V93XX_WaveCodec::kMaxOrder + 1 : block[1] >> 6]++;
+        }
+        out.insert(out.end(), block, block + length);
+    }
+    return out.size();
+}
+
+bool DecodeCapture(const std::vector<uint8_t> &coded, Capture &out) {
+    V93XX_WaveDecoder decoder;
+    decoder.Reset();
+    out.clear();
+    int16_t samples[V93XX_WaveCodec::kMaxBlockSamples];
+    size_t offset = 0;
+    while (offset < coded.size()) {
+        uint8_t count = 0;
+        size_t used = decoder.DecodeSamples(&coded[offset], coded.size() - offset, samples, count);
+        if (used == 0) {
+            return false;
+        }
+        out.insert(out.end(), samples, samples + count);
+        offset += used;
+    }
+    return true;
+}
+
+double Seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    uint8_t block_samples = 32; // One 16-word CaptureWaveform() chunk
+    std::vector<Capture> captures;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--block") == 0 && i + 1 < argc) {
+            block_samples = (uint8_t)atoi(argv[++i]);
+            continue;
+        }
+        Capture capture;
+        if (!ReadSamples(argv[i], capture)) {
+            fprintf(stderr, "cannot read samples from %s\n", argv[i]);
+            return 1;
+        }
+        captures.push_back(capture);
+    }
+    if (block_samples == 0 || block_samples > V93XX_WaveCodec::kMaxBlockSamples) {
+        fprintf(stderr, "--block must be 1-%u\n", V93XX_WaveCodec::kMaxBlockSamples);
+        return 1;
+    }
+    const bool synthetic = captures.empty();
+    if (synthetic) {
+        captures = Synthesize();
+    }
+
+    // Size and round trip.
+    size_t raw_bytes = 0;
+    size_t coded_bytes = 0;
+    size_t mismatches = 0;
+    uint32_t order_use[V93XX_WaveCodec::kMaxOrder + 2] = {0};
+    std::vector<std::vector<uint8_t>> coded(captures.size());
+    Capture decoded;
+    for (size_t c = 0; c < captures.size(); c++) {
+        raw_bytes += 2 * captures[c].size();
+        coded_bytes += EncodeCapture(captures[c], block_samples, coded[c], order_use);
+        if (!DecodeCapture(coded[c], decoded) || decoded != captures[c]) {
+            mismatches++;
+        }
+    }
+
+    // Throughput, in raw sample bytes per second.
+    std::vector<uint8_t> scratch;
+    size_t encode_bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (Seconds(start) < kMinSeconds) {
+        for (const Capture &capture : captures) {
+            EncodeCapture(capture, block_samples, scratch, nullptr);
+            encode_bytes += 2 * capture.size();
+        }
+    }
+    double encode_mbps = encode_bytes / Seconds(start) / 1e6;
+
+    size_t decode_bytes = 0;
+    start = std::chrono::steady_clock::now();
+    while (Seconds(start) < kMinSeconds) {
+        for (size_t c = 0; c < captures.size(); c++) {
+            DecodeCapture(coded[c], decoded);
+            decode_bytes += 2 * decoded.size();
+        }
+    }
+    double decode_mbps = decode_bytes / Seconds(start) / 1e6;
+
+    printf("%zu %s capture(s), %u-sample blocks\n", captures.size(), synthetic ? "synthetic" : "recorded",
+           block_samples);
+    printf("raw %zu bytes, coded %zu bytes, ratio %.2f:1, %.2f bits/sample\n", raw_bytes, coded_bytes,
+           coded_bytes ? (double)raw_bytes / coded_bytes : 0.0, raw_bytes ? 16.0 * coded_bytes / raw_bytes : 0.0);
+    printf("blocks by predictor order: 0=%u 1=%u 2=%u 3=%u verbatim=%u\n", order_use[0], order_use[1],
+           order_use[2], order_use[3], order_use[4]);
+    printf("encode %.1f MB/s, decode %.1f MB/s\n", encode_mbps, decode_mbps);
+    printf("round trip mismatches: %zu\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,454 @@
+// Calibration check: V93XX_Calibration<V93XX_SPI> (host Arduino core, virtual clock) calibrates a
+// simulated V9381 with known ratio, phase, small-signal and channel DC errors. The chip applies the
+// DSP_CFG_* registers the way V93XX_CalibrationMath models them: ratio registers as Q31 fractions,
+// small-signal registers as counts added to the output, DSP_CFG_PHC as a fixed angle step (deliberately
+// not the step the calibration starts from). It publishes a fresh, slightly noisy set of averages
+// with AVGRMSUPD | AVGPWRUPD every update period and computes SYS_STS.CKERR from the whole checksum
+// set, thresholds included, which the calibration never reads.
+//
+// Each scenario checks that the step converged, that the noise-free chip output is within
+// tolerance of the reference, that CKERR stays clear and that Registers() matches the chip.
+// V93XX_CalibrationMath edge cases (Q31 gain, saturation, checksum delta across the 2^32 wrap)
+// are checked first. Exits with status 1 on any failure.
+//
+// Build from the repository root (one command):
+//   g++ -O2 -std=gnu++17 -pthread -I. -Itools/host/arduino -o calibration_sim tools/host/calibration_sim.cpp
+//       tools/host/arduino/Arduino.cpp V93XX_SPI.cpp V93XX_Stats.cpp V93XX_LinkTrace.cpp
+//   ./calibration_sim [--verbose]
+
+#include "V93XX_Calibration.h"
+#include "V93XX_RegisterMap.h"
+#include "V93XX_SPI.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+typedef V93XX_Calibration<V93XX_SPI> Calibration;
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kQ31 = V93XX_CalibrationMath::kQ31;
+constexpr uint32_t kSpiByteTimeUs = 20; // 400 kHz SCLK
+constexpr uint8_t kInterfaceControl = 0x7F;
+constexpr uint32_t kOffsetOn = 0x4A985B67UL;
+constexpr uint32_t kOffsetOff = 0x76B589A4UL;
+constexpr uint64_t kUpdatePeriodUs = 50000;
+
+// Counts per unit, used by both the chip model and Calibration::Config.
+constexpr double kVoltageCounts = 1e4;
+constexpr double kCurrentCounts = 1e5;
+constexpr double kPowerCounts = 100.0;
+
+/**
+ * Errors of the uncalibrated chip, relative (gains) or in output counts (offsets).
+ */
+struct ChipErrors {
+    double gain_u;
+    double gain_ia;
+    double gain_ib;
+    double gain_power_a;
+    double gain_power_b;
+    double phase_deg;       // Extra current lag seen by channel A powers
+    double phc_deg_per_lsb; // Angle change per DSP_CFG_PHC LSB
+    double offset_u;
+    double offset_ia;
+    double offset_ib;
+    double offset_p;
+    double offset_q;
+    int32_t channel_dc[3]; // U, IA, IB ADC DC levels (DSP_DAT_DCU/DCI/DCIB before correction)
+    double noise;          // Relative noise of each published average
+};
+
+uint32_t Le32(const uint8_t *data) {
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/**
+ * One V9381 as seen over SPI with a reference source connected. Measurement registers are latched
+ * once per update period from the reference, the chip errors and the present DSP_CFG_* values.
+ */
+class SimCalibrationChip : public SPIClass {
+  public:
+    explicit SimCalibrationChip(const ChipErrors &errors) : errors(errors) {
+        memset(this->registers, 0, sizeof(this->registers));
+        // Arbitrary factory state: control words and thresholds the calibration knows nothing about,
+        // ratio registers within +/-0.8 %, no small-signal correction, DSP_CFG_CKSUM making the set
+        // consistent.
+        uint32_t seed = 0x2545F491UL;
+        for (uint8_t address = 0; address < 0x80; address++) {
+            if (V93XX_RegisterMap::InChecksumSet(address) && address != DSP_CFG_CKSUM) {
+                seed = seed * 1664525UL + 1013904223UL;
+                this->registers[address] = (address >= DSP_CFG_CALI_PA && address <= DSP_CFG_RMS_DCIB) ? 0 : seed;
+            }
+        }
+        const uint8_t ratios[7] = {DSP_CFG_CALI_PA,    DSP_CFG_CALI_QA,    DSP_CFG_CALI_PB,   DSP_CFG_CALI_QB,
+                                   DSP_CFG_CALI_RMSUA, DSP_CFG_CALI_RMSIA, DSP_CFG_CALI_RMSIB};
+        for (uint8_t address : ratios) {
+            seed = seed * 1664525UL + 1013904223UL;
+            this->registers[address] = (uint32_t)((int32_t)(seed >> 7) - (1L << 24));
+        }
+        this->registers[DSP_CFG_PHC] = 12;
+        this->registers[DSP_CFG_CKSUM] = 0xFFFFFFFFUL - SetSum();
+    }
+
+    void SetReference(double voltage_rms, double current_rms, double phase_deg) {
+        this->voltage_rms = voltage_rms;
+        this->current_rms = current_rms;
+        this->phase_deg = phase_deg;
+    }
+
+    void beginTransaction(SPISettings settings) override { this->position = 0; }
+
+    uint8_t transfer(uint8_t tx) override {
+        ArduinoHost::Advance(kSpiByteTimeUs);
+        uint8_t rx = 0;
+        if (this->position == 0) {
+            this->frame[0] = tx;
+            this->checksum = V93XX_Frames::RunningChecksum(tx);
+            if (tx & 1) {
+                this->value = Read((uint8_t)((tx >> 1) | (this->offset ? 0x80 : 0x00)));
+            }
+        } else if (this->frame[0] & 1) {
+            if (this->position <= 4) {
+                rx = (uint8_t)(this->value >> (8 * (this->position - 1)));
+                this->checksum.Add(rx);
+            } else if (this->position == 5) {
+                rx = this->checksum.Expected();
+            }
+        } else if (this->position < 6) {
+            this->frame[this->position] = tx;
+            if (this->position == 5) {
+                Write();
+            }
+        }
+        this->position++;
+        return rx;
+    }
+
+    uint32_t Register(uint8_t address) const { return this->registers[address]; }
+
+    uint32_t SetSum() const {
+        uint32_t sum = 0;
+        for (uint8_t address = 0; address < 0x80; address++) {
+            if (V93XX_RegisterMap::InChecksumSet(address)) {
+                sum += this->registers[address];
+            }
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Noise-free U, I, P, Q of @p channel_b for the present registers, in counts.
+     */
+    void Output(bool channel_b, double (&output)[4]) const {
+        const uint32_t *r = this->registers;
+        double cali_i = Ratio(r[channel_b ? DSP_CFG_CALI_RMSIB : DSP_CFG_CALI_RMSIA]);
+        double cali_p = Ratio(r[channel_b ? DSP_CFG_CALI_PB : DSP_CFG_CALI_PA]);
+        double cali_q = Ratio(r[channel_b ? DSP_CFG_CALI_QB : DSP_CFG_CALI_QA]);
+        double gain_i = channel_b ? this->errors.gain_ib : this->errors.gain_ia;
+        double offset_i = channel_b ? this->errors.offset_ib : this->errors.offset_ia;
+        double angle = this->phase_deg;
+        if (!channel_b) {
+            angle += this->errors.phase_deg + (int32_t)r[DSP_CFG_PHC] * this->errors.phc_deg_per_lsb;
+        }
+        double apparent = this->voltage_rms * this->current_rms * kPowerCounts *
+                          (channel_b ? this->errors.gain_power_b : this->errors.gain_power_a);
+
+        output[0] = this->voltage_rms * kVoltageCounts * this->errors.gain_u * Ratio(r[DSP_CFG_CALI_RMSUA]) +
+                    (int32_t)r[DSP_CFG_RMS_DCUA] + this->errors.offset_u;
+        output[1] = this->current_rms * kCurrentCounts * gain_i * cali_i +
+                    (int32_t)r[channel_b ? DSP_CFG_RMS_DCIB : DSP_CFG_RMS_DCIA] + offset_i;
+        output[2] = apparent * cos(angle * kPi / 180.0) * cali_p +
+                    (int32_t)r[channel_b ? DSP_CFG_DC_PB : DSP_CFG_DC_PA] + this->errors.offset_p;
+        output[3] = apparent * sin(angle * kPi / 180.0) * cali_q +
+                    (int32_t)r[channel_b ? DSP_CFG_DC_QB : DSP_CFG_DC_QA] + this->errors.offset_q;
+    }
+
+    uint32_t Updates() const { return this->updates; }
+
+  private:
+    ChipErrors errors;
+    uint32_t registers[256];
+    uint8_t frame[6] = {0};
+    uint8_t position = 0;
+    bool offset = false;
+    uint32_t value = 0;
+    V93XX_Frames::RunningChecksum checksum;
+
+    double voltage_rms = 0.0;
+    double current_rms = 0.0;
+    double phase_deg = 0.0;
+    uint64_t next_update_us = kUpdatePeriodUs;
+    uint32_t updates = 0;
+    uint32_t noise_state = 1;
+
+    static double Ratio(uint32_t value) { return 1.0 + (int32_t)value / kQ31; }
+
+    // Uniform in [-1, 1].
+    double Noise() {
+        this->noise_state = this->noise_state * 1664525UL + 1013904223UL;
+        return (double)(this->noise_state >> 8) / (double)(1UL << 23) - 1.0;
+    }
+
+    // Publish every update period that has passed since the last one.
+    void Update() {
+        while (ArduinoHost::NowUs() >= this->next_update_us) {
+            this->next_update_us += kUpdatePeriodUs;
+            this->updates++;
+            double a[4];
+            double b[4];
+            Output(false, a);
+            Output(true, b);
+            const uint8_t a_registers[4] = {DSP_DAT_RMS1UA, DSP_DAT_RMS1IA, DSP_DAT_PA1, DSP_DAT_QA1};
+            const uint8_t b_registers[4] = {DSP_DAT_RMS1UA, DSP_DAT_RMS1IB, DSP_DAT_PB1, DSP_DAT_QB1};
+            double apparent_a = std::hypot(a[2], a[3]);
+            double apparent_b = std::hypot(b[2], b[3]);
+            for (int q = 0; q < 4; q++) {
+                double scale_a = (q >= 2) ? apparent_a : a[q];
+                double scale_b = (q >= 2) ? apparent_b : b[q];
+                double noise = Noise() * this->errors.noise;
+                this->registers[a_registers[q]] = (uint32_t)(int32_t)lround(a[q] + noise * scale_a);
+                if (q > 0) {
+                    this->registers[b_registers[q]] = (uint32_t)(int32_t)lround(b[q] + noise * scale_b);
+                }
+            }
+            for (int i = 0; i < 3; i++) {
+                this->registers[DSP_DAT_DCU + i] =
+                    (uint32_t)(this->errors.channel_dc[i] + (int32_t)this->registers[DSP_CFG_DCUA + i]);
+            }
+            this->registers[SYS_INTSTS] |= SYS_INTSTS_AVGRMSUPD | SYS_INTSTS_AVGPWRUPD;
+        }
+    }
+
+    uint32_t Read(uint8_t address) {
+        Update();
+        if (address == SYS_STS) {
+            return (SetSum() == 0xFFFFFFFFUL) ? 0 : SYS_STS_CKERR;
+        }
+        return this->registers[address];
+    }
+
+    void Write() {
+        uint8_t address7 = this->frame[0] >> 1;
+        uint32_t data = Le32(&this->frame[1]);
+        if (address7 == kInterfaceControl) {
+            if (data == kOffsetOn || data == kOffsetOff) {
+                this->offset = data == kOffsetOn;
+            }
+            return;
+        }
+        uint8_t address = (uint8_t)(address7 | (this->offset ? 0x80 : 0x00));
+        Update();
+        if (address == SYS_INTSTS) {
+            this->registers[SYS_INTSTS] &= ~data;
+            return;
+        }
+        this->registers[address] = data;
+    }
+};
+
+struct Scenario {
+    const char *name;
+    Calibration::Channel channel;
+    bool offset_step; // CalibrateOffset() at this reference (after a gain step at kGainReference)
+    Calibration::Reference reference;
+};
+
+const Calibration::Reference kGainReference = {230.0f, 5.0f, 60.0f};
+
+bool Check(const char *label, double measured, double expected, double tolerance, bool verbose) {
+    bool ok = std::fabs(measured - expected) <= tolerance;
+    if (verbose || !ok) {
+        printf("    %-36s %14.6f  expected %14.6f  %s\n", label, measured, expected, ok ? "ok" : "FAIL");
+    }
+    return ok;
+}
+
+bool CheckMath(bool verbose) {
+    using namespace V93XX_CalibrationMath;
+    printf("V93XX_CalibrationMath\n");
+    bool ok = true;
+    ok &= Check("Gain(0, 0.98, 1)", (int32_t)Gain(0, 0.98, 1.0), (1.0 / 0.98 - 1.0) * kQ31, 1.0, verbose);
+    // Starting from +1 %, a reading 2 % high needs 1.01 / 1.02 overall.
+    uint32_t one_percent = (uint32_t)Saturate(0.01 * kQ31);
+    ok &= Check("Gain(+1 %, 1.02, 1)", (int32_t)Gain(one_percent, 1.02, 1.0), (1.01 / 1.02 - 1.0) * kQ31, 1.0, verbose);
+    ok &= Check("Gain(x, 0, 1) keeps x", Gain(12345, 0.0, 1.0), 12345.0, 0.0, verbose);
+    ok &= Check("Gain saturates", (int32_t)Gain(0, 0.4, 1.0), INT32_MAX, 0.0, verbose);
+    ok &= Check("Saturate(-1e12)", Saturate(-1e12), INT32_MIN, 0.0, verbose);
+    ok &= Check("Saturate(-2.5)", Saturate(-2.5), -3.0, 0.0, verbose);
+    ok &= Check("Offset(5, 100, 90)", (int32_t)Offset(5, 100.0, 90.0), -5.0, 0.0, verbose);
+    ok &= Check("Offset(-7, -20, 0)", (int32_t)Offset((uint32_t)-7, -20.0, 0.0), 13.0, 0.0, verbose);
+    const uint32_t old_values[2] = {0xFFFFFFFFUL, 0x00000010UL};
+    const uint32_t new_values[2] = {0x00000001UL, 0x00000008UL};
+    // (+2) + (-8) = -6 overall, so the checksum moves by +6 across the wrap.
+    ok &= Check("UpdateChecksum across 2^32", UpdateChecksum(0xFFFFFFFCUL, old_values, new_values, 2), 2.0, 0.0,
+                verbose);
+    uint32_t set[3] = {0x80000000UL, 0x7FFFFFFEUL, 0};
+    set[2] = 0xFFFFFFFFUL - set[0] - set[1];
+    uint32_t changed[2] = {0x12345678UL, 0xFEDCBA98UL};
+    uint32_t checksum = UpdateChecksum(set[2], set, changed, 2);
+    ok &= Check("UpdateChecksum keeps the set sum", (uint32_t)(changed[0] + changed[1] + checksum), 0xFFFFFFFFUL, 0.0,
+                verbose);
+    printf("  %s\n", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+Calibration::Config MakeConfig(Calibration::Channel channel) {
+    Calibration::Config config = Calibration::DefaultConfig();
+    config.channel = channel;
+    config.voltage_counts_per_volt = (float)kVoltageCounts;
+    config.current_counts_per_amp = (float)kCurrentCounts;
+    config.power_counts_per_watt = (float)kPowerCounts;
+    config.period_timeout_ms = 4 * kUpdatePeriodUs / 1000;
+    config.max_iterations = 6;
+    return config;
+}
+
+bool CheckResult(const char *step, const Calibration::Result &result) {
+    static const char *const kNames[Calibration::kQuantities] = {"U", "I", "P", "Q"};
+    printf("  %-22s status %d  %s  %u writes  %3u periods  error", step, (int)result.status,
+           result.converged ? "converged" : "NOT CONVERGED", result.iterations, result.periods);
+    for (uint8_t q = 0; q < Calibration::kQuantities; q++) {
+        printf("  %s %+.2e -> %+.2e", kNames[q], result.error_before[q], result.error_after[q]);
+    }
+    printf("\n");
+    return result.status == V93XX_Status::Ok && result.converged;
+}
+
+/**
+ * @brief Chip output after calibration against the reference targets, relative like Result::error_after.
+ */
+bool CheckOutput(const SimCalibrationChip &chip, const Calibration::Config &config,
+                 const Calibration::Reference &reference, bool check_q, bool verbose) {
+    double output[4];
+    chip.Output(config.channel == Calibration::Channel::B, output);
+    double apparent = reference.voltage_rms * reference.current_rms * kPowerCounts;
+    double target[4] = {
+        reference.voltage_rms * kVoltageCounts,
+        reference.current_rms * kCurrentCounts,
+        apparent * cos(reference.phase_deg * kPi / 180.0),
+        apparent * sin(reference.phase_deg * kPi / 180.0),
+    };
+    // Noise leaves up to a few standard errors in the averages the corrections came from.
+    const double tolerance = 2.0 * config.tolerance;
+    bool ok = true;
+    ok &= Check("chip U error", (output[0] - target[0]) / target[0], 0.0, tolerance, verbose);
+    ok &= Check("chip I error", (output[1] - target[1]) / target[1], 0.0, tolerance, verbose);
+    ok &= Check("chip P error", (output[2] - target[2]) / apparent, 0.0, tolerance, verbose);
+    if (check_q) {
+        ok &= Check("chip Q error", (output[3] - target[3]) / apparent, 0.0, tolerance, verbose);
+    }
+    return ok;
+}
+
+/**
+ * @brief The whole set still sums to 0xFFFFFFFF and Registers() matches the chip's calibration block.
+ */
+bool CheckChecksum(const SimCalibrationChip &chip, const Calibration &calibration, bool verbose) {
+    bool ok = Check("checksum set sum", chip.SetSum(), 0xFFFFFFFFUL, 0.0, verbose);
+    for (uint8_t i = 0; i < V93XX_SPI::kCalibrationWords; i++) {
+        uint8_t address = (uint8_t)(V93XX_SPI::kCalibrationBase + i);
+        if (calibration.Registers()._array[i] != chip.Register(address)) {
+            printf("    Registers() 0x%02X = %08lX, chip %08lX\n", address,
+                   (unsigned long)calibration.Registers()._array[i], (unsigned long)chip.Register(address));
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+bool Run(const Scenario &scenario, const ChipErrors &errors, bool verbose) {
+    printf("%s\n", scenario.name);
+    SimCalibrationChip chip(errors);
+    V93XX_SPI driver(5, chip);
+    driver.Init(V93XX_SPI::WireMode::FourWire, true, V93XX_SPI::ChecksumMode::Clean);
+
+    Calibration calibration(driver);
+    Calibration::Config config = MakeConfig(scenario.channel);
+    if (calibration.Begin(config) != V93XX_Status::Ok) {
+        printf("  Begin() failed\n");
+        return false;
+    }
+
+    bool ok = true;
+    const bool channel_b = scenario.channel == Calibration::Channel::B;
+    if (scenario.offset_step) {
+        // The offset step follows a gain step, as documented.
+        chip.SetReference(kGainReference.voltage_rms, kGainReference.current_rms, kGainReference.phase_deg);
+        ok &= CheckResult("CalibrateGain()", calibration.CalibrateGain(kGainReference));
+        chip.SetReference(scenario.reference.voltage_rms, scenario.reference.current_rms,
+                          scenario.reference.phase_deg);
+        ok &= CheckResult("CalibrateOffset()", calibration.CalibrateOffset(scenario.reference));
+        ok &= CheckOutput(chip, config, scenario.reference, true, verbose);
+    } else {
+        chip.SetReference(scenario.reference.voltage_rms, scenario.reference.current_rms,
+                          scenario.reference.phase_deg);
+        ok &= CheckResult("CalibrateGain()", calibration.CalibrateGain(scenario.reference));
+        bool phase_step = !channel_b && std::fabs(sin(scenario.reference.phase_deg * kPi / 180.0)) >= 0.5;
+        ok &= CheckOutput(chip, config, scenario.reference, phase_step, verbose);
+        if (phase_step) {
+            printf("  PHC %ld, step estimate %.5f deg/LSB (chip %.5f)\n", (long)(int32_t)chip.Register(DSP_CFG_PHC),
+                   calibration.PhaseStepEstimate(), errors.phc_deg_per_lsb);
+        }
+    }
+
+    V93XX_Status dc = calibration.CalibrateChannelDc();
+    delay(2 * kUpdatePeriodUs / 1000); // Let the corrected DC levels be published
+    for (int i = 0; i < 3; i++) {
+        const char *const kLabels[3] = {"DSP_DAT_DCU after DC step", "DSP_DAT_DCI after DC step",
+                                        "DSP_DAT_DCIB after DC step"};
+        V93XX_Result<uint32_t> level = driver.RegisterReadWithRetry((uint8_t)(DSP_DAT_DCU + i));
+        ok &= level.Ok() && Check(kLabels[i], (int32_t)level.value, 0.0, 0.0, verbose);
+    }
+    ok &= dc == V93XX_Status::Ok;
+
+    bool checksum_ok = false;
+    ok &= calibration.ChecksumOk(checksum_ok) == V93XX_Status::Ok && checksum_ok;
+    ok &= CheckChecksum(chip, calibration, verbose);
+    printf("  %s (%u update periods)\n", ok ? "ok" : "FAILED", chip.Updates());
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bool verbose = argc > 1 && strcmp(argv[1], "--verbose") == 0;
+
+    ChipErrors errors = {};
+    errors.gain_u = 1.031;
+    errors.gain_ia = 0.962;
+    errors.gain_ib = 1.047;
+    errors.gain_power_a = 0.955;
+    errors.gain_power_b = 1.052;
+    errors.phase_deg = 0.45;
+    errors.phc_deg_per_lsb = 0.0137; // Calibration starts from 0.01
+    errors.offset_u = 40.0;
+    errors.offset_ia = 120.0;
+    errors.offset_ib = -90.0;
+    errors.offset_p = 35.0;
+    errors.offset_q = -28.0;
+    errors.channel_dc[0] = 812;
+    errors.channel_dc[1] = -1530;
+    errors.channel_dc[2] = 77;
+    errors.noise = 2e-4;
+
+    const Scenario scenarios[] = {
+        {"channel A gain, PF 1", Calibration::Channel::A, false, {230.0f, 5.0f, 0.0f}},
+        {"channel A gain and phase, 60 deg", Calibration::Channel::A, false, kGainReference},
+        {"channel A gain and phase, -60 deg", Calibration::Channel::A, false, {230.0f, 5.0f, -60.0f}},
+        {"channel B gain, PF 1", Calibration::Channel::B, false, {230.0f, 10.0f, 0.0f}},
+        {"channel A offset at 0.25 A", Calibration::Channel::A, true, {230.0f, 0.25f, 60.0f}},
+    };
+
+    int failures = CheckMath(verbose) ? 0 : 1;
+    for (const Scenario &scenario : scenarios) {
+        if (!Run(scenario, errors, verbose)) {
+            failures++;
+        }
+    }
+    printf("%d of %zu checks passed\n", (int)(sizeof(scenarios) / sizeof(scenarios[0]) + 1) - failures,
+           sizeof(scenarios) / sizeof(scenarios[0]) + 1);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,169 @@
+// Host replay for V93XX_DmaParser: feeds a recorded SPI upload stream (raw bytes, e.g. exported
+// from a logic analyzer) through the parser and ring exactly as the ESP32 receive task does.
+//
+// Without a file it generates a synthetic U + IA stream with SP_CHECK, corrupts and drops bytes at
+// fixed intervals, and checks that every delivered packet decodes to the value that was sent.
+//
+// Build from the repository root:
+//   g++ -O2 -std=c++17 -I. tools/host/dma_replay.cpp V93XX_DmaStream.cpp -o dma_replay
+//   ./dma_replay capture.bin [ctrl5_hex] [sample_bytes] [--csv]
+//   ./dma_replay [--csv]
+
+#include "V93XX_DmaStream.h"
+#include "V93XX_Frames.h"
+#include "V93XX_Registers.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr size_t kRingSamples = 4096;
+constexpr uint32_t kSyntheticPackets = 200000;
+constexpr uint32_t kCorruptEvery = 1000; // Flip a bit in one packet
+constexpr uint32_t kDropEvery = 3001;    // Lose one byte (misaligns the stream)
+constexpr double kPi = 3.14159265358979323846;
+
+int16_t SyntheticU(uint32_t packet) { return (int16_t)lround(20000.0 * sin(2.0 * kPi * packet / 128.0)); }
+
+std::vector<uint8_t> Synthesize(uint32_t ctrl5) {
+    std::vector<uint8_t> stream;
+    for (uint32_t packet = 0; packet < kSyntheticPackets; packet++) {
+        const int16_t values[2] = {SyntheticU(packet), (int16_t)packet};
+        uint8_t bytes[5];
+        uint8_t sum = 0;
+        for (int ch = 0; ch < 2; ch++) {
+            bytes[2 * ch] = (uint8_t)((uint16_t)values[ch] >> 8);
+            bytes[2 * ch + 1] = (uint8_t)values[ch];
+            sum = (uint8_t)(sum + bytes[2 * ch] + bytes[2 * ch + 1]);
+        }
+        bytes[4] = V93XX_Frames::Checksum(sum);
+        if (packet % kCorruptEvery == kCorruptEvery - 1) {
+            bytes[1] ^= 0x10;
+        }
+        size_t length = (ctrl5 & DSP_CTRL5_SP_CHECK) ? 5 : 4;
+        if (packet % kDropEvery == kDropEvery - 1) {
+            memmove(bytes + 2, bytes + 3, --length - 2);
+        }
+        stream.insert(stream.end(), bytes, bytes + length);
+    }
+    return stream;
+}
+
+bool ReadFile(const char *path, std::vector<uint8_t> &stream) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        stream.insert(stream.end(), chunk, chunk + n);
+    }
+    fclose(file);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bool csv = false;
+    std::vector<const char *> args;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+
+    const bool synthetic = args.empty();
+    uint32_t ctrl5 = DSP_CTRL5_DMAEN | DSP_CTRL5_WAVE_U | DSP_CTRL5_WAVE_IA | DSP_CTRL5_SP_CHECK;
+    uint8_t sample_bytes = 2;
+    std::vector<uint8_t> stream;
+    if (synthetic) {
+        stream = Synthesize(ctrl5);
+    } else {
+        if (!ReadFile(args[0], stream)) {
+            fprintf(stderr, "cannot read %s\n", args[0]);
+            return 1;
+        }
+        if (args.size() > 1) {
+            ctrl5 = (uint32_t)strtoul(args[1], nullptr, 16);
+        }
+        if (args.size() > 2) {
+            sample_bytes = (uint8_t)atoi(args[2]);
+        }
+    }
+
+    static V93XX_DmaSample storage[kRingSamples];
+    V93XX_DmaRing ring;
+    if (!ring.Begin(storage, kRingSamples)) {
+        fprintf(stderr, "ring capacity %u is not a power of two\n", (unsigned)kRingSamples);
+        return 1;
+    }
+    V93XX_DmaParser parser;
+    if (!parser.Begin(V93XX_DmaFormat::FromCtrl5(ctrl5, sample_bytes), &ring)) {
+        fprintf(stderr, "DSP_CTRL5 0x%08X enables no wave channel (or sample_bytes is not 2-4)\n", (unsigned)ctrl5);
+        return 1;
+    }
+    const V93XX_DmaFormat &format = parser.Format();
+
+    // Feed in uneven chunks, the way DMA buffers and short transfers split the stream.
+    uint64_t delivered = 0;
+    uint64_t mismatches = 0;
+    uint32_t seed = 1;
+    size_t offset = 0;
+    V93XX_DmaSample out[256];
+    while (offset < stream.size()) {
+        seed = seed * 1103515245u + 12345u;
+        size_t chunk = 1 + ((seed >> 16) % 512);
+        if (chunk > stream.size() - offset) {
+            chunk = stream.size() - offset;
+        }
+        parser.Push(&stream[offset], chunk);
+        offset += chunk;
+
+        size_t n;
+        while ((n = ring.Read(out, 256)) > 0) {
+            for (size_t i = 0; i < n; i++) {
+                const V93XX_DmaSample &sample = out[i];
+                if (synthetic) {
+                    uint16_t packet_low = (uint16_t)sample.values[(size_t)V93XX_DmaChannel::IA];
+                    // The IA channel carries the packet number; U must match it.
+                    uint32_t packet = (uint32_t)(delivered & ~0xFFFFull) | packet_low;
+                    if (packet < delivered) {
+                        packet += 0x10000;
+                    }
+                    if (sample.values[(size_t)V93XX_DmaChannel::U] != SyntheticU(packet)) {
+                        mismatches++;
+                    }
+                }
+                if (csv) {
+                    printf("%u", (unsigned)sample.index);
+                    for (uint8_t ch = 0; ch < format.channel_count; ch++) {
+                        printf(",%d", (int)sample.values[(size_t)format.channels[ch]]);
+                    }
+                    printf("\n");
+                }
+                delivered++;
+            }
+        }
+    }
+
+    const V93XX_DmaParser::Counters &stats = parser.Stats();
+    FILE *report = csv ? stderr : stdout;
+    fprintf(report, "%zu bytes, %u channel(s) x %u bytes, check %s, %u-byte packets\n", stream.size(),
+            format.channel_count, format.sample_bytes, format.check ? "on" : "off", format.PacketBytes());
+    fprintf(report, "packets=%u check_errors=%u resyncs=%u discarded_bytes=%u ring_dropped=%u\n", stats.packets,
+            stats.check_errors, stats.resyncs, stats.discarded_bytes, ring.Dropped());
+    if (synthetic) {
+        fprintf(report, "sent=%u delivered=%llu decode_mismatches=%llu\n", kSyntheticPackets,
+                (unsigned long long)delivered, (unsigned long long)mismatches);
+        return mismatches == 0 ? 0 : 1;
+    }
+    return 0;
+}
@@ -0,0 +1,792 @@
+// Host record/replay for the V93XX link: runs a V93XX_LinkTrace recording back through the real
+// V93XX_UART / V93XX_SPI transport code on Linux. Every byte the driver sends is compared with the
+// recording and the recorded responses are fed back, either as fast as possible (default) or on
+// the recorded timeline (--timed, virtual clock: timeouts behave as on the device).
+//
+// Operations are rebuilt from the recorded requests: UART read, write and block read; SPI read,
+// write and interface init. SPI address-offset switches (writes to 0x7F) are left to the driver,
+// which issues them itself for high addresses, so a trace from any sketch replays without it.
+// Reports the frame outcomes per V93XX_Status, byte mismatches and operations per second; exits
+// with status 1 if the driver diverged from the trace.
+//
+// --synthesize first records a trace against a simulated chip (with periodic corrupt and missing
+// response bytes), for trying the tool and for benchmarking without hardware.
+//
+// Build from the repository root (one command):
+//   g++ -O2 -std=gnu++17 -I. -Itools/host/arduino -o link_replay tools/host/link_replay.cpp
+//       tools/host/arduino/Arduino.cpp V93XX_UART.cpp V93XX_SPI.cpp V93XX_Stats.cpp V93XX_LinkTrace.cpp
+//   ./link_replay trace.bin [--timed] [--clean] [--repeat N] [--verbose]
+//   ./link_replay --synthesize trace.bin [uart|spi] [operations]
+
+#include "V93XX_LinkTrace.h"
+#include "V93XX_SPI.h"
+#include "V93XX_UART.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+namespace {
+
+typedef V93XX_LinkTraceReader::Entry Entry;
+typedef V93XX_LinkTrace::Event Event;
+
+constexpr uint8_t kInterfaceControl = 0x7F;
+constexpr uint32_t kInterfaceInit = 0x5A7896B4UL;
+constexpr uint32_t kOffsetOn = 0x4A985B67UL;
+constexpr uint32_t kOffsetOff = 0x76B589A4UL;
+constexpr int kSpiCsPin = 5;
+constexpr int kUartRxPin = 16;
+constexpr int kUartTxPin = 17;
+
+uint32_t Le32(const uint8_t *data) {
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+uint32_t TraceClock() { return micros(); }
+
+void AppendToBuffer(const uint8_t *data, size_t length, void *context) {
+    std::vector<uint8_t> *buffer = (std::vector<uint8_t> *)context;
+    buffer->insert(buffer->end(), data, data + length);
+}
+
+// ---------------------------------------------------------------------------------------------
+// Trace loading
+
+struct Trace {
+    V93XX_LinkTrace::Link link = V93XX_LinkTrace::Link::Uart;
+    std::vector<Entry> entries;
+    size_t bytes = 0;
+};
+
+bool LoadTrace(const char *path, Trace &trace) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+    std::vector<uint8_t> data;
+    uint8_t chunk[65536];
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + got);
+    }
+    fclose(file);
+
+    V93XX_LinkTraceReader reader;
+    if (!reader.Begin(data.data(), data.size())) {
+        fprintf(stderr, "%s: not a V93XX_LinkTrace stream (version %u)\n", path, V93XX_LinkTrace::kVersion);
+        return false;
+    }
+    trace.link = reader.Link();
+    trace.bytes = data.size();
+    const bool uart = trace.link == V93XX_LinkTrace::Link::Uart;
+    Entry entry;
+    while (reader.Next(entry)) {
+        // Keep the events that belong to the link type.
+        bool byte_event = entry.event == Event::Tx || entry.event == Event::Rx;
+        if (byte_event == uart) {
+            trace.entries.push_back(entry);
+        }
+    }
+    if (reader.Offset() < data.size()) {
+        fprintf(stderr, "%s: truncated record at offset %zu, replaying what precedes it\n", path, reader.Offset());
+    }
+    return true;
+}
+
+struct Divergence {
+    uint32_t mismatched = 0; // Driver byte differs from the recorded one
+    uint32_t extra = 0;      // Driver sent past the end of the recording
+};
+
+// ---------------------------------------------------------------------------------------------
+// UART replay: recorded RX bytes follow each request the driver sends.
+
+class ReplaySerial : public HardwareSerial {
+  public:
+    ReplaySerial(const std::vector<Entry> &entries, bool timed) : entries(entries), timed(timed) {}
+
+    void Rewind() {
+        this->cursor = 0;
+        this->last_tx_us = 0;
+        this->pending.clear();
+        this->ready.clear();
+        this->divergence = Divergence();
+        Schedule(); // Stale bytes flushed before the first request
+    }
+
+    size_t write(const uint8_t *data, size_t length) override {
+        for (size_t i = 0; i < length; i++) {
+            if (this->cursor < this->entries.size() && this->entries[this->cursor].event == Event::Tx) {
+                const Entry &entry = this->entries[this->cursor++];
+                this->divergence.mismatched += (entry.tx != data[i]);
+                this->last_tx_us = entry.time_us;
+            } else {
+                this->divergence.extra++;
+            }
+        }
+        return length;
+    }
+
+    void flush() override { Schedule(); }
+    int available() override { return (int)this->ready.size(); }
+
+    int read() override {
+        if (this->ready.empty()) {
+            return -1;
+        }
+        uint8_t byte = this->ready.front();
+        this->ready.pop_front();
+        return byte;
+    }
+
+    static void Idle(void *context) { ((ReplaySerial *)context)->Release(); }
+
+    // Drop the request at the cursor and its response (not something the driver can send).
+    void SkipRequest() {
+        while (this->cursor < this->entries.size() && this->entries[this->cursor].event == Event::Tx) {
+            this->cursor++;
+        }
+        while (this->cursor < this->entries.size() && this->entries[this->cursor].event == Event::Rx) {
+            this->cursor++;
+        }
+    }
+
+    size_t Cursor() const { return this->cursor; }
+    size_t Remaining() const { return this->entries.size() - this->cursor + this->pending.size(); }
+    const Divergence &Diverged() const { return this->divergence; }
+
+  private:
+    struct Pending {
+        uint64_t due_us;
+        uint8_t byte;
+    };
+
+    const std::vector<Entry> &entries;
+    bool timed;
+    size_t cursor = 0;
+    uint64_t last_tx_us = 0;
+    std::deque<Pending> pending;
+    std::deque<uint8_t> ready;
+    Divergence divergence;
+
+    // Queue the recorded RX bytes up to the next request, timed from the last request byte.
+    void Schedule() {
+        uint64_t now = ArduinoHost::NowUs();
+        while (this->cursor < this->entries.size() && this->entries[this->cursor].event == Event::Rx) {
+            const Entry &entry = this->entries[this->cursor++];
+            uint64_t due = this->timed ? now + (entry.time_us - this->last_tx_us) : now;
+            this->pending.push_back(Pending{due, entry.rx});
+        }
+        Release();
+    }
+
+    void Release() {
+        bool delivered = false;
+        while (!this->pending.empty() && this->pending.front().due_us <= ArduinoHost::NowUs()) {
+            this->ready.push_back(this->pending.front().byte);
+            this->pending.pop_front();
+            delivered = true;
+        }
+        if (delivered && this->rx_callback) {
+            this->rx_callback();
+        }
+    }
+};
+
+struct UartRequest {
+    uint8_t operation;
+    uint8_t device;
+    uint8_t address;
+    uint8_t words;
+    uint32_t data;
+};
+
+bool PeekUartRequest(const std::vector<Entry> &entries, size_t at, UartRequest &request) {
+    uint8_t bytes[8];
+    size_t count = 0;
+    while (count < sizeof(bytes) && at + count < entries.size() && entries[at + count].event == Event::Tx) {
+        bytes[count] = entries[at + count].tx;
+        count++;
+    }
+    if (count < V93XX_Frames::kUartRequestSize || bytes[0] != V93XX_Frames::kMarker) {
+        return false;
+    }
+    request.operation = bytes[1] & 0x03;
+    request.device = (bytes[1] >> 2) & 0x03;
+    request.words = (uint8_t)((bytes[1] >> 4) + 1);
+    request.address = bytes[2] & 0x7F;
+    request.data = 0;
+    if (request.operation == V93XX_Frames::Write) {
+        if (count < 8) {
+            return false;
+        }
+        request.data = Le32(&bytes[3]);
+    }
+    return request.operation != V93XX_Frames::Broadcast;
+}
+
+// ---------------------------------------------------------------------------------------------
+// SPI replay: each transferred byte is answered with the recorded MISO byte.
+
+class ReplaySpi : public SPIClass {
+  public:
+    explicit ReplaySpi(const std::vector<Entry> &entries) : entries(entries) {}
+
+    void Rewind() {
+        this->cursor = 0;
+        this->divergence = Divergence();
+        this->synthetic = false;
+    }
+
+    void beginTransaction(SPISettings settings) override { this->position = 0; }
+
+    uint8_t transfer(uint8_t tx) override {
+        if (this->synthetic) {
+            return SyntheticReady(tx);
+        }
+        while (this->cursor < this->entries.size() && this->entries[this->cursor].event == Event::Control) {
+            this->cursor++;
+        }
+        if (this->cursor >= this->entries.size()) {
+            this->divergence.extra++;
+            return 0;
+        }
+        const Entry &entry = this->entries[this->cursor++];
+        this->divergence.mismatched += (entry.tx != tx);
+        return entry.rx;
+    }
+
+    // Answer the interface init locally, for traces recorded after it.
+    void SetSynthetic(bool enabled) { this->synthetic = enabled; }
+    void SkipTo(size_t at) { this->cursor = at; }
+    size_t Cursor() const { return this->cursor; }
+    size_t Remaining() const {
+        size_t remaining = 0;
+        for (size_t i = this->cursor; i < this->entries.size(); i++) {
+            remaining += this->entries[i].event == Event::Exchange;
+        }
+        return remaining;
+    }
+    const Divergence &Diverged() const { return this->divergence; }
+
+  private:
+    const std::vector<Entry> &entries;
+    size_t cursor = 0;
+    Divergence divergence;
+    bool synthetic = false;
+    uint8_t position = 0;
+    uint8_t command = 0;
+    V93XX_Frames::RunningChecksum checksum;
+
+    uint8_t SyntheticReady(uint8_t tx) {
+        // Reads return 0x00000001 with a valid checksum, which InitializeInterface() accepts.
+        uint8_t rx = 0;
+        if (this->position == 0) {
+            this->command = tx;
+            this->checksum = V93XX_Frames::RunningChecksum(tx);
+        } else if ((this->command & 1) && this->position <= 4) {
+            rx = (this->position == 1) ? 1 : 0;
+            this->checksum.Add(rx);
+        } else if (this->command & 1) {
+            rx = this->checksum.Expected();
+        }
+        this->position++;
+        return rx;
+    }
+};
+
+struct SpiFrame {
+    uint8_t tx[6];
+    size_t length;
+};
+
+// The transaction at @p at (events up to the next Deselect); @p at moves past it.
+bool PeekSpiFrame(const std::vector<Entry> &entries, size_t &at, SpiFrame &frame) {
+    while (at < entries.size() && entries[at].event == Event::Control) {
+        at++;
+    }
+    if (at >= entries.size()) {
+        return false;
+    }
+    frame.length = 0;
+    while (at < entries.size() && entries[at].event == Event::Exchange) {
+        if (frame.length < sizeof(frame.tx)) {
+            frame.tx[frame.length] = entries[at].tx;
+        }
+        frame.length++;
+        at++;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Replay runs
+
+enum OpKind { kRead, kWrite, kBlockRead, kInit, kOpKinds };
+const char *const kOpNames[kOpKinds] = {"read", "write", "block", "init"};
+const char *const kStatusNames[kV93XX_StatusCount] = {"Ok",          "NoResponse", "Truncated", "BadMarker",
+                                                     "BadChecksum", "Overrun",    "NotReady",  "VerifyMismatch",
+                                                     "InvalidArgument"};
+
+struct Results {
+    uint32_t ops[kOpKinds] = {0};
+    uint32_t status[kV93XX_StatusCount] = {0};
+    uint32_t skipped = 0;
+    Divergence divergence;
+    size_t remaining = 0;
+    uint64_t virtual_us = 0;
+
+    void Count(OpKind kind, V93XX_Status result) {
+        this->ops[kind]++;
+        this->status[(uint8_t)result]++;
+    }
+
+    uint32_t Total() const {
+        uint32_t total = 0;
+        for (uint32_t n : this->ops) {
+            total += n;
+        }
+        return total;
+    }
+};
+
+Results ReplayUart(const Trace &trace, bool timed, bool clean) {
+    Results results;
+    ReplaySerial serial(trace.entries, timed);
+    serial.Rewind();
+    ArduinoHost::SetIdleHook(ReplaySerial::Idle, &serial);
+    uint64_t start_us = ArduinoHost::NowUs();
+
+    UartRequest request;
+    uint8_t device = 0;
+    for (size_t at = 0; at < trace.entries.size(); at++) {
+        if (PeekUartRequest(trace.entries, at, request)) {
+            device = request.device;
+            break;
+        }
+    }
+    V93XX_UART driver(kUartRxPin, kUartTxPin, serial, device);
+    driver.Init(SerialConfig::SERIAL_8O1, clean ? V93XX_UART::ChecksumMode::Clean : V93XX_UART::ChecksumMode::Dirty);
+
+    while (serial.Cursor() < trace.entries.size()) {
+        if (!PeekUartRequest(trace.entries, serial.Cursor(), request) || request.device != device) {
+            serial.SkipRequest();
+            results.skipped++;
+            continue;
+        }
+        uint32_t value = 0;
+        uint32_t values[V93XX_Frames::kMaxBlockWords];
+        switch (request.operation) {
+        case V93XX_Frames::Read:
+            results.Count(kRead, driver.RegisterReadStatus(request.address, value));
+            break;
+        case V93XX_Frames::Write:
+            results.Count(kWrite, driver.RegisterWriteStatus(request.address, request.data));
+            break;
+        default:
+            results.Count(kBlockRead, driver.RegisterBlockReadStatus(values, request.words));
+            break;
+        }
+    }
+    ArduinoHost::SetIdleHook(nullptr, nullptr);
+    results.divergence = serial.Diverged();
+    results.remaining = serial.Remaining();
+    results.virtual_us = ArduinoHost::NowUs() - start_us;
+    return results;
+}
+
+Results ReplaySpiTrace(const Trace &trace, bool clean) {
+    Results results;
+    ReplaySpi bus(trace.entries);
+    bus.Rewind();
+    uint64_t start_us = ArduinoHost::NowUs();
+
+    V93XX_SPI driver(kSpiCsPin, bus);
+    V93XX_SPI::ChecksumMode mode = clean ? V93XX_SPI::ChecksumMode::Clean : V93XX_SPI::ChecksumMode::Dirty;
+    driver.Init(V93XX_SPI::WireMode::FourWire, false, mode);
+
+    size_t at = 0;
+    SpiFrame frame;
+    bool starts_with_init = PeekSpiFrame(trace.entries, at, frame) && frame.length == 6 &&
+                            frame.tx[0] == V93XX_Frames::SpiCmd(kInterfaceControl, false) &&
+                            Le32(&frame.tx[1]) == kInterfaceInit;
+    if (!starts_with_init) {
+        // Recorded after Init(): bring the driver's link up without touching the trace.
+        bus.SetSynthetic(true);
+        (void)driver.InitializeInterface();
+        bus.SetSynthetic(false);
+    }
+
+    bool offset = false; // Recorded +0x80 address offset state
+    while (true) {
+        at = bus.Cursor();
+        if (!PeekSpiFrame(trace.entries, at, frame)) {
+            break;
+        }
+        if (frame.length != 6) {
+            bus.SkipTo(at);
+            results.skipped++;
+            continue;
+        }
+        uint8_t address7 = frame.tx[0] >> 1;
+        bool read = frame.tx[0] & 1;
+        uint32_t data = Le32(&frame.tx[1]);
+        if (!read && address7 == kInterfaceControl) {
+            if (data == kInterfaceInit) {
+                results.Count(kInit, driver.InitializeInterface() ? V93XX_Status::Ok : V93XX_Status::NotReady);
+                continue;
+            }
+            if (data != kOffsetOn && data != kOffsetOff) {
+                bus.SkipTo(at);
+                results.skipped++;
+                continue;
+            }
+            offset = data == kOffsetOn;
+            // The driver emits the switch itself before the access that needs it.
+            SpiFrame next;
+            size_t after = at;
+            bool access_follows = PeekSpiFrame(trace.entries, after, next) && next.length == 6 &&
+                                  (next.tx[0] >> 1) != kInterfaceControl;
+            if (access_follows) {
+                frame = next;
+                address7 = frame.tx[0] >> 1;
+                read = frame.tx[0] & 1;
+                data = Le32(&frame.tx[1]);
+            } else {
+                driver.SetHighAddressOffsetEnabled(offset);
+                results.Count(kWrite, V93XX_Status::Ok);
+                continue;
+            }
+        }
+        uint8_t address = (uint8_t)(address7 | (offset ? 0x80 : 0x00));
+        uint32_t value = 0;
+        if (read) {
+            results.Count(kRead, driver.RegisterReadStatus(address, value));
+        } else {
+            results.Count(kWrite, driver.RegisterWriteStatus(address, data));
+        }
+    }
+    results.divergence = bus.Diverged();
+    results.remaining = bus.Remaining();
+    results.virtual_us = ArduinoHost::NowUs() - start_us;
+    return results;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Simulated chip for --synthesize
+
+uint32_t InitialRegister(uint8_t address) { return 0x01010101UL * address ^ 0x5A000000UL; }
+
+class SimUartChip : public HardwareSerial {
+  public:
+    SimUartChip() {
+        for (int i = 0; i < 256; i++) {
+            this->registers[i] = InitialRegister((uint8_t)i);
+        }
+    }
+
+    size_t write(const uint8_t *data, size_t length) override {
+        for (size_t i = 0; i < length; i++) {
+            Receive(data[i]);
+        }
+        return length;
+    }
+
+    int available() override { return (int)this->ready.size(); }
+
+    int read() override {
+        if (this->ready.empty()) {
+            return -1;
+        }
+        uint8_t byte = this->ready.front();
+        this->ready.pop_front();
+        return byte;
+    }
+
+    static void Idle(void *context) { ((SimUartChip *)context)->Release(); }
+
+  private:
+    uint32_t registers[256];
+    uint8_t request[8];
+    size_t request_length = 0;
+    uint32_t responses = 0;
+    std::deque<std::pair<uint64_t, uint8_t>> pending;
+    std::deque<uint8_t> ready;
+
+    void Receive(uint8_t byte) {
+        if (this->request_length == 0 && byte != V93XX_Frames::kMarker) {
+            return;
+        }
+        if (this->request_length == 0) {
+            this->pending.clear(); // A new request cuts off the rest of an abandoned response
+        }
+        this->request[this->request_length++] = byte;
+        uint8_t operation = this->request[1] & 0x03;
+        size_t needed = (this->request_length >= 2 && operation == V93XX_Frames::Write) ? 8 : 4;
+        if (this->request_length == needed) {
+            Respond(operation);
+            this->request_length = 0;
+        }
+    }
+
+    void Respond(uint8_t operation) {
+        uint8_t cmd1 = this->request[1];
+        uint8_t address = this->request[2] & 0x7F;
+        std::vector<uint8_t> response;
+        V93XX_Frames::RunningChecksum checksum((uint8_t)(cmd1 + address));
+        if (operation == V93XX_Frames::Write) {
+            this->registers[address] = Le32(&this->request[3]);
+            response.push_back(this->request[7]);
+        } else {
+            uint8_t words = (operation == V93XX_Frames::Block) ? (uint8_t)((cmd1 >> 4) + 1) : 1;
+            for (uint8_t w = 0; w < words; w++) {
+                uint8_t source = (operation == V93XX_Frames::Block) ? (uint8_t)(0x10 + w) : address;
+                uint32_t value = this->registers[source] + this->responses;
+                response.push_back(V93XX_Frames::kMarker);
+                for (int b = 0; b < 4; b++) {
+                    response.push_back((uint8_t)(value >> (8 * b)));
+                    checksum.Add((uint8_t)(value >> (8 * b)));
+                }
+            }
+            response.push_back(checksum.Expected());
+        }
+        this->responses++;
+        if (this->responses % 41 == 0) {
+            response[response.size() / 2] ^= 0x10; // Line noise
+        }
+        if (this->responses % 97 == 0) {
+            response.pop_back(); // Lost byte
+        }
+        // Bytes arrive one character time apart once the request has gone out.
+        uint64_t due = ArduinoHost::NowUs() + 8 * V93XX_UartTransport::kByteTimeUs;
+        for (uint8_t byte : response) {
+            due += V93XX_UartTransport::kByteTimeUs;
+            this->pending.emplace_back(due, byte);
+        }
+    }
+
+    void Release() {
+        bool delivered = false;
+        while (!this->pending.empty() && this->pending.front().first <= ArduinoHost::NowUs()) {
+            this->ready.push_back(this->pending.front().second);
+            this->pending.pop_front();
+            delivered = true;
+        }
+        if (delivered && this->rx_callback) {
+            this->rx_callback();
+        }
+    }
+};
+
+class SimSpiChip : public SPIClass {
+  public:
+    explicit SimSpiChip(uint32_t byte_time_us) : byte_time_us(byte_time_us) {
+        for (int i = 0; i < 256; i++) {
+            this->registers[i] = InitialRegister((uint8_t)i);
+        }
+    }
+
+    void beginTransaction(SPISettings settings) override { this->position = 0; }
+
+    uint8_t transfer(uint8_t tx) override {
+        ArduinoHost::Advance(this->byte_time_us);
+        uint8_t rx = 0;
+        if (this->position == 0) {
+            this->frame[0] = tx;
+            this->checksum = V93XX_Frames::RunningChecksum(tx);
+            uint8_t address = (uint8_t)((tx >> 1) | (this->offset ? 0x80 : 0x00));
+            this->value = this->registers[address] + this->reads;
+        } else if (this->frame[0] & 1) {
+            if (this->position <= 4) {
+                rx = (uint8_t)(this->value >> (8 * (this->position - 1)));
+                this->checksum.Add(rx);
+            } else if (this->position == 5) {
+                rx = this->checksum.Expected();
+                if (++this->reads % 53 == 0) {
+                    rx ^= 0x01; // Corrupt checksum
+                }
+            }
+        } else if (this->position < 6) {
+            this->frame[this->position] = tx;
+            if (this->position == 5) {
+                Write();
+            }
+        }
+        this->position++;
+        return rx;
+    }
+
+  private:
+    uint32_t byte_time_us;
+    uint32_t registers[256];
+    uint8_t frame[6] = {0};
+    uint8_t position = 0;
+    bool offset = false;
+    uint32_t value = 0;
+    uint32_t reads = 0;
+    V93XX_Frames::RunningChecksum checksum;
+
+    void Write() {
+        uint8_t address7 = this->frame[0] >> 1;
+        uint32_t data = Le32(&this->frame[1]);
+        if (address7 == kInterfaceControl) {
+            if (data == kOffsetOn || data == kOffsetOff) {
+                this->offset = data == kOffsetOn;
+            }
+            return;
+        }
+        this->registers[address7 | (this->offset ? 0x80 : 0x00)] = data;
+    }
+};
+
+bool Synthesize(const char *path, bool spi, uint32_t operations) {
+    std::vector<uint8_t> buffer;
+    V93XX_LinkTrace trace;
+    const uint8_t view[10] = {0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19};
+    uint32_t values[V93XX_Frames::kMaxBlockWords];
+    uint32_t value = 0;
+    if (spi) {
+        SimSpiChip chip(20); // 400 kHz SCLK
+        V93XX_SPI driver(kSpiCsPin, chip);
+        driver.SetLinkTrace(&trace);
+        trace.Begin(V93XX_LinkTrace::Link::Spi, AppendToBuffer, &buffer, TraceClock);
+        driver.Init(V93XX_SPI::WireMode::FourWire, true, V93XX_SPI::ChecksumMode::Dirty);
+        for (uint32_t i = 0; i < operations; i++) {
+            switch (i % 4) {
+            case 0:
+                (void)driver.RegisterWriteStatus((uint8_t)(0x30 + i % 8), i);
+                break;
+            case 1:
+                (void)driver.RegisterReadStatus((uint8_t)(0x30 + i % 8), value);
+                break;
+            case 2:
+                (void)driver.RegisterReadStatus((uint8_t)(0x80 + i % 16), value); // Offset switch on
+                break;
+            default:
+                (void)driver.RegisterReadStatus(SYS_INTSTS, value);
+                break;
+            }
+        }
+    } else {
+        SimUartChip chip;
+        ArduinoHost::SetIdleHook(SimUartChip::Idle, &chip);
+        V93XX_UART driver(kUartRxPin, kUartTxPin, chip, 0);
+        driver.SetLinkTrace(&trace);
+        trace.Begin(V93XX_LinkTrace::Link::Uart, AppendToBuffer, &buffer, TraceClock);
+        driver.Init(SerialConfig::SERIAL_8O1, V93XX_UART::ChecksumMode::Dirty);
+        driver.ConfigureBlockRead(view, sizeof(view));
+        for (uint32_t i = 0; i < operations; i++) {
+            switch (i % 4) {
+            case 0:
+                (void)driver.RegisterWriteStatus((uint8_t)(0x30 + i % 8), i);
+                break;
+            case 1:
+                (void)driver.RegisterReadStatus((uint8_t)(0x30 + i % 8), value);
+                break;
+            case 2:
+                (void)driver.RegisterBlockReadStatus(values, sizeof(view));
+                break;
+            default:
+                (void)driver.RegisterReadStatus(SYS_INTSTS, value);
+                break;
+            }
+        }
+        ArduinoHost::SetIdleHook(nullptr, nullptr);
+    }
+    trace.End();
+
+    FILE *file = fopen(path, "wb");
+    if (!file || fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+        fprintf(stderr, "cannot write %s\n", path);
+        if (file) {
+            fclose(file);
+        }
+        return false;
+    }
+    fclose(file);
+    printf("recorded %u events (%u bytes, %.1f bytes/operation) over %.3f s of link time to %s\n", trace.Events(),
+           trace.BytesWritten(), (double)trace.BytesWritten() / (operations ? operations : 1),
+           ArduinoHost::NowUs() / 1e6, path);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const char *path = nullptr;
+    bool timed = false;
+    bool clean = false;
+    bool synthesize = false;
+    bool synthesize_spi = false;
+    uint32_t operations = 2000;
+    uint32_t repeat = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--timed") == 0) {
+            timed = true;
+        } else if (strcmp(argv[i], "--clean") == 0) {
+            clean = true;
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            ArduinoHost::SetConsole(true);
+        } else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--synthesize") == 0) {
+            synthesize = true;
+        } else if (strcmp(argv[i], "spi") == 0 || strcmp(argv[i], "uart") == 0) {
+            synthesize_spi = strcmp(argv[i], "spi") == 0;
+        } else if (argv[i][0] >= '0' && argv[i][0] <= '9') {
+            operations = (uint32_t)atoi(argv[i]);
+        } else {
+            path = argv[i];
+        }
+    }
+    if (!path || repeat == 0) {
+        fprintf(stderr, "usage: %s trace.bin [--timed] [--clean] [--repeat N] [--verbose]\n"
+                        "       %s --synthesize trace.bin [uart|spi] [operations]\n",
+                argv[0], argv[0]);
+        return 2;
+    }
+    if (synthesize && !Synthesize(path, synthesize_spi, operations)) {
+        return 1;
+    }
+
+    Trace trace;
+    if (!LoadTrace(path, trace)) {
+        return 1;
+    }
+    const bool uart = trace.link == V93XX_LinkTrace::Link::Uart;
+    printf("%s trace: %zu bytes, %zu events over %.3f s\n", uart ? "UART" : "SPI", trace.bytes, trace.entries.size(),
+           trace.entries.empty() ? 0.0 : trace.entries.back().time_us / 1e6);
+
+    Results results;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t pass = 0; pass < repeat; pass++) {
+        results = uart ? ReplayUart(trace, timed, clean) : ReplaySpiTrace(trace, clean);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("replayed %u operations (", results.Total());
+    for (int k = 0; k < kOpKinds; k++) {
+        printf("%s%s %u", k ? ", " : "", kOpNames[k], results.ops[k]);
+    }
+    printf("), skipped %u unrecognized frames\n", results.skipped);
+    printf("status:");
+    for (uint8_t s = 0; s < kV93XX_StatusCount; s++) {
+        if (results.status[s]) {
+            printf(" %s=%u", kStatusNames[s], results.status[s]);
+        }
+    }
+    printf("\n");
+    printf("divergence: %u mismatched bytes, %u bytes past the recording, %zu recorded bytes not replayed\n",
+           results.divergence.mismatched, results.divergence.extra, results.remaining);
+    printf("%s: virtual link time %.3f s, wall %.3f s for %u pass(es), %.0f operations/s\n",
+           timed ? "recorded speed" : "maximum speed", results.virtual_us / 1e6, seconds, repeat,
+           seconds > 0 ? results.Total() * (double)repeat / seconds : 0.0);
+
+    bool diverged = results.divergence.mismatched || results.divergence.extra || results.remaining;
+    return diverged ? 1 : 0;
+}
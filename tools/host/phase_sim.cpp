@@ -0,0 +1,322 @@
+// Phase measurement check: a simulated V9381 behind V93XX_SPI (host Arduino core, virtual clock)
+// answers DSP_PHS_STT the way the chip does. From the moment of the trigger it samples U and I from
+// a sine model, finds the first zero crossing of each, and latches the sample counter before the
+// crossing and the two samples around it into DSP_PHS_U..DSP_PHS_IP. SYS_INTSTS.PHSDONE follows
+// the later crossing. V93XX_Phase<V93XX_SPI> measures through Measure() and Poll(), and every
+// angle is compared with the model.
+//
+// Triggers land at different points of the cycle, so the voltage and current crossings come in
+// either order and with equal or opposite slopes. Scenarios cover lag and lead, angles next to
+// +/-180 degrees, an off-nominal line frequency (SetLineFrequency()), a 16-bit counter wrap between
+// the two crossings (off-nominal too: at 50 Hz a wrap is a whole number of cycles and cannot show)
+// and a chip that never reports PHSDONE. V93XX_PhaseMath edge cases are
+// checked first. Exits with status 1 on any failure.
+//
+// Build from the repository root (one command):
+//   g++ -O2 -std=gnu++17 -pthread -I. -Itools/host/arduino -o phase_sim tools/host/phase_sim.cpp
+//       tools/host/arduino/Arduino.cpp V93XX_SPI.cpp V93XX_Stats.cpp V93XX_LinkTrace.cpp
+//   ./phase_sim [--verbose]
+
+#include "V93XX_Phase.h"
+#include "V93XX_SPI.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kSampleRateHz = 6400.0;
+constexpr uint32_t kSpiByteTimeUs = 20; // 400 kHz SCLK
+constexpr uint8_t kInterfaceControl = 0x7F;
+constexpr uint32_t kOffsetOn = 0x4A985B67UL;
+constexpr uint32_t kOffsetOff = 0x76B589A4UL;
+constexpr int kTriggers = 24;
+constexpr double kToleranceDeg = 0.05;
+
+struct Scenario {
+    const char *name;
+    double line_frequency_hz;
+    double lag_deg;         // Current lag behind voltage
+    uint32_t counter_start; // DSP_PHS_U/I counter value at time 0
+    bool wraps;             // Counter moved per trigger so it wraps between the two crossings
+    bool reports_done;      // false: PHSDONE never comes
+};
+
+uint32_t Le32(const uint8_t *data) {
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/**
+ * One V9381 as seen over SPI, reduced to the phase measurement: DSP_PHS_STT, SYS_INTSTS and the
+ * six result registers.
+ */
+class SimPhaseChip : public SPIClass {
+  public:
+    explicit SimPhaseChip(const Scenario &scenario) : scenario(scenario) {
+        memset(this->registers, 0, sizeof(this->registers));
+    }
+
+    void beginTransaction(SPISettings settings) override { this->position = 0; }
+
+    uint8_t transfer(uint8_t tx) override {
+        ArduinoHost::Advance(kSpiByteTimeUs);
+        uint8_t rx = 0;
+        if (this->position == 0) {
+            this->frame[0] = tx;
+            this->checksum = V93XX_Frames::RunningChecksum(tx);
+            if (tx & 1) {
+                this->value = Read((uint8_t)((tx >> 1) | (this->offset ? 0x80 : 0x00)));
+            }
+        } else if (this->frame[0] & 1) {
+            if (this->position <= 4) {
+                rx = (uint8_t)(this->value >> (8 * (this->position - 1)));
+                this->checksum.Add(rx);
+            } else if (this->position == 5) {
+                rx = this->checksum.Expected();
+            }
+        } else if (this->position < 6) {
+            this->frame[this->position] = tx;
+            if (this->position == 5) {
+                Write();
+            }
+        }
+        this->position++;
+        return rx;
+    }
+
+    uint32_t Triggers() const { return this->triggers; }
+
+    // Sample k after time 0, in ADC counts; the current is shifted by the lag.
+    int32_t Sample(uint64_t k, bool voltage) const {
+        double phase = 2.0 * kPi * this->scenario.line_frequency_hz * (double)k / kSampleRateHz + 0.3;
+        if (!voltage) {
+            phase -= this->scenario.lag_deg * kPi / 180.0;
+        }
+        return (int32_t)lround((voltage ? 20000.0 : 9000.0) * sin(phase));
+    }
+
+  private:
+    Scenario scenario;
+    uint32_t registers[256];
+    uint8_t frame[6] = {0};
+    uint8_t position = 0;
+    bool offset = false;
+    uint32_t value = 0;
+    V93XX_Frames::RunningChecksum checksum;
+
+    uint32_t triggers = 0;
+    uint32_t counter_start = 0;
+    bool measuring = false;
+    uint64_t done_us = 0;
+
+    // First k >= first with samples k-1 and k on opposite sides of zero (or one of them at zero).
+    uint64_t Crossing(uint64_t first, bool voltage) const {
+        for (uint64_t k = first;; k++) {
+            int32_t before = Sample(k - 1, voltage);
+            int32_t after = Sample(k, voltage);
+            if ((before <= 0 && after >= 0) || (before >= 0 && after <= 0)) {
+                return k;
+            }
+        }
+    }
+
+    void Latch(uint64_t k, bool voltage, uint8_t counter_register) {
+        this->registers[counter_register] = (uint32_t)((this->counter_start + k - 1) & 0xFFFF);
+        this->registers[counter_register + 1] = (uint32_t)Sample(k - 1, voltage);
+        this->registers[counter_register + 2] = (uint32_t)Sample(k, voltage);
+    }
+
+    void Trigger() {
+        this->triggers++;
+        uint64_t first = (uint64_t)ceil(ArduinoHost::NowUs() * 1e-6 * kSampleRateHz) + 1;
+        uint64_t voltage = Crossing(first, true);
+        uint64_t current = Crossing(first, false);
+        uint64_t earlier = (voltage < current) ? voltage : current;
+        this->counter_start = this->scenario.wraps ? (uint32_t)(0xFFFEu - (earlier - 1))
+                                                   : this->scenario.counter_start;
+        Latch(voltage, true, DSP_PHS_U);
+        Latch(current, false, DSP_PHS_I);
+        uint64_t last = (voltage > current) ? voltage : current;
+        this->done_us = (uint64_t)((double)last / kSampleRateHz * 1e6) + 1;
+        this->measuring = true;
+    }
+
+    uint32_t Read(uint8_t address) {
+        if (address == SYS_INTSTS) {
+            if (this->measuring && this->scenario.reports_done && ArduinoHost::NowUs() >= this->done_us) {
+                this->registers[SYS_INTSTS] |= SYS_INTSTS_PHSDONE;
+                this->measuring = false;
+            }
+            return this->registers[SYS_INTSTS];
+        }
+        return this->registers[address];
+    }
+
+    void Write() {
+        uint8_t address7 = this->frame[0] >> 1;
+        uint32_t data = Le32(&this->frame[1]);
+        if (address7 == kInterfaceControl) {
+            if (data == kOffsetOn || data == kOffsetOff) {
+                this->offset = data == kOffsetOn;
+            }
+            return;
+        }
+        uint8_t address = (uint8_t)(address7 | (this->offset ? 0x80 : 0x00));
+        if (address == SYS_INTSTS) {
+            this->registers[SYS_INTSTS] &= ~data;
+            return;
+        }
+        if (address == DSP_PHS_STT) {
+            Trigger();
+            return;
+        }
+        this->registers[address] = data;
+    }
+};
+
+bool Check(const char *label, double measured, double expected, double tolerance, bool verbose) {
+    bool ok = std::fabs(measured - expected) <= tolerance;
+    if (verbose || !ok) {
+        printf("    %-34s %10.4f  expected %10.4f  %s\n", label, measured, expected, ok ? "ok" : "FAIL");
+    }
+    return ok;
+}
+
+bool CheckMath(bool verbose) {
+    using namespace V93XX_PhaseMath;
+    printf("V93XX_PhaseMath\n");
+    bool ok = true;
+    ok &= Check("CrossingFraction(3, -1)", CrossingFraction(3, -1), 0.75, 1e-6, verbose);
+    ok &= Check("CrossingFraction(-100, 300)", CrossingFraction(-100, 300), 0.25, 1e-6, verbose);
+    ok &= Check("CrossingFraction(0, 0)", CrossingFraction(0, 0), 0.0, 0.0, verbose);
+    ok &= Check("CrossingFraction(5, 5) no bracket", CrossingFraction(5, 5), -1.0, 0.0, verbose);
+    ok &= Check("CrossingFraction(2, 7) no bracket", CrossingFraction(2, 7), -1.0, 0.0, verbose);
+    ok &= Check("CounterDelta(65530, 4)", CounterDelta(65530, 4), 10.0, 0.0, verbose);
+    ok &= Check("CounterDelta(4, 65530)", CounterDelta(4, 65530), -10.0, 0.0, verbose);
+    ok &= Check("CounterDelta(0, 32767)", CounterDelta(0, 32767), 32767.0, 0.0, verbose);
+    ok &= Check("CounterDelta(0, 32768)", CounterDelta(0, 32768), -32768.0, 0.0, verbose);
+    ok &= Check("CounterDelta 32-bit wrap", CounterDelta(0xFFFFFFF0UL, 0x10, 32), 32.0, 0.0, verbose);
+    ok &= Check("WrapDegrees(180)", WrapDegrees(180.0f), 180.0, 1e-4, verbose);
+    ok &= Check("WrapDegrees(-180)", WrapDegrees(-180.0f), 180.0, 1e-4, verbose);
+    ok &= Check("WrapDegrees(540)", WrapDegrees(540.0f), 180.0, 1e-4, verbose);
+    ok &= Check("WrapDegrees(-190)", WrapDegrees(-190.0f), 170.0, 1e-4, verbose);
+    ok &= Check("LagDegrees same slope", LagDegrees(100.0f, 110.0f, true, 128.0f), 28.125, 1e-4, verbose);
+    ok &= Check("LagDegrees opposite slope", LagDegrees(100.0f, 110.0f, false, 128.0f), -151.875, 1e-4, verbose);
+    ok &= Check("LagDegrees current first", LagDegrees(110.0f, 100.0f, true, 128.0f), -28.125, 1e-4, verbose);
+    printf("  %s\n", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+// Model angle as the driver reports it: (-180, 180].
+double ExpectedAngle(const Scenario &scenario) { return -std::remainder(-scenario.lag_deg, 360.0); }
+
+// Angle error on the circle, so 179.99 against -179.99 counts as 0.02.
+double AngleError(double measured, double expected) { return std::remainder(measured - expected, 360.0); }
+
+bool Run(const Scenario &scenario, bool verbose) {
+    SimPhaseChip chip(scenario);
+    V93XX_SPI driver(5, chip);
+    driver.Init(V93XX_SPI::WireMode::FourWire, true, V93XX_SPI::ChecksumMode::Clean);
+
+    typedef V93XX_Phase<V93XX_SPI> Phase;
+    Phase phase(driver);
+    Phase::Config config = Phase::DefaultConfig();
+    config.sample_rate_hz = (float)kSampleRateHz;
+    config.timeout_ms = 100;
+    phase.Begin(config);
+    phase.SetLineFrequency((float)scenario.line_frequency_hz); // As if tracked from DSP_DAT_FRQ
+
+    const double expected = ExpectedAngle(scenario);
+    double worst = 0.0;
+    int measured = 0;
+    int same_slope = 0;
+    int current_first = 0;
+    int wrapped = 0;
+    bool ok = true;
+
+    // Half the triggers through Measure(), half through the non-blocking Poll().
+    for (int i = 0; i < kTriggers; i++) {
+        // Step the trigger through one line cycle, i / kTriggers of a period after a cycle start.
+        double period_us = 1e6 / scenario.line_frequency_hz;
+        double cycle = std::floor(ArduinoHost::NowUs() / period_us) + 1.0;
+        delayMicroseconds((uint32_t)((cycle + (double)i / kTriggers) * period_us - ArduinoHost::NowUs()));
+        const Phase::Measurement *measurement = nullptr;
+        if (i % 2 == 0) {
+            measurement = &phase.Measure(config.timeout_ms);
+        } else {
+            phase.Start(millis());
+            uint32_t start = millis();
+            while (!phase.Poll(millis()) && (millis() - start) < 2 * config.timeout_ms) {
+                delay(1);
+            }
+            measurement = &phase.Latest();
+        }
+
+        if (!scenario.reports_done) {
+            bool timed_out = phase.CurrentState() == Phase::State::TimedOut && !measurement->valid &&
+                             measurement->status == V93XX_Status::NoResponse;
+            if (!timed_out) {
+                printf("    trigger %d: expected a timeout\n", i);
+                ok = false;
+            }
+            continue;
+        }
+        if (!measurement->valid || phase.CurrentState() != Phase::State::Done) {
+            printf("    trigger %d: no valid measurement (status %d)\n", i, (int)measurement->status);
+            ok = false;
+            continue;
+        }
+        measured++;
+        same_slope += measurement->voltage_rising == measurement->current_rising;
+        current_first += measurement->current_crossing < measurement->voltage_crossing;
+        int32_t offset = V93XX_PhaseMath::CounterDelta(measurement->raw[0], measurement->raw[3]);
+        wrapped += (measurement->raw[3] < measurement->raw[0]) != (offset < 0);
+        double error = AngleError(measurement->angle_deg, expected);
+        worst = std::fmax(worst, std::fabs(error));
+        if (verbose || std::fabs(error) > kToleranceDeg) {
+            printf("    trigger %2d: U %9.3f %s  I %9.3f %s  angle %9.4f deg\n", i, measurement->voltage_crossing,
+                   measurement->voltage_rising ? "rise" : "fall", measurement->current_crossing,
+                   measurement->current_rising ? "rise" : "fall", measurement->angle_deg);
+        }
+    }
+
+    if (scenario.reports_done) {
+        printf("%-24s %2d measured  same slope %2d  current first %2d  wrapped %2d  worst error %.4f deg\n",
+               scenario.name, measured, same_slope, current_first, wrapped, worst);
+        ok &= measured == kTriggers && worst <= kToleranceDeg && (!scenario.wraps || wrapped > 0);
+    } else {
+        printf("%-24s %2d triggers timed out\n", scenario.name, (int)chip.Triggers());
+        ok &= chip.Triggers() == (uint32_t)kTriggers;
+    }
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bool verbose = argc > 1 && strcmp(argv[1], "--verbose") == 0;
+
+    const Scenario scenarios[] = {
+        {"lag 30 deg", 50.0, 30.0, 1000, false, true},
+        {"lead 60 deg", 50.0, -60.0, 1000, false, true},
+        {"lag 150 deg", 50.0, 150.0, 1000, false, true},
+        {"lag 179.9 deg", 50.0, 179.9, 1000, false, true},
+        {"lead 179.9 deg", 50.0, -179.9, 1000, false, true},
+        {"in phase", 50.0, 0.0, 1000, false, true},
+        {"counter wrap at 59.93 Hz", 59.93, 45.0, 0, true, true},
+        {"lag 37 deg at 59.93 Hz", 59.93, 37.0, 30000, false, true},
+        {"no PHSDONE", 50.0, 30.0, 0, false, false},
+    };
+
+    int failures = CheckMath(verbose) ? 0 : 1;
+    for (const Scenario &scenario : scenarios) {
+        if (!Run(scenario, verbose)) {
+            failures++;
+        }
+    }
+    printf("%d of %zu checks passed\n", (int)(sizeof(scenarios) / sizeof(scenarios[0]) + 1) - failures,
+           sizeof(scenarios) / sizeof(scenarios[0]) + 1);
+    return failures ? 1 : 0;
+}
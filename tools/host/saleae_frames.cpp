@@ -0,0 +1,866 @@
+// Host decoder for Saleae Logic 2 analyzer exports of the V93XX links, for captures far too large for
+// the Python tools: the CSV is memory-mapped and scanned with memchr (SIMD in glibc), V93XX frames are
+// rebuilt from the byte stream, and the result is a summary plus an optional binary frame log.
+//
+// SPI: one "SPI" analyzer export (name,type,start_time,duration,mosi,miso). Frames are delimited by the
+// enable/disable rows (CS); in --three-wire mode CS never moves and every 6 bytes form a frame. Each
+// frame is checked for CMD, address (tracking the 0x7F offset magic), data and checksum, and the gap to
+// the previous frame is checked against the datasheet rules: >= 50 us from CS release to the next CS
+// assert (4-wire), >= 400 us of idle clock before each operation (3-wire).
+//
+// UART: two Async Serial exports (name,type,start_time,duration,data[,error]), host TX and chip RX.
+// Requests are synced on the 0x7D marker; the chip's response is every RX byte up to the next request.
+// Response latency and turnaround gaps are reported (UART has no datasheet gap rule).
+//
+// Without start_time columns frames are still decoded, but no gap is checked.
+//
+// Frame log (--log): little-endian header uint32 magic "V93F", uint8 version (1), uint8 link (0 SPI,
+// 1 UART), uint16 record size (24), uint64 record count; then per frame (per word for block reads):
+//   uint64 start_ns, uint32 duration_ns, uint32 gap_ns (UINT32_MAX if unknown), uint32 data,
+//   uint8 address (block reads: word index), uint8 op (V93XX_Frames::Operation), uint8 V93XX_Status,
+//   uint8 flags (bit 0 gap violation, bit 1 request checksum bad, bit 2 block continuation)
+//
+// Build from the repository root:
+//   g++ -O2 -std=c++17 -I. tools/host/saleae_frames.cpp -o saleae_frames
+//   ./saleae_frames spi SPI_Transactions.csv [--three-wire] [--log frames.bin]
+//   ./saleae_frames uart uart_tx.csv uart_rx.csv [--log frames.bin]
+
+#include "V93XX_Frames.h"
+#include "V93XX_Status.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint32_t kLogMagic = 0x46333956UL; // "V93F"
+constexpr uint8_t kLogVersion = 1;
+constexpr uint32_t kUnknownGap = 0xFFFFFFFFUL;
+constexpr int64_t kFourWireGapNs = 50000;
+constexpr int64_t kThreeWireIdleNs = 400000;
+constexpr size_t kMaxFields = 16;
+constexpr size_t kSpiFrameBytes = 6;
+constexpr uint32_t kSpiOffsetOn = 0x4A985B67UL;
+constexpr uint32_t kSpiOffsetOff = 0x76B589A4UL;
+
+enum LogFlag : uint8_t {
+    GapViolation = 0x01,
+    RequestChecksumBad = 0x02,
+    BlockContinuation = 0x04,
+};
+
+#pragma pack(push, 1)
+struct LogRecord {
+    uint64_t start_ns;
+    uint32_t duration_ns;
+    uint32_t gap_ns;
+    uint32_t data;
+    uint8_t address;
+    uint8_t op;
+    uint8_t status;
+    uint8_t flags;
+};
+#pragma pack(pop)
+static_assert(sizeof(LogRecord) == 24, "frame log record layout");
+
+struct Field {
+    const char *data = nullptr;
+    size_t length = 0;
+};
+
+class MappedFile {
+  public:
+    bool Open(const char *path) {
+        this->fd = open(path, O_RDONLY);
+        if (this->fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(this->fd, &info) != 0) {
+            return false;
+        }
+        this->size = (size_t)info.st_size;
+        if (this->size == 0) {
+            return true;
+        }
+        void *mapping = mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, this->fd, 0);
+        if (mapping == MAP_FAILED) {
+            return false;
+        }
+        madvise(mapping, this->size, MADV_SEQUENTIAL);
+        this->data = static_cast<const char *>(mapping);
+        return true;
+    }
+
+    ~MappedFile() {
+        if (this->data) {
+            munmap(const_cast<char *>(this->data), this->size);
+        }
+        if (this->fd >= 0) {
+            close(this->fd);
+        }
+    }
+
+    const char *data = nullptr;
+    size_t size = 0;
+
+  private:
+    int fd = -1;
+};
+
+// Splits a mapped CSV into rows and fields without copying; fields keep their quotes stripped.
+class CsvScanner {
+  public:
+    CsvScanner(const char *data, size_t size) : cursor(data), end(data + size) {}
+
+    bool Next(Field fields[kMaxFields], size_t &count) {
+        while (this->cursor < this->end) {
+            const char *line = this->cursor;
+            const char *newline = static_cast<const char *>(memchr(line, '\n', (size_t)(this->end - line)));
+            const char *line_end = newline ? newline : this->end;
+            this->cursor = newline ? newline + 1 : this->end;
+            if (line_end > line && line_end[-1] == '\r') {
+                line_end--;
+            }
+            if (line_end == line) {
+                continue;
+            }
+            count = Split(line, line_end, fields);
+            return true;
+        }
+        return false;
+    }
+
+  private:
+    const char *cursor;
+    const char *end;
+
+    static size_t Split(const char *p, const char *line_end, Field fields[kMaxFields]) {
+        size_t count = 0;
+        while (count < kMaxFields) {
+            Field &field = fields[count++];
+            if (p < line_end && *p == '"') {
+                // Quoted: runs to the closing quote (a doubled quote is part of the value).
+                const char *start = ++p;
+                while (p < line_end && !(*p == '"' && (p + 1 >= line_end || p[1] != '"'))) {
+                    p += (*p == '"') ? 2 : 1;
+                }
+                field.data = start;
+                field.length = (size_t)(p - start);
+                const char *comma = static_cast<const char *>(memchr(p, ',', (size_t)(line_end - p)));
+                if (!comma) {
+                    break;
+                }
+                p = comma + 1;
+            } else {
+                const char *comma = static_cast<const char *>(memchr(p, ',', (size_t)(line_end - p)));
+                field.data = p;
+                field.length = (size_t)((comma ? comma : line_end) - p);
+                if (!comma) {
+                    break;
+                }
+                p = comma + 1;
+            }
+        }
+        return count;
+    }
+};
+
+bool FieldIs(const Field &field, const char *text) {
+    size_t length = strlen(text);
+    if (field.length != length) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+        char c = field.data[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = (char)(c - 'A' + 'a');
+        }
+        if (c != text[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Seconds as exported ("1.234567890", "1.5e-05") to integer nanoseconds; false if empty or malformed.
+bool ParseSecondsNs(const Field &field, int64_t &ns) {
+    const char *p = field.data;
+    const char *end = p + field.length;
+    bool negative = p < end && *p == '-';
+    p += negative ? 1 : 0;
+    int64_t mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+    bool any = false;
+    for (; p < end && *p >= '0' && *p <= '9'; p++, any = true) {
+        if (digits < 18) {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits += (mantissa != 0);
+        } else {
+            exponent++;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++, any = true) {
+            if (digits < 18) {
+                mantissa = mantissa * 10 + (*p - '0');
+                digits += (mantissa != 0);
+                exponent--;
+            }
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool exp_negative = p < end && *p == '-';
+        p += (p < end && (*p == '-' || *p == '+')) ? 1 : 0;
+        int value = 0;
+        for (; p < end && *p >= '0' && *p <= '9'; p++) {
+            value = value * 10 + (*p - '0');
+        }
+        exponent += exp_negative ? -value : value;
+    }
+    if (!any || p != end) {
+        return false;
+    }
+    for (exponent += 9; exponent > 0; exponent--) {
+        mantissa *= 10;
+    }
+    for (; exponent < 0; exponent++) {
+        mantissa /= 10;
+    }
+    ns = negative ? -mantissa : mantissa;
+    return true;
+}
+
+// "0x7D", "125", "}" or an escaped control character; -1 if empty or unparsable.
+int ParseByte(const Field &field) {
+    const char *p = field.data;
+    size_t n = field.length;
+    if (n == 0) {
+        return -1;
+    }
+    if (n > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+        int value = 0;
+        for (size_t i = 2; i < n; i++) {
+            char c = p[i];
+            int digit = (c >= '0' && c <= '9') ? c - '0'
+                        : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+                        : (c >= 'A' && c <= 'F') ? c - 'A' + 10
+                                                 : -1;
+            if (digit < 0) {
+                return -1;
+            }
+            value = value * 16 + digit;
+        }
+        return value & 0xFF;
+    }
+    if (n == 1) {
+        return (uint8_t)p[0];
+    }
+    if (n == 2 && p[0] == '\\') {
+        switch (p[1]) {
+        case 'n':
+            return '\n';
+        case 'r':
+            return '\r';
+        case 't':
+            return '\t';
+        case '0':
+            return 0;
+        default:
+            return (uint8_t)p[1];
+        }
+    }
+    int value = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (p[i] < '0' || p[i] > '9') {
+            return -1;
+        }
+        value = value * 10 + (p[i] - '0');
+    }
+    return value <= 0xFF ? value : -1;
+}
+
+struct Columns {
+    int type = -1;
+    int start = -1;
+    int duration = -1;
+    int mosi = -1;
+    int miso = -1;
+    int data = -1;
+    int error = -1;
+
+    void FromHeader(const Field *fields, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            int *slot = FieldIs(fields[i], "type")         ? &this->type
+                        : FieldIs(fields[i], "start_time") ? &this->start
+                        : FieldIs(fields[i], "duration")   ? &this->duration
+                        : FieldIs(fields[i], "mosi")       ? &this->mosi
+                        : FieldIs(fields[i], "miso")       ? &this->miso
+                        : FieldIs(fields[i], "data")       ? &this->data
+                        : FieldIs(fields[i], "error")      ? &this->error
+                                                           : nullptr;
+            if (slot) {
+                *slot = (int)i;
+            }
+        }
+    }
+
+    bool Timed() const { return this->start >= 0; }
+};
+
+const Field &At(const Field *fields, size_t count, int column) {
+    static const Field empty;
+    return (column >= 0 && (size_t)column < count) ? fields[column] : empty;
+}
+
+uint32_t Saturate(int64_t ns) { return (ns < 0) ? 0 : (ns >= (int64_t)kUnknownGap) ? kUnknownGap - 1 : (uint32_t)ns; }
+
+class FrameLog {
+  public:
+    bool Open(const char *path, uint8_t link) {
+        this->file = fopen(path, "wb");
+        if (!this->file) {
+            return false;
+        }
+        setvbuf(this->file, nullptr, _IOFBF, 1 << 20);
+        WriteHeader(link);
+        this->link = link;
+        return true;
+    }
+
+    void Add(const LogRecord &record) {
+        if (this->file) {
+            fwrite(&record, sizeof(record), 1, this->file);
+            this->records++;
+        }
+    }
+
+    ~FrameLog() {
+        if (this->file) {
+            fseek(this->file, 0, SEEK_SET);
+            WriteHeader(this->link);
+            fclose(this->file);
+        }
+    }
+
+  private:
+    FILE *file = nullptr;
+    uint8_t link = 0;
+    uint64_t records = 0;
+
+    void WriteHeader(uint8_t link) {
+        uint8_t header[16];
+        const uint16_t record_size = sizeof(LogRecord);
+        memcpy(header, &kLogMagic, 4);
+        header[4] = kLogVersion;
+        header[5] = link;
+        memcpy(header + 6, &record_size, 2);
+        memcpy(header + 8, &this->records, 8);
+        fwrite(header, sizeof(header), 1, this->file);
+    }
+};
+
+struct Summary {
+    uint64_t frames = 0;
+    uint64_t by_op[4] = {0};
+    uint64_t by_status[kV93XX_StatusCount] = {0};
+    uint64_t request_checksum_bad = 0;
+    uint64_t gap_violations = 0;
+    uint64_t gaps_checked = 0;
+    int64_t min_gap_ns = INT64_MAX;
+    uint64_t stray_bytes = 0;
+    uint64_t byte_errors = 0;
+    uint64_t latency_count = 0;
+    int64_t latency_total_ns = 0;
+    int64_t latency_max_ns = 0;
+
+    void Gap(int64_t gap_ns, bool violation) {
+        this->gaps_checked++;
+        this->gap_violations += violation;
+        if (gap_ns < this->min_gap_ns) {
+            this->min_gap_ns = gap_ns;
+        }
+    }
+};
+
+const char *const kOpNames[4] = {"broadcast", "read", "write", "block"};
+const char *const kStatusNames[kV93XX_StatusCount] = {"Ok",          "NoResponse", "Truncated", "BadMarker",
+                                                      "BadChecksum", "Overrun",    "NotReady",  "VerifyMismatch",
+                                                      "InvalidArgument"};
+
+// ---------------------------------------------------------------------------------------------------- SPI
+
+struct SpiFrame {
+    uint8_t mosi[kSpiFrameBytes];
+    uint8_t miso[kSpiFrameBytes];
+    size_t count = 0;
+    int64_t cs_on_ns = -1;
+    int64_t first_ns = -1;
+    int64_t last_end_ns = -1;
+};
+
+class SpiDecoder {
+  public:
+    SpiDecoder(bool three_wire, Summary &summary, FrameLog &log)
+        : three_wire(three_wire), summary(summary), log(log) {}
+
+    void Enable(int64_t ns) {
+        this->frame = SpiFrame();
+        this->frame.cs_on_ns = ns;
+        this->in_frame = true;
+    }
+
+    void Byte(int mosi, int miso, int64_t ns, int64_t end_ns) {
+        if (!this->in_frame) {
+            this->frame = SpiFrame();
+            this->in_frame = true;
+        }
+        if (this->frame.count == 0) {
+            this->frame.first_ns = ns;
+        }
+        if (this->frame.count < kSpiFrameBytes) {
+            this->frame.mosi[this->frame.count] = (uint8_t)(mosi < 0 ? 0 : mosi);
+            this->frame.miso[this->frame.count] = (uint8_t)(miso < 0 ? 0 : miso);
+        }
+        this->frame.count++;
+        this->frame.last_end_ns = end_ns;
+        if (this->three_wire && this->frame.count == kSpiFrameBytes) {
+            Finish(-1);
+        }
+    }
+
+    void Disable(int64_t ns) {
+        if (this->in_frame) {
+            Finish(ns);
+        }
+    }
+
+  private:
+    bool three_wire;
+    Summary &summary;
+    FrameLog &log;
+    SpiFrame frame;
+    bool in_frame = false;
+    bool high_offset = false;
+    int64_t previous_end_ns = -1; // CS release (4-wire) or last clock edge (3-wire)
+
+    void Finish(int64_t cs_off_ns) {
+        this->in_frame = false;
+        const SpiFrame &f = this->frame;
+        if (f.count == 0) {
+            return;
+        }
+        LogRecord record = {};
+        record.gap_ns = kUnknownGap;
+
+        const uint8_t cmd = f.mosi[0];
+        const bool is_read = cmd & 1;
+        const uint8_t *bytes = is_read ? f.miso : f.mosi;
+        record.op = is_read ? V93XX_Frames::Read : V93XX_Frames::Write;
+        record.address = (uint8_t)((cmd >> 1) | (this->high_offset ? 0x80 : 0));
+        record.data = (uint32_t)bytes[1] | ((uint32_t)bytes[2] << 8) | ((uint32_t)bytes[3] << 16) |
+                      ((uint32_t)bytes[4] << 24);
+        V93XX_Status status = V93XX_Status::Ok;
+        if (f.count != kSpiFrameBytes) {
+            status = V93XX_Status::Truncated;
+        } else {
+            V93XX_Frames::RunningChecksum checksum(cmd);
+            for (size_t i = 1; i < 5; i++) {
+                checksum.Add(bytes[i]);
+            }
+            if (!checksum.Matches(bytes[5])) {
+                // A bad checksum on MOSI is the host's fault, not the link's.
+                status = is_read ? V93XX_Status::BadChecksum : V93XX_Status::Ok;
+                record.flags |= is_read ? 0 : RequestChecksumBad;
+                this->summary.request_checksum_bad += !is_read;
+            }
+            if (!is_read && (cmd >> 1) == 0x7F) {
+                if (record.data == kSpiOffsetOn) {
+                    this->high_offset = true;
+                } else if (record.data == kSpiOffsetOff) {
+                    this->high_offset = false;
+                }
+            }
+        }
+        record.status = (uint8_t)status;
+
+        const int64_t start_ns = this->three_wire ? f.first_ns : (f.cs_on_ns >= 0 ? f.cs_on_ns : f.first_ns);
+        const int64_t end_ns = this->three_wire ? f.last_end_ns : (cs_off_ns >= 0 ? cs_off_ns : f.last_end_ns);
+        if (start_ns >= 0) {
+            record.start_ns = (uint64_t)start_ns;
+            record.duration_ns = Saturate(end_ns - start_ns);
+            if (this->previous_end_ns >= 0) {
+                int64_t gap = start_ns - this->previous_end_ns;
+                bool violation = gap < (this->three_wire ? kThreeWireIdleNs : kFourWireGapNs);
+                record.gap_ns = Saturate(gap);
+                record.flags |= violation ? GapViolation : 0;
+                this->summary.Gap(gap, violation);
+            }
+            this->previous_end_ns = end_ns;
+        }
+
+        this->summary.frames++;
+        this->summary.by_op[record.op]++;
+        this->summary.by_status[record.status]++;
+        this->log.Add(record);
+    }
+};
+
+bool RunSpi(const MappedFile &file, bool three_wire, Summary &summary, FrameLog &log, bool &timed) {
+    CsvScanner scanner(file.data, file.size);
+    Field fields[kMaxFields];
+    size_t count = 0;
+    Columns columns;
+    if (!scanner.Next(fields, count)) {
+        return false;
+    }
+    columns.FromHeader(fields, count);
+    if (columns.type < 0 || columns.mosi < 0 || columns.miso < 0) {
+        fprintf(stderr, "SPI export needs type, mosi and miso columns\n");
+        return false;
+    }
+    timed = columns.Timed();
+
+    SpiDecoder decoder(three_wire, summary, log);
+    while (scanner.Next(fields, count)) {
+        const Field &type = At(fields, count, columns.type);
+        int64_t ns = -1;
+        int64_t duration = 0;
+        if (timed && !ParseSecondsNs(At(fields, count, columns.start), ns)) {
+            ns = -1;
+        }
+        if (ns >= 0 && columns.duration >= 0 && !ParseSecondsNs(At(fields, count, columns.duration), duration)) {
+            duration = 0;
+        }
+        if (FieldIs(type, "result")) {
+            decoder.Byte(ParseByte(At(fields, count, columns.mosi)), ParseByte(At(fields, count, columns.miso)), ns,
+                         ns >= 0 ? ns + duration : -1);
+        } else if (FieldIs(type, "enable")) {
+            decoder.Enable(ns);
+        } else if (FieldIs(type, "disable")) {
+            decoder.Disable(ns);
+        }
+    }
+    decoder.Disable(-1);
+    return true;
+}
+
+// --------------------------------------------------------------------------------------------------- UART
+
+struct UartByte {
+    int value = -1;
+    int64_t ns = -1;
+    int64_t end_ns = -1;
+    bool error = false;
+};
+
+// One Async Serial export as a stream of bytes.
+class UartStream {
+  public:
+    UartStream(const MappedFile &file) : scanner(file.data, file.size) {
+        Field fields[kMaxFields];
+        size_t count = 0;
+        if (this->scanner.Next(fields, count)) {
+            this->columns.FromHeader(fields, count);
+        }
+        Advance();
+    }
+
+    bool Valid() const { return this->columns.data >= 0; }
+    bool Timed() const { return this->columns.Timed(); }
+    bool Done() const { return this->next.value < 0; }
+    const UartByte &Peek() const { return this->next; }
+
+    UartByte Take() {
+        UartByte byte = this->next;
+        Advance();
+        return byte;
+    }
+
+  private:
+    CsvScanner scanner;
+    Columns columns;
+    UartByte next;
+
+    void Advance() {
+        Field fields[kMaxFields];
+        size_t count = 0;
+        this->next = UartByte();
+        while (this->columns.data >= 0 && this->scanner.Next(fields, count)) {
+            int value = ParseByte(At(fields, count, this->columns.data));
+            if (value < 0) {
+                continue;
+            }
+            this->next.value = value;
+            this->next.error = At(fields, count, this->columns.error).length > 0;
+            int64_t duration = 0;
+            if (this->columns.Timed() && ParseSecondsNs(At(fields, count, this->columns.start), this->next.ns)) {
+                (void)ParseSecondsNs(At(fields, count, this->columns.duration), duration);
+                this->next.end_ns = this->next.ns + duration;
+            }
+            return;
+        }
+    }
+};
+
+bool RunUart(const MappedFile &tx_file, const MappedFile &rx_file, Summary &summary, FrameLog &log, bool &timed) {
+    UartStream tx(tx_file);
+    UartStream rx(rx_file);
+    if (!tx.Valid() || !rx.Valid()) {
+        fprintf(stderr, "UART exports need a data column\n");
+        return false;
+    }
+    timed = tx.Timed() && rx.Timed();
+
+    int64_t previous_end_ns = -1;
+    while (!tx.Done()) {
+        // Request: sync on the marker, then CMD1, CMD2, [4 data bytes for writes], checksum.
+        UartByte first = tx.Take();
+        if (first.value != V93XX_Frames::kMarker) {
+            summary.stray_bytes++;
+            continue;
+        }
+        uint8_t request[8] = {V93XX_Frames::kMarker};
+        size_t request_length = 4;
+        size_t got = 1;
+        UartByte last = first;
+        bool request_error = first.error;
+        while (got < request_length && !tx.Done()) {
+            last = tx.Take();
+            request_error |= last.error;
+            request[got++] = (uint8_t)last.value;
+            uint8_t request_op = request[1] & 0x03;
+            if (got == 2 && (request_op == V93XX_Frames::Write || request_op == V93XX_Frames::Broadcast)) {
+                request_length = 8;
+            }
+        }
+        summary.byte_errors += request_error;
+        const uint8_t op = request[1] & 0x03;
+        const uint8_t words = (uint8_t)((request[1] >> 4) + 1);
+        uint8_t sum = 0;
+        for (size_t i = 1; i + 1 < request_length; i++) {
+            sum = (uint8_t)(sum + request[i]);
+        }
+        const uint8_t request_checksum = V93XX_Frames::Checksum(sum);
+        bool request_bad = got < request_length || request[request_length - 1] != request_checksum;
+
+        // Response: every RX byte from the end of the request until the next request starts.
+        const int64_t request_end_ns = last.end_ns;
+        const int64_t next_request_ns = tx.Done() ? INT64_MAX : tx.Peek().ns;
+        while (!rx.Done() && timed && rx.Peek().ns < request_end_ns) {
+            rx.Take();
+            summary.stray_bytes++;
+        }
+        uint8_t response[1 + 5 * V93XX_Frames::kMaxBlockWords + 1];
+        size_t response_length = 0;
+        int64_t response_first_ns = -1;
+        int64_t response_end_ns = request_end_ns;
+        const size_t expected = (op == V93XX_Frames::Read)    ? 6
+                                : (op == V93XX_Frames::Block) ? 5 * (size_t)words + 1
+                                : (op == V93XX_Frames::Write) ? 1
+                                                              : 0;
+        while (!rx.Done() && (timed ? rx.Peek().ns < next_request_ns : response_length < expected)) {
+            UartByte byte = rx.Take();
+            summary.byte_errors += byte.error;
+            if (response_length == 0) {
+                response_first_ns = byte.ns;
+            }
+            if (response_length < sizeof(response)) {
+                response[response_length++] = (uint8_t)byte.value;
+            } else {
+                summary.stray_bytes++;
+            }
+            response_end_ns = byte.end_ns;
+        }
+
+        // Validate against the request, as the driver does.
+        V93XX_Frames::RunningChecksum checksum((uint8_t)(request[1] + request[2]));
+        V93XX_Status status = V93XX_Status::Ok;
+        uint32_t values[V93XX_Frames::kMaxBlockWords] = {0};
+        uint8_t value_count = 1;
+        if (expected == 0) {
+            status = V93XX_Status::Ok;
+        } else if (response_length == 0) {
+            status = V93XX_Status::NoResponse;
+        } else if (op == V93XX_Frames::Write) {
+            status = (response[0] == request_checksum) ? V93XX_Status::Ok : V93XX_Status::BadChecksum;
+        } else {
+            size_t offset = 0;
+            while (offset < response_length && response[offset] != V93XX_Frames::kMarker) {
+                offset++; // Line noise ahead of the marker
+                summary.stray_bytes++;
+            }
+            value_count = (op == V93XX_Frames::Block) ? words : 1;
+            for (uint8_t w = 0; w < value_count && status == V93XX_Status::Ok; w++) {
+                if (offset + 5 > response_length) {
+                    status = V93XX_Status::Truncated;
+                } else if (response[offset] != V93XX_Frames::kMarker) {
+                    status = V93XX_Status::BadMarker;
+                } else {
+                    for (size_t j = 0; j < 4; j++) {
+                        checksum.Add(response[offset + 1 + j]);
+                        values[w] |= (uint32_t)response[offset + 1 + j] << (8 * j);
+                    }
+                    offset += 5;
+                }
+            }
+            if (status == V93XX_Status::Ok) {
+                if (offset >= response_length) {
+                    status = V93XX_Status::Truncated;
+                } else if (!checksum.Matches(response[offset])) {
+                    status = V93XX_Status::BadChecksum;
+                }
+            }
+        }
+
+        LogRecord record = {};
+        record.gap_ns = kUnknownGap;
+        record.op = op;
+        record.status = (uint8_t)status;
+        record.flags = request_bad ? RequestChecksumBad : 0;
+        record.address = (op == V93XX_Frames::Block) ? 0 : (uint8_t)(request[2] & 0x7F);
+        if (op == V93XX_Frames::Write || op == V93XX_Frames::Broadcast) {
+            values[0] = (uint32_t)request[3] | ((uint32_t)request[4] << 8) | ((uint32_t)request[5] << 16) |
+                        ((uint32_t)request[6] << 24);
+        }
+        if (timed && first.ns >= 0) {
+            record.start_ns = (uint64_t)first.ns;
+            record.duration_ns = Saturate(response_end_ns - first.ns);
+            if (previous_end_ns >= 0) {
+                record.gap_ns = Saturate(first.ns - previous_end_ns);
+                summary.Gap(first.ns - previous_end_ns, false);
+            }
+            if (response_first_ns >= 0) {
+                int64_t latency = response_first_ns - request_end_ns;
+                summary.latency_count++;
+                summary.latency_total_ns += latency;
+                if (latency > summary.latency_max_ns) {
+                    summary.latency_max_ns = latency;
+                }
+            }
+            previous_end_ns = response_end_ns;
+        }
+        for (uint8_t w = 0; w < value_count; w++) {
+            record.data = values[w];
+            if (op == V93XX_Frames::Block) {
+                record.address = w;
+                record.flags = (uint8_t)((request_bad ? RequestChecksumBad : 0) | (w ? BlockContinuation : 0));
+            }
+            log.Add(record);
+        }
+
+        summary.frames++;
+        summary.by_op[op]++;
+        summary.by_status[record.status]++;
+        summary.request_checksum_bad += request_bad;
+    }
+    return true;
+}
+
+void PrintSummary(const char *link, const Summary &summary, bool timed, bool uart, size_t bytes, double seconds) {
+    printf("%s: %zu bytes of CSV in %.3f s (%.0f MB/s)\n", link, bytes, seconds,
+           seconds > 0 ? bytes / seconds / 1e6 : 0.0);
+    printf("frames %llu:", (unsigned long long)summary.frames);
+    for (size_t op = 0; op < 4; op++) {
+        if (summary.by_op[op]) {
+            printf(" %s=%llu", kOpNames[op], (unsigned long long)summary.by_op[op]);
+        }
+    }
+    printf("\nstatus:");
+    for (size_t s = 0; s < kV93XX_StatusCount; s++) {
+        if (summary.by_status[s]) {
+            printf(" %s=%llu", kStatusNames[s], (unsigned long long)summary.by_status[s]);
+        }
+    }
+    printf("\nrequest checksum errors %llu, stray bytes %llu, byte errors %llu\n",
+           (unsigned long long)summary.request_checksum_bad, (unsigned long long)summary.stray_bytes,
+           (unsigned long long)summary.byte_errors);
+    if (!timed) {
+        printf("no start_time column: gaps not checked\n");
+        return;
+    }
+    if (summary.gaps_checked) {
+        printf("inter-frame gaps %llu, min %.1f us", (unsigned long long)summary.gaps_checked,
+               summary.min_gap_ns / 1000.0);
+        if (!uart) {
+            printf(", violations %llu", (unsigned long long)summary.gap_violations);
+        }
+        printf("\n");
+    }
+    if (summary.latency_count) {
+        printf("response latency mean %.1f us, max %.1f us\n",
+               summary.latency_total_ns / 1000.0 / summary.latency_count, summary.latency_max_ns / 1000.0);
+    }
+}
+
+int Usage() {
+    fprintf(stderr, "usage: saleae_frames spi export.csv [--three-wire] [--log frames.bin]\n"
+                    "       saleae_frames uart tx.csv rx.csv [--log frames.bin]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        return Usage();
+    }
+    const bool uart = strcmp(argv[1], "uart") == 0;
+    if (!uart && strcmp(argv[1], "spi") != 0) {
+        return Usage();
+    }
+    const char *paths[2] = {nullptr, nullptr};
+    size_t path_count = 0;
+    const char *log_path = nullptr;
+    bool three_wire = false;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+            log_path = argv[++i];
+        } else if (strcmp(argv[i], "--three-wire") == 0) {
+            three_wire = true;
+        } else if (path_count < 2) {
+            paths[path_count++] = argv[i];
+        } else {
+            return Usage();
+        }
+    }
+    if (path_count != (uart ? 2u : 1u)) {
+        return Usage();
+    }
+
+    MappedFile files[2];
+    size_t bytes = 0;
+    for (size_t i = 0; i < path_count; i++) {
+        if (!files[i].Open(paths[i])) {
+            fprintf(stderr, "cannot map %s\n", paths[i]);
+            return 1;
+        }
+        bytes += files[i].size;
+    }
+    FrameLog log;
+    if (log_path && !log.Open(log_path, uart ? 1 : 0)) {
+        fprintf(stderr, "cannot write %s\n", log_path);
+        return 1;
+    }
+
+    Summary summary;
+    bool timed = false;
+    auto start = std::chrono::steady_clock::now();
+    bool ok = uart ? RunUart(files[0], files[1], summary, log, timed)
+                   : RunSpi(files[0], three_wire, summary, log, timed);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!ok) {
+        return 1;
+    }
+    PrintSummary(uart ? "UART" : (three_wire ? "SPI (3-wire)" : "SPI (4-wire)"), summary, timed, uart, bytes,
+                 seconds);
+    return 0;
+}
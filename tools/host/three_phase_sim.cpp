@@ -0,0 +1,371 @@
+// Three-phase aggregation check: three simulated single-phase chips, each behind its own V93XX_SPI
+// driver (host Arduino core, virtual clock), feed V93XX_ThreePhase through the same paths as on the
+// device: V93XX_Acquisition snapshots collected by V93XX_MultiBus, and streamed CaptureWaveform()
+// captures of U and I timestamped with micros(). Each chip generates its waveform from the virtual
+// clock at the moment its capture is triggered, so the six captures start at different times and
+// only line up through the timestamps, as on real hardware.
+//
+// Every scenario (balanced, reversed rotation, unbalanced, off-nominal frequency, registers only)
+// is compared with a direct phasor calculation; exits with status 1 if any figure is out of
+// tolerance.
+//
+// Build from the repository root (one command):
+//   g++ -O2 -std=gnu++17 -pthread -I. -Itools/host/arduino -o three_phase_sim tools/host/three_phase_sim.cpp
+//       tools/host/arduino/Arduino.cpp V93XX_SPI.cpp V93XX_Stats.cpp V93XX_LinkTrace.cpp V93XX_ThreePhase.cpp
+//   ./three_phase_sim [--verbose]
+
+#include "V93XX_Acquisition.h"
+#include "V93XX_MultiBus.h"
+#include "V93XX_RegisterMap.h"
+#include "V93XX_SPI.h"
+#include "V93XX_ThreePhase.h"
+
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+typedef std::complex<double> Phasor;
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kSampleRateHz = 6400.0;
+constexpr uint16_t kCaptureWords = 256; // 512 samples: 4 cycles at 50 Hz
+constexpr uint32_t kSpiByteTimeUs = 20; // 400 kHz SCLK
+constexpr uint8_t kInterfaceControl = 0x7F;
+constexpr uint32_t kOffsetOn = 0x4A985B67UL;
+constexpr uint32_t kOffsetOff = 0x76B589A4UL;
+
+// Register scales used by both the chip model and the aggregator.
+constexpr double kVoltsPerCount = 1e-4;
+constexpr double kAmpsPerCount = 1e-5;
+constexpr double kWattsPerCount = 1e-3;
+
+struct PhaseModel {
+    double voltage_rms;
+    double voltage_deg;
+    double current_rms;
+    double current_deg; // Absolute, i.e. voltage_deg minus the power angle
+};
+
+struct Scenario {
+    const char *name;
+    double line_frequency_hz;
+    PhaseModel phases[3];
+    bool captures;
+};
+
+uint32_t Le32(const uint8_t *data) {
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/**
+ * One V9381 as seen over SPI: measurement registers from the phase model, and manual waveform
+ * captures of U or IA sampled from the virtual clock.
+ */
+class SimPhaseChip : public SPIClass {
+  public:
+    SimPhaseChip(const PhaseModel &model, double line_frequency_hz, uint32_t seed)
+        : model(model), line_frequency_hz(line_frequency_hz), noise(seed) {
+        memset(this->registers, 0, sizeof(this->registers));
+        double angle = (model.voltage_deg - model.current_deg) * kPi / 180.0;
+        double apparent = model.voltage_rms * model.current_rms;
+        this->registers[DSP_DAT_PA1] = (uint32_t)(int32_t)lround(apparent * cos(angle) / kWattsPerCount);
+        this->registers[DSP_DAT_QA1] = (uint32_t)(int32_t)lround(apparent * sin(angle) / kWattsPerCount);
+        this->registers[DSP_DAT_SA1] = (uint32_t)(int32_t)lround(apparent / kWattsPerCount);
+        this->registers[DSP_DAT_RMS1UA] = (uint32_t)lround(model.voltage_rms / kVoltsPerCount);
+        this->registers[DSP_DAT_RMS1IA] = (uint32_t)lround(model.current_rms / kAmpsPerCount);
+    }
+
+    void beginTransaction(SPISettings settings) override { this->position = 0; }
+
+    uint8_t transfer(uint8_t tx) override {
+        ArduinoHost::Advance(kSpiByteTimeUs);
+        uint8_t rx = 0;
+        if (this->position == 0) {
+            this->frame[0] = tx;
+            this->checksum = V93XX_Frames::RunningChecksum(tx);
+            if (tx & 1) {
+                this->value = Read((uint8_t)((tx >> 1) | (this->offset ? 0x80 : 0x00)));
+            }
+        } else if (this->frame[0] & 1) {
+            if (this->position <= 4) {
+                rx = (uint8_t)(this->value >> (8 * (this->position - 1)));
+                this->checksum.Add(rx);
+            } else if (this->position == 5) {
+                rx = this->checksum.Expected();
+            }
+        } else if (this->position < 6) {
+            this->frame[this->position] = tx;
+            if (this->position == 5) {
+                Write();
+            }
+        }
+        this->position++;
+        return rx;
+    }
+
+  private:
+    PhaseModel model;
+    double line_frequency_hz;
+    uint32_t noise;
+    uint32_t registers[256];
+    uint8_t frame[6] = {0};
+    uint8_t position = 0;
+    bool offset = false;
+    uint32_t value = 0;
+    V93XX_Frames::RunningChecksum checksum;
+
+    bool capture_voltage = true;
+    uint64_t capture_start_us = 0;
+    bool capturing = false;
+    uint16_t wave_pointer = 0;
+
+    uint64_t CaptureEndUs() const {
+        return this->capture_start_us + (uint64_t)(2.0 * kCaptureWords / kSampleRateHz * 1e6);
+    }
+
+    // Fundamental plus 5 % third harmonic, a DC offset and a few counts of noise, in raw ADC counts.
+    int16_t Sample(uint32_t index) {
+        double t = this->capture_start_us * 1e-6 + index / kSampleRateHz;
+        double degrees = this->capture_voltage ? this->model.voltage_deg : this->model.current_deg;
+        double peak = this->capture_voltage ? 20000.0 : 12000.0;
+        double phase = 2.0 * kPi * this->line_frequency_hz * t + degrees * kPi / 180.0;
+        this->noise = this->noise * 1664525UL + 1013904223UL;
+        double jitter = (double)(this->noise >> 28) - 7.5;
+        return (int16_t)lround(peak * cos(phase) + 0.05 * peak * cos(3.0 * phase) + 150.0 + jitter);
+    }
+
+    uint32_t Read(uint8_t address) {
+        if (address == SYS_INTSTS) {
+            uint32_t status = this->registers[SYS_INTSTS];
+            if (this->capturing && ArduinoHost::NowUs() >= CaptureEndUs()) {
+                status |= SYS_INTSTS_WAVESTORE;
+            }
+            return status;
+        }
+        if (address == SYS_MISC) {
+            return V93XX_RegisterMap::Encode<V93XX_RegisterMap::SysMisc::WaveStoreCnt>(kCaptureWords);
+        }
+        if (address == DAT_WAVE) {
+            uint32_t low = (uint16_t)Sample(2u * this->wave_pointer);
+            uint32_t high = (uint16_t)Sample(2u * this->wave_pointer + 1);
+            this->wave_pointer++;
+            return low | (high << 16);
+        }
+        return this->registers[address];
+    }
+
+    void Write() {
+        uint8_t address7 = this->frame[0] >> 1;
+        uint32_t data = Le32(&this->frame[1]);
+        if (address7 == kInterfaceControl) {
+            if (data == kOffsetOn || data == kOffsetOff) {
+                this->offset = data == kOffsetOn;
+            }
+            return;
+        }
+        uint8_t address = (uint8_t)(address7 | (this->offset ? 0x80 : 0x00));
+        if (address == SYS_INTSTS) {
+            this->registers[SYS_INTSTS] &= ~data;
+            return;
+        }
+        if (address == DSP_CTRL5) {
+            using namespace V93XX_RegisterMap;
+            if (Get<DspCtrl5::WaveAddrClr>(data)) {
+                this->wave_pointer = 0;
+            }
+            if (Get<DspCtrl5::TrigManual>(data)) {
+                this->capture_voltage = Get<DspCtrl5::WaveU>(data);
+                this->capture_start_us = ArduinoHost::NowUs();
+                this->capturing = true;
+            }
+        }
+        this->registers[address] = data;
+    }
+};
+
+struct Expected {
+    double active_power;
+    double reactive_power;
+    double apparent_power;
+    double neutral_current;
+    double voltage_unbalance;
+    double current_unbalance;
+    V93XX_PhaseRotation rotation;
+};
+
+Phasor Polar(double magnitude, double degrees) { return std::polar(magnitude, degrees * kPi / 180.0); }
+
+double UnbalancePercent(const Phasor (&x)[3], bool reversed) {
+    const Phasor a = Polar(1.0, 120.0);
+    Phasor positive = (x[0] + a * x[1] + a * a * x[2]) / 3.0;
+    Phasor negative = (x[0] + a * a * x[1] + a * x[2]) / 3.0;
+    if (reversed) {
+        std::swap(positive, negative);
+    }
+    return 100.0 * std::abs(negative) / std::abs(positive);
+}
+
+Expected Compute(const Scenario &scenario) {
+    Expected expected = {};
+    Phasor voltages[3];
+    Phasor currents[3];
+    Phasor neutral = 0.0;
+    for (int i = 0; i < 3; i++) {
+        const PhaseModel &phase = scenario.phases[i];
+        double power_angle = (phase.voltage_deg - phase.current_deg) * kPi / 180.0;
+        double apparent = phase.voltage_rms * phase.current_rms;
+        expected.active_power += apparent * cos(power_angle);
+        expected.reactive_power += apparent * sin(power_angle);
+        expected.apparent_power += apparent;
+        // Without captures the aggregator assumes ideal ABC voltages; so does the reference.
+        double voltage_deg = scenario.captures ? phase.voltage_deg : -120.0 * i;
+        double current_deg = voltage_deg - (phase.voltage_deg - phase.current_deg);
+        voltages[i] = Polar(phase.voltage_rms, voltage_deg);
+        currents[i] = Polar(phase.current_rms, current_deg);
+        neutral += currents[i];
+    }
+    expected.neutral_current = std::abs(neutral);
+    double b = std::remainder(scenario.phases[1].voltage_deg - scenario.phases[0].voltage_deg, 360.0);
+    expected.rotation = !scenario.captures ? V93XX_PhaseRotation::Unknown
+                        : (b < 0)          ? V93XX_PhaseRotation::Abc
+                                           : V93XX_PhaseRotation::Acb;
+    bool reversed = expected.rotation == V93XX_PhaseRotation::Acb;
+    expected.voltage_unbalance = UnbalancePercent(voltages, reversed);
+    expected.current_unbalance = UnbalancePercent(currents, reversed);
+    return expected;
+}
+
+const char *RotationName(V93XX_PhaseRotation rotation) {
+    switch (rotation) {
+    case V93XX_PhaseRotation::Abc:
+        return "ABC";
+    case V93XX_PhaseRotation::Acb:
+        return "ACB";
+    default:
+        return "unknown";
+    }
+}
+
+bool Check(const char *label, double measured, double expected, double tolerance, bool verbose) {
+    bool ok = std::fabs(measured - expected) <= tolerance;
+    if (verbose || !ok) {
+        printf("    %-18s %12.3f  expected %12.3f  %s\n", label, measured, expected, ok ? "ok" : "OUT OF TOLERANCE");
+    }
+    return ok;
+}
+
+bool Run(const Scenario &scenario, bool verbose) {
+    SimPhaseChip chip_a(scenario.phases[0], scenario.line_frequency_hz, 1);
+    SimPhaseChip chip_b(scenario.phases[1], scenario.line_frequency_hz, 2);
+    SimPhaseChip chip_c(scenario.phases[2], scenario.line_frequency_hz, 3);
+    V93XX_SPI drivers[3] = {V93XX_SPI(5, chip_a), V93XX_SPI(6, chip_b), V93XX_SPI(7, chip_c)};
+    V93XX_Acquisition<V93XX_SPI> acquisition_a(drivers[0]);
+    V93XX_Acquisition<V93XX_SPI> acquisition_b(drivers[1]);
+    V93XX_Acquisition<V93XX_SPI> acquisition_c(drivers[2]);
+    V93XX_Acquisition<V93XX_SPI> *acquisitions[3] = {&acquisition_a, &acquisition_b, &acquisition_c};
+    V93XX_MultiBus bus;
+    for (int i = 0; i < 3; i++) {
+        drivers[i].Init(V93XX_SPI::WireMode::FourWire, true, V93XX_SPI::ChecksumMode::Clean);
+        acquisitions[i]->AddGroup(DSP_DAT_PA1, 9, 1000); // PA1..RMS1IB
+        bus.Add(*acquisitions[i]);
+    }
+
+    V93XX_ThreePhase::Config config = V93XX_ThreePhase::DefaultConfig();
+    config.sample_rate_hz = (float)kSampleRateHz;
+    config.line_frequency_hz = (float)scenario.line_frequency_hz; // As if tracked from DSP_DAT_FRQ
+    for (int i = 0; i < 3; i++) {
+        config.voltage_scale[i] = (float)kVoltsPerCount;
+        config.current_scale[i] = (float)kAmpsPerCount;
+        config.power_scale[i] = (float)kWattsPerCount;
+    }
+    V93XX_ThreePhase aggregator;
+    aggregator.Begin(config);
+
+    for (int i = 0; i < 3; i++) {
+        acquisitions[i]->Poll();
+    }
+    static V93XX_MultiBus::Frame frame;
+    bool complete = bus.Collect(frame) && aggregator.SetReadings(frame);
+
+    if (scenario.captures) {
+        using namespace V93XX_RegisterMap;
+        const V93XX_ThreePhase::Quantity quantities[2] = {V93XX_ThreePhase::Quantity::Voltage,
+                                                          V93XX_ThreePhase::Quantity::Current};
+        for (V93XX_ThreePhase::Quantity quantity : quantities) {
+            bool voltage = quantity == V93XX_ThreePhase::Quantity::Voltage;
+            uint32_t ctrl5 = Encode<DspCtrl5::WaveU>(voltage) | Encode<DspCtrl5::WaveIa>(!voltage) |
+                             Encode<DspCtrl5::WaveMemMode>(DspCtrl5::WaveMem::ManualSingle);
+            for (uint8_t phase = 0; phase < 3; phase++) {
+                V93XX_ThreePhase::Capture capture = aggregator.BeginCapture(phase, quantity, micros());
+                complete &= drivers[phase].CaptureWaveform(V93XX_ThreePhase::Sink, &capture, kCaptureWords, ctrl5);
+            }
+        }
+    }
+
+    const V93XX_ThreePhaseSnapshot &snapshot = aggregator.Latest();
+    Expected expected = Compute(scenario);
+    printf("%-26s rotation %-7s  neutral %7.3f A  unbalance U %5.2f %%  I %6.2f %%  span %6.1f ms\n", scenario.name,
+           RotationName(snapshot.rotation), snapshot.neutral_current, snapshot.voltage_unbalance,
+           snapshot.current_unbalance, snapshot.capture_span_us / 1000.0);
+
+    bool ok = complete && snapshot.aligned && snapshot.angles_measured == scenario.captures;
+    if (!ok) {
+        printf("    incomplete: captures/readings failed, not aligned or angles not measured\n");
+    }
+    double max_current = 0.0;
+    for (const PhaseModel &phase : scenario.phases) {
+        max_current = std::max(max_current, phase.current_rms);
+    }
+    // 0.5 degree of angle error moves the neutral by about 1 % of a phase current.
+    ok &= Check("P total (W)", snapshot.active_power, expected.active_power, 0.5, verbose);
+    ok &= Check("Q total (var)", snapshot.reactive_power, expected.reactive_power, 0.5, verbose);
+    ok &= Check("S total (VA)", snapshot.apparent_power, expected.apparent_power, 0.5, verbose);
+    ok &= Check("neutral (A)", snapshot.neutral_current, expected.neutral_current, 0.01 * max_current, verbose);
+    ok &= Check("U unbalance (%)", snapshot.voltage_unbalance, expected.voltage_unbalance, 0.2, verbose);
+    ok &= Check("I unbalance (%)", snapshot.current_unbalance, expected.current_unbalance, 0.5, verbose);
+    if (snapshot.rotation != expected.rotation) {
+        printf("    rotation %s, expected %s\n", RotationName(snapshot.rotation), RotationName(expected.rotation));
+        ok = false;
+    }
+    if (verbose && snapshot.angles_measured) {
+        for (int i = 0; i < 3; i++) {
+            printf("    phase %c: U %8.2f deg (model %8.2f)  I %8.2f deg (model %8.2f)\n", 'A' + i,
+                   snapshot.voltage_angle_deg[i],
+                   std::remainder(scenario.phases[i].voltage_deg - scenario.phases[0].voltage_deg, 360.0),
+                   snapshot.current_angle_deg[i],
+                   std::remainder(scenario.phases[i].current_deg - scenario.phases[0].voltage_deg, 360.0));
+        }
+    }
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bool verbose = argc > 1 && strcmp(argv[1], "--verbose") == 0;
+
+    // Absolute angles: the current angle is the voltage angle minus the power angle (lagging positive).
+    const Scenario scenarios[] = {
+        {"balanced ABC, PF 0.9",
+         50.0,
+         {{230, 17, 10, 17 - 25.84}, {230, -103, 10, -103 - 25.84}, {230, 137, 10, 137 - 25.84}},
+         true},
+        {"balanced ACB", 50.0, {{230, 0, 8, -30}, {230, 120, 8, 90}, {230, -120, 8, -150}}, true},
+        {"unbalanced load and supply", 50.0, {{231, 40, 12, 30}, {219, -83, 4, -140}, {236, 161, 7.5, 161}}, true},
+        {"unbalanced at 59.93 Hz", 59.93, {{120, -60, 20, -80}, {118, 178, 14, 140}, {123, 58, 25, 50}}, true},
+        {"registers only", 50.0, {{231, 0, 12, -10}, {219, -120, 4, -177}, {236, 120, 7.5, 120}}, false},
+    };
+
+    int failures = 0;
+    for (const Scenario &scenario : scenarios) {
+        if (!Run(scenario, verbose)) {
+            failures++;
+        }
+    }
+    printf("%d of %zu scenarios within tolerance\n", (int)(sizeof(scenarios) / sizeof(scenarios[0])) - failures,
+           sizeof(scenarios) / sizeof(scenarios[0]));
+    return failures ? 1 : 0;
+}
@@ -34,9 +34,23 @@ def main() -> int:
         type=Path,
         help="Path to a CSV/text file with one sample per line or comma-separated.",
     )
+    parser.add_argument(
+        "--telemetry",
+        type=Path,
+        help="Raw binary telemetry recording (telemetry_decode.py --record); plots the first capture.",
+    )
     args = parser.parse_args()
 
-    wave_data = load_samples(args.csv)
+    if args.telemetry is not None:
+        from telemetry_decode import read_captures
+
+        captures = read_captures(args.telemetry)
+        if not captures:
+            print(f"no complete capture in {args.telemetry}")
+            return 1
+        wave_data = [float(s) for s in captures[0].samples()]
+    else:
+        wave_data = load_samples(args.csv)
 
     plt.figure("Waveform")
     plt.plot(wave_data)
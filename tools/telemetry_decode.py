@@ -0,0 +1,380 @@
+#!/usr/bin/env python3
+"""Decode V93XX_Telemetry binary frames (see V93XX_Telemetry.h) from a serial port or a recording."""
+
+from __future__ import annotations
+
+import argparse
+import binascii
+import struct
+import sys
+import time
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Dict, Iterator, List, Optional
+
+VERSION = 1
+HEADER = struct.Struct("<BBHI")
+WAVEFORM = struct.Struct("<HIHBB")
+REGISTERS = struct.Struct("<BBBB")
+
+TYPE_WAVEFORM = 1
+TYPE_REGISTERS = 2
+TYPE_EVENT = 3
+TYPE_WAVEFORM_CODED = 4
+TYPE_LINK_TRACE = 5
+
+# V93XX_WaveCodec.h
+CODEC_MAX_ORDER = 3
+CODEC_VERBATIM = 0x1F
+CODEC_ESCAPE_QUOTIENT = 16
+CODEC_ESCAPE_BITS = 20
+
+STATUS_NAMES = ["Ok", "NoResponse", "Truncated", "BadMarker", "BadChecksum", "Overrun", "NotReady", "VerifyMismatch",
+                "InvalidArgument"]
+
+
+def cobs_decode(data: bytes) -> Optional[bytes]:
+    """Undo COBS framing (delimiters already removed); None if the block codes are inconsistent."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1 : i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def crc16(data: bytes) -> int:
+    """CRC-16/CCITT-FALSE, as computed by the firmware."""
+    return binascii.crc_hqx(data, 0xFFFF)
+
+
+def status_name(status: int) -> str:
+    return STATUS_NAMES[status] if status < len(STATUS_NAMES) else f"status {status}"
+
+
+@dataclass
+class Record:
+    type: int
+    sequence: int
+    timestamp_ms: int
+    payload: bytes
+
+
+@dataclass
+class WaveformChunk:
+    capture_id: int
+    ctrl5: int
+    first_word: int
+    words: List[int]
+    overflow: bool
+    last: bool
+    status: int
+
+
+@dataclass
+class Capture:
+    capture_id: int
+    ctrl5: int
+    timestamp_ms: int
+    words: List[int] = field(default_factory=list)
+    overflow: bool = False
+    errors: int = 0
+    missing_words: int = 0
+
+    def samples(self) -> List[int]:
+        """Unpack each word low half first (single-channel layout: sample 2n, 2n+1)."""
+        out: List[int] = []
+        for word in self.words:
+            for half in (word & 0xFFFF, word >> 16):
+                out.append(half - 0x10000 if half & 0x8000 else half)
+        return out
+
+
+class WaveDecoder:
+    """Python counterpart of V93XX_WaveDecoder: one instance per capture, blocks fed in order."""
+
+    def __init__(self) -> None:
+        self.history = [0] * CODEC_MAX_ORDER  # Newest first
+
+    def decode(self, block: bytes) -> Optional[List[int]]:
+        if len(block) < 2 or not 1 <= block[0] <= 64:
+            return None
+        count, order, k = block[0], block[1] >> 6, block[1] & 0x1F
+        bits = "".join(f"{b:08b}" for b in block[2:])
+        pos = 0
+        x = list(reversed(self.history))
+        for _ in range(count):
+            if k == CODEC_VERBATIM:
+                if pos + 16 > len(bits):
+                    return None
+                value = int(bits[pos : pos + 16], 2)
+                pos += 16
+                x.append(value - 0x10000 if value & 0x8000 else value)
+                continue
+            q = 0
+            while q < CODEC_ESCAPE_QUOTIENT:
+                if pos >= len(bits):
+                    return None
+                pos += 1
+                if bits[pos - 1] == "0":
+                    break
+                q += 1
+            width = CODEC_ESCAPE_BITS if q == CODEC_ESCAPE_QUOTIENT else k
+            if pos + width > len(bits):
+                return None
+            low = int(bits[pos : pos + width], 2) if width else 0
+            pos += width
+            u = low if q == CODEC_ESCAPE_QUOTIENT else (q << k) | low
+            residual = (u >> 1) ^ -(u & 1)
+            predictions = [0, x[-1], 2 * x[-1] - x[-2], 3 * x[-1] - 3 * x[-2] + x[-3]]
+            x.append(predictions[order] + residual)
+        samples = x[CODEC_MAX_ORDER:]
+        self.history = list(reversed(x[-CODEC_MAX_ORDER:]))
+        return samples
+
+
+def parse_waveform(
+    payload: bytes, coded: bool = False, decoder: Optional[WaveDecoder] = None
+) -> Optional[WaveformChunk]:
+    if len(payload) < WAVEFORM.size:
+        return None
+    capture_id, ctrl5, first_word, word_count, flags = WAVEFORM.unpack_from(payload)
+    if coded:
+        samples = decoder.decode(payload[WAVEFORM.size :]) if decoder is not None else None
+        if samples is None or len(samples) != 2 * word_count:
+            return None
+        words = [(samples[2 * i] & 0xFFFF) | (samples[2 * i + 1] & 0xFFFF) << 16 for i in range(word_count)]
+    elif len(payload) != WAVEFORM.size + 4 * word_count:
+        return None
+    else:
+        words = list(struct.unpack_from(f"<{word_count}I", payload, WAVEFORM.size))
+    return WaveformChunk(capture_id, ctrl5, first_word, words, bool(flags & 0x01), bool(flags & 0x02), flags >> 4)
+
+
+class Decoder:
+    """Splits a byte stream on 0x00 and yields validated records; anything else is counted or kept as text."""
+
+    def __init__(self) -> None:
+        self.pending = bytearray()
+        self.frames = 0
+        self.crc_errors = 0
+        self.bad_frames = 0
+        self.sequence_gaps = 0
+        self.text = bytearray()
+        self.last_sequence: Optional[int] = None
+
+    def feed(self, data: bytes) -> Iterator[Record]:
+        self.pending += data
+        while True:
+            end = self.pending.find(0)
+            if end < 0:
+                return
+            raw = bytes(self.pending[:end])
+            del self.pending[: end + 1]
+            if raw:
+                record = self._frame(raw)
+                if record is not None:
+                    yield record
+
+    def _frame(self, raw: bytes) -> Optional[Record]:
+        decoded = cobs_decode(raw)
+        if decoded is None or len(decoded) < HEADER.size + 2:
+            self._reject(raw, crc_failed=False)
+            return None
+        body, (crc,) = decoded[:-2], struct.unpack("<H", decoded[-2:])
+        if crc16(body) != crc:
+            self._reject(raw, crc_failed=True)
+            return None
+        version, type_, sequence, timestamp_ms = HEADER.unpack_from(body)
+        if version != VERSION:
+            self.bad_frames += 1
+            return None
+        if self.last_sequence is not None and sequence != (self.last_sequence + 1) & 0xFFFF:
+            self.sequence_gaps += 1
+        self.last_sequence = sequence
+        self.frames += 1
+        return Record(type_, sequence, timestamp_ms, body[HEADER.size :])
+
+    def _reject(self, raw: bytes, crc_failed: bool) -> None:
+        # Driver debug lines printed between frames land here; keep them rather than report an error.
+        if all(b in (9, 10, 13) or 32 <= b < 127 for b in raw):
+            self.text += raw
+        elif crc_failed:
+            self.crc_errors += 1
+        else:
+            self.bad_frames += 1
+
+
+class CaptureAssembler:
+    """Collects waveform chunks by capture_id into complete captures."""
+
+    def __init__(self) -> None:
+        self.open: Dict[int, Capture] = {}
+        self.decoders: Dict[int, Optional[WaveDecoder]] = {}
+
+    def add(self, record: Record) -> Optional[Capture]:
+        coded = record.type == TYPE_WAVEFORM_CODED
+        decoder = None
+        if coded and len(record.payload) >= WAVEFORM.size:
+            # Coded chunks depend on every earlier chunk of their capture: after a lost or bad chunk the
+            # rest of that capture cannot be decoded.
+            capture_id, _, first_word, _, _ = WAVEFORM.unpack_from(record.payload)
+            if first_word == 0:
+                self.decoders[capture_id] = WaveDecoder()
+                self.open.pop(capture_id, None)
+            decoder = self.decoders.get(capture_id)
+            open_capture = self.open.get(capture_id)
+            if decoder is None or first_word != (len(open_capture.words) if open_capture else 0):
+                self.decoders[capture_id] = None
+                return None
+        chunk = parse_waveform(record.payload, coded, decoder)
+        if chunk is None:
+            return None
+        if chunk.last:
+            self.decoders.pop(chunk.capture_id, None)
+        capture = self.open.get(chunk.capture_id)
+        if capture is None:
+            capture = Capture(chunk.capture_id, chunk.ctrl5, record.timestamp_ms)
+            self.open[chunk.capture_id] = capture
+        if chunk.first_word > len(capture.words):
+            # Lost chunk: pad so later samples keep their position.
+            capture.missing_words += chunk.first_word - len(capture.words)
+            capture.words += [0] * (chunk.first_word - len(capture.words))
+        capture.words[chunk.first_word :] = chunk.words
+        capture.overflow |= chunk.overflow
+        capture.errors += chunk.status != 0
+        if chunk.last:
+            return self.open.pop(chunk.capture_id)
+        return None
+
+
+def read_captures(path: Path) -> List[Capture]:
+    """All complete waveform captures in a recording."""
+    decoder = Decoder()
+    assembler = CaptureAssembler()
+    captures: List[Capture] = []
+    for record in decoder.feed(path.read_bytes()):
+        if record.type in (TYPE_WAVEFORM, TYPE_WAVEFORM_CODED):
+            capture = assembler.add(record)
+            if capture is not None:
+                captures.append(capture)
+    return captures
+
+
+def describe(record: Record) -> Optional[str]:
+    prefix = f"[{record.sequence:5d} @ {record.timestamp_ms:9d} ms]"
+    if record.type == TYPE_REGISTERS and len(record.payload) >= REGISTERS.size:
+        first, count, status, _ = REGISTERS.unpack_from(record.payload)
+        if len(record.payload) != REGISTERS.size + 4 * count:
+            return f"{prefix} registers: bad length"
+        values = struct.unpack_from(f"<{count}I", record.payload, REGISTERS.size)
+        text = " ".join(f"0x{first + i:02X}=0x{v:08X}" for i, v in enumerate(values))
+        return f"{prefix} registers ({status_name(status)}): {text}"
+    if record.type == TYPE_EVENT and len(record.payload) == 4:
+        (bits,) = struct.unpack("<I", record.payload)
+        return f"{prefix} event: SYS_INTSTS=0x{bits:08X}"
+    if record.type == TYPE_LINK_TRACE:
+        return None
+    if record.type not in (TYPE_WAVEFORM, TYPE_WAVEFORM_CODED):
+        return f"{prefix} type {record.type}, {len(record.payload)} bytes"
+    return None
+
+
+def open_source(args):
+    if args.file is not None:
+        return args.file.open("rb")
+    try:
+        import serial  # type: ignore
+    except ImportError:
+        print("error: pyserial is required for --port (pip install pyserial)", file=sys.stderr)
+        sys.exit(2)
+    return serial.Serial(args.port, args.baud, timeout=0.2)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Decode V93XX binary telemetry.")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="Serial port, e.g. /dev/ttyUSB0 or COM3.")
+    source.add_argument("--file", type=Path, help="Raw recording made with --record.")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--record", type=Path, help="Append the raw byte stream to this file.")
+    parser.add_argument("--save", type=Path, help="Write each capture as capture_<id>.csv (one sample per line).")
+    parser.add_argument("--captures", type=int, default=0, help="Stop after this many captures (0: no limit).")
+    parser.add_argument("--text", action="store_true", help="Echo text printed between frames.")
+    parser.add_argument(
+        "--link-trace", type=Path, help="Write the V93XX_LinkTrace stream carried in the telemetry to this file."
+    )
+    args = parser.parse_args()
+
+    if args.save is not None:
+        args.save.mkdir(parents=True, exist_ok=True)
+    decoder = Decoder()
+    assembler = CaptureAssembler()
+    record_file = args.record.open("ab") if args.record is not None else None
+    trace_file = args.link_trace.open("wb") if args.link_trace is not None else None
+    completed = 0
+    total_bytes = 0
+    start = time.monotonic()
+    with open_source(args) as stream:
+        try:
+            while args.captures == 0 or completed < args.captures:
+                data = stream.read(4096)
+                if not data:
+                    if args.file is not None:
+                        break
+                    continue
+                total_bytes += len(data)
+                if record_file is not None:
+                    record_file.write(data)
+                for record in decoder.feed(data):
+                    if record.type == TYPE_LINK_TRACE and trace_file is not None:
+                        trace_file.write(record.payload)
+                        continue
+                    if record.type not in (TYPE_WAVEFORM, TYPE_WAVEFORM_CODED):
+                        line = describe(record)
+                        if line:
+                            print(line)
+                        continue
+                    capture = assembler.add(record)
+                    if capture is None:
+                        continue
+                    completed += 1
+                    samples = capture.samples()
+                    flags = " OVERFLOW" if capture.overflow else ""
+                    print(
+                        f"capture {capture.capture_id}: {len(capture.words)} words, {len(samples)} samples, "
+                        f"ctrl5=0x{capture.ctrl5:08X}, {capture.errors} chunk error(s), "
+                        f"{capture.missing_words} missing word(s){flags}"
+                    )
+                    if args.save is not None:
+                        path = args.save / f"capture_{capture.capture_id}.csv"
+                        path.write_text("\n".join(str(s) for s in samples) + "\n", encoding="utf-8")
+                if args.text and decoder.text:
+                    sys.stdout.write(decoder.text.decode("ascii"))
+                    decoder.text.clear()
+        except KeyboardInterrupt:
+            pass
+    if record_file is not None:
+        record_file.close()
+    if trace_file is not None:
+        trace_file.close()
+        if decoder.sequence_gaps or decoder.crc_errors:
+            print("warning: telemetry frames were lost, the link trace may have holes", file=sys.stderr)
+
+    elapsed = time.monotonic() - start
+    print(
+        f"{total_bytes} bytes, {decoder.frames} frames, {completed} captures, crc_errors={decoder.crc_errors} "
+        f"bad_frames={decoder.bad_frames} sequence_gaps={decoder.sequence_gaps} text_bytes={len(decoder.text)}"
+    )
+    if args.port is not None and elapsed > 0:
+        print(f"{total_bytes / elapsed:.0f} bytes/s")
+    return 0 if decoder.crc_errors == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())